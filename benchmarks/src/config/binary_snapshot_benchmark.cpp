@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a TOML document with `num_cameras` groups, each holding a few
+/// scalars, lists and a list of intrinsics.
+std::string CreateTOML(int num_cameras) {
+  std::string toml{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    toml += "[camera" + std::to_string(cam) + "]\n";
+    toml += "name = \"cam" + std::to_string(cam) + "\"\n";
+    toml += "enabled = true\n";
+    toml += "serial = " + std::to_string(1000 + cam) + "\n";
+    toml += "distortion = [0.1, -0.2, 0.0, 0.0, 0.3]\n";
+    toml += "resolution = [1920, 1080]\n";
+    toml += "calibrated = 2023-02-28T08:30:00Z\n";
+    toml += "intrinsics = [\n";
+    for (int idx = 0; idx < 4; ++idx) {
+      toml += "  { fx = 800.0, fy = 750.0, cx = 400.0, cy = 300.0 },\n";
+    }
+    toml += "]\n";
+  }
+  return toml;
+}
+
+struct Files {
+  std::string toml{};
+  std::string binary{};
+
+  explicit Files(int num_cameras) {
+    const auto tmp_dir = std::filesystem::temp_directory_path();
+    toml = (tmp_dir / "wzk-binary-snapshot-benchmark.toml").string();
+    binary = (tmp_dir / "wzk-binary-snapshot-benchmark.bin").string();
+
+    std::ofstream ofs{toml, std::ios::out | std::ios::trunc};
+    ofs << CreateTOML(num_cameras);
+    ofs.close();
+    wkc::LoadTOMLFile(toml).SaveBinary(binary);
+  }
+};
+
+const Files kFiles{5000};
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_LoadTOMLFile(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wkc::LoadTOMLFile(kFiles.toml).Size());
+  }
+}
+BENCHMARK(BM_LoadTOMLFile)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadBinary(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        wkc::Configuration::LoadBinary(kFiles.binary).Size());
+  }
+}
+BENCHMARK(BM_LoadBinary)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveBinary(benchmark::State &state) {
+  const auto config = wkc::Configuration::LoadBinary(kFiles.binary);
+  for (auto _ : state) {
+    config.SaveBinary(kFiles.binary);
+  }
+}
+BENCHMARK(BM_SaveBinary)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+/// Creates a configuration with `num_groups` large groups, each holding
+/// nested groups and lists, i.e. `group<N>.sub<M>.{name, values}`.
+wkc::Configuration CreateConfiguration(int num_groups) {
+  std::string toml{};
+  for (int grp = 0; grp < num_groups; ++grp) {
+    for (int sub = 0; sub < 32; ++sub) {
+      toml += "[group" + std::to_string(grp) + ".sub" + std::to_string(sub) +
+              "]\n";
+      toml += "name = \"sub" + std::to_string(sub) + "\"\n";
+      toml += "values = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]\n";
+    }
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+const wkc::Configuration kConfig = CreateConfiguration(16);
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_CopyConfiguration(benchmark::State &state) {
+  for (auto _ : state) {
+    wkc::Configuration copy{kConfig};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_CopyConfiguration);
+
+static void BM_GetGroup(benchmark::State &state) {
+  for (auto _ : state) {
+    wkc::Configuration group = kConfig.GetGroup("group7"sv);
+    benchmark::DoNotOptimize(group);
+  }
+}
+BENCHMARK(BM_GetGroup);
+
+static void BM_GetGroupAndRead(benchmark::State &state) {
+  for (auto _ : state) {
+    const wkc::Configuration group = kConfig.GetGroup("group7"sv);
+    double sum{0.0};
+    for (int sub = 0; sub < 32; ++sub) {
+      sum += group.GetDouble("sub" + std::to_string(sub) + ".values[3]");
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK(BM_GetGroupAndRead);
+
+/// Modifying a shared group has to copy it once.
+static void BM_GetGroupAndModify(benchmark::State &state) {
+  for (auto _ : state) {
+    wkc::Configuration group = kConfig.GetGroup("group7"sv);
+    for (int sub = 0; sub < 32; ++sub) {
+      group.SetDouble("sub" + std::to_string(sub) + ".values[3]", 0.5);
+    }
+    benchmark::DoNotOptimize(group);
+  }
+}
+BENCHMARK(BM_GetGroupAndModify);
+
+static void BM_SetGroupCopy(benchmark::State &state) {
+  wkc::Configuration config{};
+  const wkc::Configuration group = kConfig.GetGroup("group7"sv);
+  for (auto _ : state) {
+    config.SetGroup("grp"sv, group);
+    benchmark::DoNotOptimize(config);
+  }
+}
+BENCHMARK(BM_SetGroupCopy);
+
+static void BM_SetGroupMove(benchmark::State &state) {
+  wkc::Configuration config{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    wkc::Configuration group = kConfig.GetGroup("group7"sv);
+    // Detach the group, so it can be moved.
+    group.SetBool("detached"sv, true);
+    state.ResumeTiming();
+    config.SetGroup("grp"sv, std::move(group));
+    benchmark::DoNotOptimize(config);
+  }
+}
+BENCHMARK(BM_SetGroupMove);
+
+// NOLINTEND
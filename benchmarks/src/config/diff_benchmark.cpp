@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+/// Creates a configuration with 1000 groups of 100 parameters each, i.e.
+/// 10^5 parameters in total.
+wkc::Configuration CreateConfiguration() {
+  std::string toml{};
+  for (int grp = 0; grp < 1000; ++grp) {
+    toml += "[group" + std::to_string(grp) + "]\n";
+    for (int param = 0; param < 100; ++param) {
+      toml += "param" + std::to_string(param) + " = " +
+              std::to_string(grp * param) + "\n";
+    }
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+/// Simulates a reloaded configuration file, where only a few keys changed.
+wkc::Configuration CreateReloaded(const wkc::Configuration &original) {
+  // Parsing the serialized configuration ensures that no group is shared.
+  auto reloaded = wkc::LoadTOMLString(original.ToTOML());
+  reloaded.SetInt64("group17.param3"sv, -1);
+  reloaded.SetInt64("group512.param99"sv, -2);
+  reloaded.Delete("group999.param0"sv);
+  reloaded.SetBool("group0.added"sv, true);
+  return reloaded;
+}
+
+const wkc::Configuration kOriginal = CreateConfiguration();
+const wkc::Configuration kReloaded = CreateReloaded(kOriginal);
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_Equals(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kOriginal.Equals(kReloaded));
+  }
+}
+BENCHMARK(BM_Equals)->Unit(benchmark::kMillisecond);
+
+static void BM_Diff(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kOriginal.Diff(kReloaded));
+  }
+}
+BENCHMARK(BM_Diff)->Unit(benchmark::kMicrosecond);
+
+/// Diff against a modified copy, i.e. most groups are still shared.
+static void BM_DiffSharedCopy(benchmark::State &state) {
+  wkc::Configuration copy{kOriginal};
+  copy.SetInt64("group17.param3"sv, -1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kOriginal.Diff(copy));
+  }
+}
+BENCHMARK(BM_DiffSharedCopy)->Unit(benchmark::kMicrosecond);
+
+static void BM_ApplyPatch(benchmark::State &state) {
+  const auto diff = kOriginal.Diff(kReloaded);
+  wkc::Configuration config{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    config = kOriginal;
+    // Detach the configuration, so that the patch does not include a copy.
+    config.SetBool("detached"sv, true);
+    state.ResumeTiming();
+    config.ApplyPatch(kReloaded, diff);
+    benchmark::DoNotOptimize(config);
+  }
+}
+BENCHMARK(BM_ApplyPatch)->Unit(benchmark::kMicrosecond);
+
+// NOLINTEND
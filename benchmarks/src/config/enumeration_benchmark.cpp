@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+/// Creates a configuration with 100 groups of 10 subgroups, each holding 10
+/// parameters and a list of 10 values, i.e. about 2*10^4 named parameters.
+wkc::Configuration CreateConfiguration() {
+  std::string toml{};
+  for (int grp = 0; grp < 100; ++grp) {
+    for (int sub = 0; sub < 10; ++sub) {
+      toml += "[group" + std::to_string(grp) + ".sub" + std::to_string(sub) +
+              ".params]\n";
+      for (int param = 0; param < 10; ++param) {
+        toml += "param" + std::to_string(param) + " = " +
+                std::to_string(grp * param) + "\n";
+      }
+      toml += "list = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]\n";
+    }
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+const wkc::Configuration kConfig = CreateConfiguration();
+// Parsing the serialized configuration ensures that no group is shared.
+const wkc::Configuration kCopy = wkc::LoadTOMLString(kConfig.ToTOML());
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_ListParameterNames(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kConfig.ListParameterNames(true, true));
+  }
+}
+BENCHMARK(BM_ListParameterNames)->Unit(benchmark::kMicrosecond);
+
+static void BM_VisitParameterNames(benchmark::State &state) {
+  for (auto _ : state) {
+    std::size_t length = 0;
+    kConfig.VisitParameterNames(
+        true, true, [&length](std::string_view fqn) { length += fqn.size(); });
+    benchmark::DoNotOptimize(length);
+  }
+}
+BENCHMARK(BM_VisitParameterNames)->Unit(benchmark::kMicrosecond);
+
+static void BM_Equals(benchmark::State &state) {
+  const bool parallel = (state.range(0) != 0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kConfig.Equals(kCopy, parallel));
+  }
+}
+BENCHMARK(BM_Equals)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// NOLINTEND
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/files/fileio.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+namespace wkf = werkzeugkiste::files;
+
+namespace {
+/// Writes (once) a JSON document of roughly `megabytes` MB to the temporary
+/// directory and returns its path.
+std::string JSONFile(int64_t megabytes) {
+  static std::map<int64_t, std::string> files{};
+  auto it = files.find(megabytes);
+  if (it != files.end()) {
+    return it->second;
+  }
+
+  const std::string fname =
+      (std::filesystem::temp_directory_path() /
+          ("wzk-file-loading-" + std::to_string(megabytes) + "mb.json"))
+          .string();
+  const std::size_t target = static_cast<std::size_t>(megabytes) << 20U;
+  std::ofstream ofs{fname, std::ios::out | std::ios::trunc};
+  std::size_t written{0};
+  ofs << "{\n";
+  for (int grp = 0; written < target; ++grp) {
+    std::string str{(grp > 0) ? ",\n" : ""};
+    str += "  \"group" + std::to_string(grp) + "\": {\"name\": \"grp\", ";
+    str += "\"values\": [0.1, -0.2, 0.3, 1.5, 2.5, 3.5, 4.5, 5.5], ";
+    str += "\"nested\": {\"enabled\": true, \"count\": 12345}}";
+    ofs << str;
+    written += str.length();
+  }
+  ofs << "\n}\n";
+  files[megabytes] = fname;
+  return fname;
+}
+
+/// Sums all bytes, i.e. ensures that the whole file is actually read.
+uint64_t Checksum(std::string_view content) {
+  uint64_t sum{0};
+  for (const char c : content) {
+    sum += static_cast<unsigned char>(c);
+  }
+  return sum;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_ReadCatAsciiFile(benchmark::State &state) {
+  const std::string fname = JSONFile(state.range(0));
+  for (auto _ : state) {
+    const std::string content = wkf::CatAsciiFile(fname);
+    benchmark::DoNotOptimize(Checksum(content));
+  }
+  state.SetBytesProcessed(state.iterations() * (state.range(0) << 20));
+}
+BENCHMARK(BM_ReadCatAsciiFile)->Arg(1)->Arg(100)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadMappedFile(benchmark::State &state) {
+  const std::string fname = JSONFile(state.range(0));
+  for (auto _ : state) {
+    const wkf::MappedFile file{fname};
+    benchmark::DoNotOptimize(Checksum(file.View()));
+  }
+  state.SetBytesProcessed(state.iterations() * (state.range(0) << 20));
+}
+BENCHMARK(BM_ReadMappedFile)->Arg(1)->Arg(100)->Unit(benchmark::kMillisecond);
+
+/// The previous loader, i.e. read the file into a string before parsing.
+static void BM_LoadJSONFromString(benchmark::State &state) {
+  const std::string fname = JSONFile(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        wkc::LoadJSONString(wkf::CatAsciiFile(fname)).Size());
+  }
+}
+BENCHMARK(BM_LoadJSONFromString)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(1);
+
+static void BM_LoadJSONFile(benchmark::State &state) {
+  const std::string fname = JSONFile(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wkc::LoadJSONFile(fname).Size());
+  }
+}
+BENCHMARK(BM_LoadJSONFile)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(1);
+
+// NOLINTEND
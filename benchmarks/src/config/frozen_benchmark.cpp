@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/frozen.h>
+
+#include <string>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a configuration with `num_cameras` groups, each holding a list
+/// of intrinsics, i.e. `camera<N>.intrinsics[<M>].{fx, fy, cx, cy}`.
+wkc::Configuration CreateConfiguration(int num_cameras) {
+  std::string toml{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    toml += "[camera" + std::to_string(cam) + "]\n";
+    toml += "name = \"cam" + std::to_string(cam) + "\"\n";
+    toml += "intrinsics = [\n";
+    for (int idx = 0; idx < 4; ++idx) {
+      toml += "  { fx = 800.0, fy = 750.0, cx = 400.0, cy = 300.0 },\n";
+    }
+    toml += "]\n";
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+std::vector<std::string> CreateKeys(int num_cameras) {
+  std::vector<std::string> keys{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    for (int idx = 0; idx < 4; ++idx) {
+      const std::string prefix = "camera" + std::to_string(cam) +
+                                 ".intrinsics[" + std::to_string(idx) + "].";
+      keys.push_back(prefix + "fx");
+      keys.push_back(prefix + "fy");
+      keys.push_back(prefix + "cx");
+      keys.push_back(prefix + "cy");
+    }
+  }
+  return keys;
+}
+
+/// Shared by all benchmark threads.
+const wkc::Configuration kConfig = CreateConfiguration(64);
+const wkc::AtomicFrozenConfiguration kFrozen{kConfig.Freeze()};
+const std::vector<std::string> kKeys = CreateKeys(64);
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_ConfigurationGetDouble(benchmark::State &state) {
+  for (auto _ : state) {
+    double sum{0.0};
+    for (const auto &key : kKeys) {
+      sum += kConfig.GetDouble(key);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(kKeys.size()));
+}
+BENCHMARK(BM_ConfigurationGetDouble)->ThreadRange(1, 8);
+
+static void BM_FrozenGetDouble(benchmark::State &state) {
+  for (auto _ : state) {
+    // Each iteration takes a new snapshot, as a worker would on each task.
+    const wkc::FrozenConfiguration frozen = kFrozen.Load();
+    double sum{0.0};
+    for (const auto &key : kKeys) {
+      sum += frozen.GetDouble(key);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(kKeys.size()));
+}
+BENCHMARK(BM_FrozenGetDouble)->ThreadRange(1, 8);
+
+static void BM_Freeze(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kConfig.Freeze());
+  }
+}
+BENCHMARK(BM_Freeze);
+
+// NOLINTEND
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <functional>
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+/// Creates a configuration with 1000 groups of 100 parameters each, i.e.
+/// 10^5 parameters in total.
+wkc::Configuration CreateConfiguration() {
+  std::string toml{};
+  for (int grp = 0; grp < 1000; ++grp) {
+    toml += "[group" + std::to_string(grp) + "]\n";
+    for (int param = 0; param < 100; ++param) {
+      toml += "param" + std::to_string(param) + " = " +
+              std::to_string(grp * param) + "\n";
+    }
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+const wkc::Configuration kConfig = CreateConfiguration();
+}  // namespace
+
+// NOLINTBEGIN
+
+/// The previously used cache key: hashing the serialized configuration.
+static void BM_HashSerialized(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::hash<std::string>{}(kConfig.ToTOML()));
+  }
+}
+BENCHMARK(BM_HashSerialized)->Unit(benchmark::kMillisecond);
+
+/// Hashing a configuration for the first time.
+static void BM_HashCold(benchmark::State &state) {
+  wkc::Configuration cfg{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    // Modifying the copy detaches it, i.e. no hashes are memoized.
+    cfg = wkc::Configuration{kConfig};
+    cfg.SetBool("detached"sv, true);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(cfg.Hash());
+  }
+}
+BENCHMARK(BM_HashCold)->Unit(benchmark::kMillisecond);
+
+/// Hashing a configuration for the first time, using multiple threads.
+static void BM_HashColdParallel(benchmark::State &state) {
+  wkc::Configuration cfg{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    cfg = wkc::Configuration{kConfig};
+    cfg.SetBool("detached"sv, true);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(cfg.Hash(""sv, /*parallel=*/true));
+  }
+}
+BENCHMARK(BM_HashColdParallel)->Unit(benchmark::kMillisecond);
+
+/// Re-checking an unchanged configuration.
+static void BM_HashMemoized(benchmark::State &state) {
+  const wkc::Configuration cfg{kConfig};
+  benchmark::DoNotOptimize(cfg.Hash());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.Hash());
+  }
+}
+BENCHMARK(BM_HashMemoized)->Unit(benchmark::kMicrosecond);
+
+/// Re-hashing after a single parameter has been changed.
+static void BM_HashAfterChange(benchmark::State &state) {
+  wkc::Configuration cfg{kConfig};
+  benchmark::DoNotOptimize(cfg.Hash());
+  int64_t value = 0;
+  for (auto _ : state) {
+    cfg.SetInt64("group500.param50"sv, ++value);
+    benchmark::DoNotOptimize(cfg.Hash());
+  }
+}
+BENCHMARK(BM_HashAfterChange)->Unit(benchmark::kMicrosecond);
+
+// NOLINTEND
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// NOLINTBEGIN(*-macro-usage, readability-identifier-naming)
+#define JSON_HAS_FILESYSTEM 0
+#define JSON_HAS_EXPERIMENTAL_FILESYSTEM 0
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+// NOLINTEND(*-macro-usage, readability-identifier-naming)
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a JSON document with `num_cameras` groups, each holding a few
+/// scalars, a list of intrinsics and a nested group.
+std::string CreateJSON(int num_cameras) {
+  std::string str{"{\n"};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    if (cam > 0) {
+      str += ",\n";
+    }
+    str += "  \"camera" + std::to_string(cam) + "\": {\n";
+    str += "    \"name\": \"cam" + std::to_string(cam) + "\",\n";
+    str += "    \"enabled\": true,\n";
+    str += "    \"serial\": " + std::to_string(1000 + cam) + ",\n";
+    str += "    \"distortion\": [0.1, -0.2, 0.0, 0.0, 0.3, null],\n";
+    str += "    \"intrinsics\": [\n";
+    for (int idx = 0; idx < 4; ++idx) {
+      str += "      {\"fx\": 800.0, \"fy\": 750.0, \"cx\": 400.0, ";
+      str += (idx < 3) ? "\"cy\": 300.0},\n" : "\"cy\": 300.0}\n";
+    }
+    str += "    ],\n";
+    str += "    \"stream\": {\"url\": \"rtsp://localhost\", \"fps\": 30}\n";
+    str += "  }";
+  }
+  str += "\n}\n";
+  return str;
+}
+
+// The previous loader, i.e. parse into a DOM first, then insert each value
+// via the public API using its fully qualified name.
+
+// NOLINTNEXTLINE(misc-no-recursion)
+wkc::Configuration FromJSONObject(const json &object,
+    wkc::NullValuePolicy none_policy);
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void HandleValue(const json &value,
+    wkc::Configuration &cfg,
+    std::string_view fqn,
+    wkc::NullValuePolicy none_policy,
+    bool append) {
+  switch (value.type()) {
+    case json::value_t::null:
+      wkc::Configuration::HandleNullValue(cfg, fqn, none_policy, append);
+      break;
+
+    case json::value_t::boolean:
+      append ? cfg.Append(fqn, value.get<bool>())
+             : cfg.Set(fqn, value.get<bool>());
+      break;
+
+    case json::value_t::number_integer:
+    case json::value_t::number_unsigned:
+      append ? cfg.Append(fqn, value.get<int64_t>())
+             : cfg.Set(fqn, value.get<int64_t>());
+      break;
+
+    case json::value_t::number_float:
+      append ? cfg.Append(fqn, value.get<double>())
+             : cfg.Set(fqn, value.get<double>());
+      break;
+
+    case json::value_t::string:
+      append ? cfg.Append(fqn, value.get<std::string>())
+             : cfg.Set(fqn, value.get<std::string>());
+      break;
+
+    case json::value_t::array: {
+      std::string key{fqn};
+      if (append) {
+        key = wkc::Configuration::KeyForListElement(fqn, cfg.Size(fqn));
+        cfg.AppendList(fqn);
+      } else {
+        cfg.CreateList(fqn);
+      }
+      for (const json &elem : value) {
+        HandleValue(elem, cfg, key, none_policy, /*append=*/true);
+      }
+      break;
+    }
+
+    case json::value_t::object:
+      append ? cfg.Append(fqn, FromJSONObject(value, none_policy))
+             : cfg.Set(fqn, FromJSONObject(value, none_policy));
+      break;
+
+    case json::value_t::binary:
+    case json::value_t::discarded:
+      break;
+  }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+wkc::Configuration FromJSONObject(const json &object,
+    wkc::NullValuePolicy none_policy) {
+  wkc::Configuration grp{};
+  for (auto it = object.begin(); it != object.end(); ++it) {
+    HandleValue(it.value(), grp, it.key(), none_policy, /*append=*/false);
+  }
+  return grp;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_LoadJSONViaDOM(benchmark::State &state) {
+  const std::string str = CreateJSON(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FromJSONObject(json::parse(str), wkc::NullValuePolicy::Skip));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(str.size()));
+}
+BENCHMARK(BM_LoadJSONViaDOM)->Arg(4)->Arg(64)->Arg(512);
+
+static void BM_LoadJSONString(benchmark::State &state) {
+  const std::string str = CreateJSON(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        wkc::LoadJSONString(str, wkc::NullValuePolicy::Skip));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(str.size()));
+}
+BENCHMARK(BM_LoadJSONString)->Arg(4)->Arg(64)->Arg(512);
+
+// NOLINTEND
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a configuration with `num_cameras` groups, each holding a list
+/// of intrinsics, i.e. `camera<N>.intrinsics[<M>].{fx, fy, cx, cy}`.
+wkc::Configuration CreateConfiguration(int num_cameras) {
+  std::string toml{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    toml += "[camera" + std::to_string(cam) + "]\n";
+    toml += "name = \"cam" + std::to_string(cam) + "\"\n";
+    toml += "intrinsics = [\n";
+    for (int idx = 0; idx < 4; ++idx) {
+      toml += "  { fx = 800.0, fy = 750.0, cx = 400.0, cy = 300.0 },\n";
+    }
+    toml += "]\n";
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+std::vector<std::string> CreateKeys(int num_cameras) {
+  std::vector<std::string> keys{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    for (int idx = 0; idx < 4; ++idx) {
+      const std::string prefix = "camera" + std::to_string(cam) +
+                                 ".intrinsics[" + std::to_string(idx) + "].";
+      keys.push_back(prefix + "fx");
+      keys.push_back(prefix + "fy");
+      keys.push_back(prefix + "cx");
+      keys.push_back(prefix + "cy");
+    }
+  }
+  return keys;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_GetDoubleByString(benchmark::State &state) {
+  const int num_cameras = static_cast<int>(state.range(0));
+  const wkc::Configuration cfg = CreateConfiguration(num_cameras);
+  const std::vector<std::string> keys = CreateKeys(num_cameras);
+
+  for (auto _ : state) {
+    double sum{0.0};
+    for (const auto &key : keys) {
+      sum += cfg.GetDouble(key);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_GetDoubleByString)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_GetDoubleByHandle(benchmark::State &state) {
+  const int num_cameras = static_cast<int>(state.range(0));
+  const wkc::Configuration cfg = CreateConfiguration(num_cameras);
+  std::vector<wkc::Configuration::KeyHandle> handles{};
+  for (const auto &key : CreateKeys(num_cameras)) {
+    handles.emplace_back(key);
+  }
+
+  for (auto _ : state) {
+    double sum{0.0};
+    for (const auto &handle : handles) {
+      sum += cfg.Get<double>(handle);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(handles.size()));
+}
+BENCHMARK(BM_GetDoubleByHandle)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_GetDoubleByHandleAfterModification(benchmark::State &state) {
+  // Worst case: each lookup must re-resolve the handle, because the
+  // configuration has been structurally modified in between.
+  const int num_cameras = static_cast<int>(state.range(0));
+  wkc::Configuration cfg = CreateConfiguration(num_cameras);
+  std::vector<wkc::Configuration::KeyHandle> handles{};
+  for (const auto &key : CreateKeys(num_cameras)) {
+    handles.emplace_back(key);
+  }
+
+  for (auto _ : state) {
+    double sum{0.0};
+    for (const auto &handle : handles) {
+      state.PauseTiming();
+      cfg.SetBoolList("flags", {true});
+      state.ResumeTiming();
+      sum += cfg.Get<double>(handle);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(handles.size()));
+}
+BENCHMARK(BM_GetDoubleByHandleAfterModification)->Arg(4);
+
+/// Initialization of a component, i.e. binding all parameters (including
+/// parsing the names) and resolving them once.
+static void BM_BindDoubles(benchmark::State &state) {
+  const int num_cameras = static_cast<int>(state.range(0));
+  const wkc::Configuration cfg = CreateConfiguration(num_cameras);
+  const std::vector<std::string> keys = CreateKeys(num_cameras);
+  std::vector<double> values(keys.size());
+
+  for (auto _ : state) {
+    auto binder = cfg.Bind();
+    for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+      binder.Field(keys[idx], &values[idx]);
+    }
+    binder.Resolve();
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_BindDoubles)->Arg(4)->Arg(16)->Arg(64);
+
+/// Refreshing the bound parameters, e.g. after a reload.
+static void BM_ResolveBoundDoubles(benchmark::State &state) {
+  const int num_cameras = static_cast<int>(state.range(0));
+  const wkc::Configuration cfg = CreateConfiguration(num_cameras);
+  const std::vector<std::string> keys = CreateKeys(num_cameras);
+  std::vector<double> values(keys.size());
+  auto binder = cfg.Bind();
+  for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+    binder.Field(keys[idx], &values[idx]);
+  }
+
+  for (auto _ : state) {
+    binder.Resolve();
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_ResolveBoundDoubles)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_GetListByString(benchmark::State &state) {
+  const wkc::Configuration cfg =
+      wkc::LoadTOMLString("camera.distortion = [0.1, -0.2, 0.0, 0.0, 0.3]");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.GetDoubleList("camera.distortion"));
+  }
+}
+BENCHMARK(BM_GetListByString);
+
+static void BM_GetListByHandle(benchmark::State &state) {
+  const wkc::Configuration cfg =
+      wkc::LoadTOMLString("camera.distortion = [0.1, -0.2, 0.0, 0.0, 0.3]");
+  const wkc::Configuration::KeyHandle handle{"camera.distortion"};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.Get<std::vector<double>>(handle));
+  }
+}
+BENCHMARK(BM_GetListByHandle);
+
+// NOLINTEND
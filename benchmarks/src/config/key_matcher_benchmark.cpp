@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/keymatcher.h>
+
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates fully qualified parameter names of `num_cameras` cameras, e.g.
+/// `camera<N>.intrinsics[<M>].fx` or `camera<N>.stream.url`.
+std::vector<std::string> CreateKeys(int num_cameras) {
+  std::vector<std::string> keys{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    const std::string prefix = "camera" + std::to_string(cam) + '.';
+    keys.push_back(prefix + "name");
+    keys.push_back(prefix + "calibration.file");
+    keys.push_back(prefix + "stream.url");
+    keys.push_back(prefix + "stream.fps");
+    for (int idx = 0; idx < 4; ++idx) {
+      const std::string intr =
+          prefix + "intrinsics[" + std::to_string(idx) + "].";
+      keys.push_back(intr + "fx");
+      keys.push_back(intr + "fy");
+      keys.push_back(intr + "cx");
+      keys.push_back(intr + "cy");
+    }
+  }
+  return keys;
+}
+
+/// Creates patterns which are similar to the typical usage, i.e. selecting
+/// (relative) file paths of some parameters.
+std::vector<std::string> CreatePatterns(int num_patterns) {
+  std::vector<std::string> patterns{};
+  for (int idx = 0; idx < num_patterns; ++idx) {
+    switch (idx % 4) {
+      case 0:
+        patterns.push_back("camera" + std::to_string(idx) + ".calibration.*");
+        break;
+      case 1:
+        patterns.push_back("*.storage" + std::to_string(idx) + ".path");
+        break;
+      case 2:
+        patterns.push_back("plugins[*].module" + std::to_string(idx));
+        break;
+      default:
+        patterns.push_back("logging.file" + std::to_string(idx));
+        break;
+    }
+  }
+  return patterns;
+}
+
+/// The previous matcher, i.e. a std::regex per wildcard pattern.
+class RegexMatcher {
+ public:
+  explicit RegexMatcher(const std::vector<std::string> &patterns) {
+    for (const auto &pattern : patterns) {
+      std::string re{"^"};
+      for (const char c : pattern) {
+        if (c == '*') {
+          re += ".*";
+        } else if ((c == '.') || (c == '[') || (c == ']')) {
+          re += '\\';
+          re += c;
+        } else {
+          re += c;
+        }
+      }
+      re += '$';
+      patterns_.emplace_back(pattern, std::regex{re});
+    }
+  }
+
+  bool Match(std::string_view query) const {
+    for (const auto &pattern : patterns_) {
+      if ((pattern.first == query) ||
+          std::regex_match(query.begin(), query.end(), pattern.second)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::regex>> patterns_{};
+};
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_MatchRegex(benchmark::State &state) {
+  const std::vector<std::string> keys = CreateKeys(100);
+  const RegexMatcher matcher{CreatePatterns(static_cast<int>(state.range(0)))};
+  for (auto _ : state) {
+    int64_t matches{0};
+    for (const auto &key : keys) {
+      matches += matcher.Match(key) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_MatchRegex)->Arg(8)->Arg(32)->Arg(64);
+
+static void BM_MatchKeyMatcher(benchmark::State &state) {
+  const std::vector<std::string> keys = CreateKeys(100);
+  wkc::KeyMatcher matcher{};
+  for (const auto &pattern :
+      CreatePatterns(static_cast<int>(state.range(0)))) {
+    matcher.RegisterKey(pattern);
+  }
+  for (auto _ : state) {
+    int64_t matches{0};
+    for (const auto &key : keys) {
+      matches += matcher.Match(key) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(keys.size()));
+}
+BENCHMARK(BM_MatchKeyMatcher)->Arg(8)->Arg(32)->Arg(64);
+
+// NOLINTEND
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+wkc::Configuration CreateConfiguration(int64_t num_groups) {
+  wkc::Configuration cfg{};
+  for (int64_t group = 0; group < num_groups; ++group) {
+    const std::string prefix = "group" + std::to_string(group) + ".";
+    for (int param = 0; param < 10; ++param) {
+      cfg.SetInt32(prefix + "param" + std::to_string(param), param);
+    }
+  }
+  return cfg;
+}
+
+/// Looks up a misspelled key, i.e. "group0.parm3" instead of "group0.param3".
+bool LookupMissing(const wkc::Configuration &cfg) {
+  try {
+    cfg.GetInt32("group0.parm3"sv);
+  } catch (const wkc::KeyError &) {
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+/// The first miss after a modification compares against all parameters.
+static void BM_MissAfterModification(benchmark::State &state) {
+  wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  for (auto _ : state) {
+    cfg.SetInt32("modified"sv, 1);
+    benchmark::DoNotOptimize(LookupMissing(cfg));
+  }
+}
+BENCHMARK(BM_MissAfterModification)->Arg(10)->Arg(100)->Arg(1000);
+
+/// The second miss after a modification (re)builds the index.
+static void BM_SecondMissAfterModification(benchmark::State &state) {
+  wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  for (auto _ : state) {
+    cfg.SetInt32("modified"sv, 1);
+    benchmark::DoNotOptimize(LookupMissing(cfg));
+    benchmark::DoNotOptimize(LookupMissing(cfg));
+  }
+}
+BENCHMARK(BM_SecondMissAfterModification)->Arg(10)->Arg(100)->Arg(1000);
+
+/// Repeated misses reuse the cached index.
+static void BM_MissCached(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(LookupMissing(cfg));
+  }
+}
+BENCHMARK(BM_MissCached)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_MissWithoutSuggestions(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  wkc::EnableKeySuggestions(false);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(LookupMissing(cfg));
+  }
+  wkc::EnableKeySuggestions(true);
+}
+BENCHMARK(BM_MissWithoutSuggestions)->Arg(10)->Arg(100)->Arg(1000);
+
+// NOLINTEND
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/layered.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+/// Base configuration with 100 groups of 10 parameters each.
+wkc::Configuration CreateBase() {
+  wkc::Configuration cfg{};
+  for (int group = 0; group < 100; ++group) {
+    const std::string prefix = "group" + std::to_string(group) + ".";
+    for (int param = 0; param < 10; ++param) {
+      cfg.SetDouble(prefix + "param" + std::to_string(param), param);
+    }
+  }
+  return cfg;
+}
+
+/// Site-specific overrides of 10 parameters.
+wkc::Configuration CreateSite() {
+  wkc::Configuration cfg{};
+  for (int group = 0; group < 10; ++group) {
+    cfg.SetDouble("group" + std::to_string(group) + ".param0", -1.0);
+  }
+  return cfg;
+}
+
+/// Per-host overrides of 2 parameters.
+wkc::Configuration CreateHost() {
+  wkc::Configuration cfg{};
+  cfg.SetDouble("group0.param1"sv, -2.0);
+  cfg.SetString("hostname"sv, "host");
+  return cfg;
+}
+
+/// Applies the overrides via the setters, i.e. the way effective
+/// configurations have been built before.
+void ApplyOverrides(wkc::Configuration &cfg) {
+  for (int group = 0; group < 10; ++group) {
+    cfg.SetDouble("group" + std::to_string(group) + ".param0", -1.0);
+  }
+  cfg.SetDouble("group0.param1"sv, -2.0);
+  cfg.SetString("hostname"sv, "host");
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_BuildByCopy(benchmark::State &state) {
+  const wkc::Configuration base = CreateBase();
+  for (auto _ : state) {
+    wkc::Configuration cfg{base};
+    ApplyOverrides(cfg);
+    benchmark::DoNotOptimize(cfg);
+  }
+}
+BENCHMARK(BM_BuildByCopy);
+
+static void BM_BuildLayered(benchmark::State &state) {
+  const wkc::Configuration base = CreateBase();
+  const wkc::Configuration site = CreateSite();
+  const wkc::Configuration host = CreateHost();
+  for (auto _ : state) {
+    wkc::LayeredConfiguration cfg{};
+    cfg.PushLayer(base);
+    cfg.PushLayer(site);
+    cfg.PushLayer(host);
+    benchmark::DoNotOptimize(cfg);
+  }
+}
+BENCHMARK(BM_BuildLayered);
+
+static void BM_Flatten(benchmark::State &state) {
+  wkc::LayeredConfiguration cfg{};
+  cfg.PushLayer(CreateBase());
+  cfg.PushLayer(CreateSite());
+  cfg.PushLayer(CreateHost());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.Flatten());
+  }
+}
+BENCHMARK(BM_Flatten);
+
+static void BM_LookupMerged(benchmark::State &state) {
+  wkc::Configuration cfg = CreateBase();
+  ApplyOverrides(cfg);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.GetDouble("group50.param5"sv));
+  }
+}
+BENCHMARK(BM_LookupMerged);
+
+/// Worst case: the parameter is only provided by the bottom layer.
+static void BM_LookupLayered(benchmark::State &state) {
+  wkc::LayeredConfiguration cfg{};
+  cfg.PushLayer(CreateBase());
+  cfg.PushLayer(CreateSite());
+  cfg.PushLayer(CreateHost());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.GetDouble("group50.param5"sv));
+  }
+}
+BENCHMARK(BM_LookupLayered);
+
+// NOLINTEND
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Number of heap allocations, to verify that reading a list only allocates
+/// the output container.
+std::atomic<int64_t> num_allocations{0};
+
+wkc::Configuration CreateConfiguration(int64_t num_elements) {
+  std::vector<double> values(static_cast<std::size_t>(num_elements));
+  for (std::size_t idx = 0; idx < values.size(); ++idx) {
+    values[idx] = 0.5 * static_cast<double>(idx);
+  }
+  wkc::Configuration cfg{};
+  cfg.SetDoubleList("values", values);
+
+  wkc::Matrix<double> mat(num_elements / 4, 4);
+  mat.setOnes();
+  cfg.SetMatrix("matrix", mat);
+  return cfg;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+void *operator new(std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+static void BM_GetDoubleList(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  int64_t allocations{0};
+  for (auto _ : state) {
+    const int64_t before = num_allocations.load();
+    benchmark::DoNotOptimize(cfg.GetDoubleList("values"));
+    allocations += num_allocations.load() - before;
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetDoubleList)->Arg(1000)->Arg(1000000);
+
+static void BM_GetMatrixDouble(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  int64_t allocations{0};
+  for (auto _ : state) {
+    const int64_t before = num_allocations.load();
+    benchmark::DoNotOptimize(cfg.GetMatrixDouble("matrix"));
+    allocations += num_allocations.load() - before;
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetMatrixDouble)->Arg(1000)->Arg(1000000);
+
+static void BM_GetDoubleListInto(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  std::vector<double> buffer(cfg.Size("values"));
+  int64_t allocations{0};
+  for (auto _ : state) {
+    const int64_t before = num_allocations.load();
+    cfg.GetDoubleListInto("values", buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(buffer.data());
+    allocations += num_allocations.load() - before;
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetDoubleListInto)->Arg(1000)->Arg(1000000);
+
+static void BM_GetMatrixInto(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(0));
+  wkc::Matrix<double> mat(state.range(0) / 4, 4);
+  int64_t allocations{0};
+  for (auto _ : state) {
+    const int64_t before = num_allocations.load();
+    cfg.GetMatrixInto("matrix", mat);
+    benchmark::DoNotOptimize(mat.data());
+    allocations += num_allocations.load() - before;
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetMatrixInto)->Arg(1000)->Arg(1000000);
+
+static void BM_SetDoubleList(benchmark::State &state) {
+  const std::vector<double> values(static_cast<std::size_t>(state.range(0)),
+      0.5);
+  wkc::Configuration cfg{};
+  for (auto _ : state) {
+    cfg.SetDoubleList("values", values);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetDoubleList)->Arg(1000)->Arg(1000000);
+
+static void BM_SetMatrix(benchmark::State &state) {
+  wkc::Matrix<double> mat(state.range(0) / 4, 4);
+  mat.setOnes();
+  wkc::Configuration cfg{};
+  for (auto _ : state) {
+    cfg.SetMatrix("matrix", mat);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetMatrix)->Arg(1000)->Arg(1000000);
+
+// NOLINTEND
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+constexpr int kNumFiles = 40;
+
+/// Writes (once) the nested configuration files to the temporary directory
+/// and returns the main configuration, which includes each file twice (once
+/// as `grp<N>.include` and once as `shared.grp<N>.include`).
+const std::string &MainConfig() {
+  static std::string main{};
+  if (!main.empty()) {
+    return main;
+  }
+
+  for (int idx = 0; idx < kNumFiles; ++idx) {
+    const std::string fname =
+        (std::filesystem::temp_directory_path() /
+            ("wzk-nested-loading-" + std::to_string(idx) + ".toml"))
+            .string();
+    std::ofstream ofs{fname, std::ios::out | std::ios::trunc};
+    for (int grp = 0; grp < 200; ++grp) {
+      ofs << "[group" << grp << "]\nname = \"grp\"\n"
+          << "values = [0.1, -0.2, 0.3, 1.5, 2.5]\n"
+          << "nested = { enabled = true, count = " << grp << " }\n";
+    }
+
+    main += "grp" + std::to_string(idx) + ".include = '" + fname + "'\n";
+    main += "shared.grp" + std::to_string(idx) + ".include = '" + fname + "'\n";
+  }
+  return main;
+}
+
+std::vector<std::string> IncludeKeys() {
+  std::vector<std::string> keys{};
+  for (int idx = 0; idx < kNumFiles; ++idx) {
+    keys.push_back("grp" + std::to_string(idx) + ".include");
+    keys.push_back("shared.grp" + std::to_string(idx) + ".include");
+  }
+  return keys;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_LoadNestedSequential(benchmark::State &state) {
+  const auto config = wkc::LoadTOMLString(MainConfig());
+  const auto keys = IncludeKeys();
+  for (auto _ : state) {
+    wkc::Configuration cfg{config};
+    for (const auto &key : keys) {
+      cfg.LoadNestedConfiguration(key);
+    }
+    benchmark::DoNotOptimize(cfg.Size());
+  }
+}
+BENCHMARK(BM_LoadNestedSequential)->Unit(benchmark::kMillisecond);
+
+/// Parses each file only once (per iteration), using multiple threads.
+static void BM_LoadNestedBatch(benchmark::State &state) {
+  const auto config = wkc::LoadTOMLString(MainConfig());
+  for (auto _ : state) {
+    wkc::Configuration cfg{config};
+    cfg.LoadNestedConfigurations({"*.include"sv});
+    benchmark::DoNotOptimize(cfg.Size());
+  }
+}
+BENCHMARK(BM_LoadNestedBatch)->Unit(benchmark::kMillisecond);
+
+/// Parses each file only once (across all iterations).
+static void BM_LoadNestedCached(benchmark::State &state) {
+  const auto config = wkc::LoadTOMLString(MainConfig());
+  wkc::NestedConfigurationCache cache{};
+  for (auto _ : state) {
+    wkc::Configuration cfg{config};
+    cfg.LoadNestedConfigurations({"*.include"sv}, cache);
+    benchmark::DoNotOptimize(cfg.Size());
+  }
+}
+BENCHMARK(BM_LoadNestedCached)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/reflection.h>
+
+#include <string>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace bench {
+struct Intrinsics {
+  double fx{0.0};
+  double fy{0.0};
+  double cx{0.0};
+  double cy{0.0};
+};
+WZK_CONFIG_STRUCT(Intrinsics, fx, fy, cx, cy)
+
+struct Camera {
+  std::string name{};
+  int32_t width{0};
+  int32_t height{0};
+  Intrinsics intrinsics{};
+  std::vector<double> distortion{};
+};
+WZK_CONFIG_STRUCT(Camera, name, width, height, intrinsics, distortion)
+}  // namespace bench
+
+namespace {
+wkc::Configuration CreateConfiguration() {
+  return wkc::LoadTOMLString(R"toml(
+    [camera]
+    name = "cam"
+    width = 1920
+    height = 1080
+    intrinsics = { fx = 800.0, fy = 750.0, cx = 400.0, cy = 300.0 }
+    distortion = [0.1, -0.2, 0.0, 0.0, 0.3]
+    )toml"sv);
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_LoadStructByGetters(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    bench::Camera cam{};
+    cam.name = cfg.GetString("camera.name"sv);
+    cam.width = cfg.GetInt32("camera.width"sv);
+    cam.height = cfg.GetInt32("camera.height"sv);
+    cam.intrinsics.fx = cfg.GetDouble("camera.intrinsics.fx"sv);
+    cam.intrinsics.fy = cfg.GetDouble("camera.intrinsics.fy"sv);
+    cam.intrinsics.cx = cfg.GetDouble("camera.intrinsics.cx"sv);
+    cam.intrinsics.cy = cfg.GetDouble("camera.intrinsics.cy"sv);
+    cam.distortion = cfg.GetDoubleList("camera.distortion"sv);
+    benchmark::DoNotOptimize(cam);
+  }
+}
+BENCHMARK(BM_LoadStructByGetters);
+
+static void BM_LoadStructByDescriptors(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    auto cam = wkc::Load<bench::Camera>(cfg, "camera"sv);
+    benchmark::DoNotOptimize(cam);
+  }
+}
+BENCHMARK(BM_LoadStructByDescriptors);
+
+/// Repeatedly loading from the same group, i.e. the field handles can reuse
+/// the resolved parameters.
+static void BM_LoadStructFromRoot(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration().GetGroup("camera"sv);
+  for (auto _ : state) {
+    auto cam = wkc::Load<bench::Camera>(cfg, ""sv);
+    benchmark::DoNotOptimize(cam);
+  }
+}
+BENCHMARK(BM_LoadStructFromRoot);
+
+static void BM_StoreStruct(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  const auto cam = wkc::Load<bench::Camera>(cfg, "camera"sv);
+  for (auto _ : state) {
+    wkc::Configuration stored{};
+    wkc::Store(stored, "camera"sv, cam);
+    benchmark::DoNotOptimize(stored);
+  }
+}
+BENCHMARK(BM_StoreStruct);
+
+// NOLINTEND
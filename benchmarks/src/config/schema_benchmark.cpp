@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/schema.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+constexpr int kNumCameras = 8;
+
+wkc::Configuration CreateConfiguration() {
+  std::string toml{"name = \"rig\"\n"};
+  for (int idx = 0; idx < kNumCameras; ++idx) {
+    toml += R"toml(
+      [[cameras]]
+      label = "cam"
+      fx = 800.0
+      fy = 750.0
+      fps = 30
+      K = [[800.0, 0.0, 400.0], [0.0, 750.0, 300.0], [0.0, 0.0, 1.0]]
+      distortion = [0.1, -0.2, 0.0, 0.0, 0.3]
+      )toml";
+  }
+  return wkc::LoadTOMLString(toml);
+}
+
+wkc::Schema CreateSchema() {
+  return wkc::Schema::FromConfiguration(wkc::LoadTOMLString(R"toml(
+    [[parameters]]
+    key = "name"
+    type = "string"
+    required = true
+
+    [[parameters]]
+    key = "cameras"
+    type = "list"
+    required = true
+
+    [[parameters]]
+    key = "cameras[*].label"
+    type = "string"
+    required = true
+
+    [[parameters]]
+    key = "cameras[*].fx"
+    type = "floating_point"
+    required = true
+    min = 0.0
+
+    [[parameters]]
+    key = "cameras[*].fy"
+    type = "floating_point"
+    required = true
+    min = 0.0
+
+    [[parameters]]
+    key = "cameras[*].fps"
+    type = "integer"
+    min = 1
+    max = 120
+
+    [[parameters]]
+    key = "cameras[*].K"
+    shape = [3, 3]
+
+    [[parameters]]
+    key = "cameras[*].distortion"
+    element_type = "floating_point"
+    min_length = 4
+    max_length = 8
+    )toml"sv));
+}
+
+/// Hand-written checks equivalent to the schema above, as they would be
+/// implemented via the public getters.
+bool CheckByGetters(const wkc::Configuration &cfg) {
+  bool valid = cfg.Contains("name"sv) &&
+               (cfg.Type("name"sv) == wkc::ConfigType::String) &&
+               cfg.Contains("cameras"sv) &&
+               (cfg.Type("cameras"sv) == wkc::ConfigType::List);
+  const std::size_t num_cameras = cfg.Size("cameras"sv);
+  for (std::size_t idx = 0; idx < num_cameras; ++idx) {
+    const std::string cam = wkc::Configuration::KeyForListElement("cameras"sv,
+        idx);
+    valid = valid && cfg.Contains(cam + ".label") &&
+            (cfg.Type(cam + ".label") == wkc::ConfigType::String);
+    valid = valid && (cfg.GetDouble(cam + ".fx") >= 0.0);
+    valid = valid && (cfg.GetDouble(cam + ".fy") >= 0.0);
+    const int32_t fps = cfg.GetInt32Or(cam + ".fps", 1);
+    valid = valid && (fps >= 1) && (fps <= 120);
+    if (cfg.Contains(cam + ".K")) {
+      const auto K = cfg.GetMatrixDouble(cam + ".K");
+      valid = valid && (K.rows() == 3) && (K.cols() == 3);
+    }
+    if (cfg.Contains(cam + ".distortion")) {
+      const auto dist = cfg.GetDoubleList(cam + ".distortion");
+      valid = valid && (dist.size() >= 4) && (dist.size() <= 8);
+    }
+  }
+  return valid;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_ValidateByGetters(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CheckByGetters(cfg));
+  }
+}
+BENCHMARK(BM_ValidateByGetters);
+
+static void BM_ValidateBySchema(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  const wkc::Schema schema = CreateSchema();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(schema.Check(cfg));
+  }
+}
+BENCHMARK(BM_ValidateBySchema);
+
+static void BM_CompileSchema(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CreateSchema());
+  }
+}
+BENCHMARK(BM_CompileSchema);
+
+// NOLINTEND
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a configuration with `depth` nested levels, where each level
+/// holds a few scalars and lists, i.e. `lvl0.lvl1.(...).lvl<depth-1>`.
+wkc::Configuration CreateConfiguration(int depth) {
+  wkc::Configuration cfg{};
+  std::string prefix{};
+  for (int lvl = 0; lvl < depth; ++lvl) {
+    prefix += "lvl" + std::to_string(lvl);
+    cfg.SetString(prefix + ".name", "level " + std::to_string(lvl));
+    cfg.SetInt64(prefix + ".index", lvl);
+    cfg.SetDouble(prefix + ".scale", 0.5 * lvl);
+    cfg.SetDoubleList(prefix + ".values", {0.1, -0.2, 0.0, 0.3});
+    cfg.CreateList(prefix + ".mixed");
+    cfg.Append(prefix + ".mixed", int64_t{1});
+    cfg.Append(prefix + ".mixed", std::string{"two"});
+    prefix += '.';
+  }
+  return cfg;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_ToLibconfig(benchmark::State &state) {
+  const wkc::Configuration cfg =
+      CreateConfiguration(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.ToLibconfig());
+  }
+}
+BENCHMARK(BM_ToLibconfig)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_WriteLibconfig(benchmark::State &state) {
+  const wkc::Configuration cfg =
+      CreateConfiguration(static_cast<int>(state.range(0)));
+  std::ostringstream out;
+  for (auto _ : state) {
+    out.str(std::string{});
+    cfg.WriteLibconfig(out);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_WriteLibconfig)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_WriteTOML(benchmark::State &state) {
+  const wkc::Configuration cfg =
+      CreateConfiguration(static_cast<int>(state.range(0)));
+  std::ostringstream out;
+  for (auto _ : state) {
+    out.str(std::string{});
+    cfg.WriteTOML(out);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_WriteTOML)->Arg(4)->Arg(16)->Arg(64);
+
+// NOLINTEND
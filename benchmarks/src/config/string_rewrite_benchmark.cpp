@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+using Replacements = std::vector<std::pair<std::string_view, std::string_view>>;
+
+/// Creates 1000 templated path parameters, each of which repeats the
+/// placeholder pattern `repetitions` times.
+wkc::Configuration CreateConfiguration(int64_t repetitions) {
+  std::string value{};
+  for (int64_t rep = 0; rep < repetitions; ++rep) {
+    value += "${ROOT}/${SESSION}/cam-${CAMERA}/";
+  }
+  value += "frame.png";
+
+  wkc::Configuration cfg{};
+  for (int group = 0; group < 200; ++group) {
+    const std::string prefix = "camera" + std::to_string(group) + ".";
+    for (int param = 0; param < 5; ++param) {
+      cfg.SetString(prefix + "path" + std::to_string(param), value);
+    }
+  }
+  return cfg;
+}
+
+/// Returns the 3 used placeholders, followed by unused ones.
+Replacements CreateReplacements(std::vector<std::string> &storage,
+    int64_t num_pairs) {
+  storage.clear();
+  for (int64_t idx = 3; idx < num_pairs; ++idx) {
+    storage.push_back("${UNUSED" + std::to_string(idx) + "}");
+  }
+
+  Replacements replacements{{"${ROOT}"sv, "data"sv},
+      {"${SESSION}"sv, "2023-04-01"sv},
+      {"${CAMERA}"sv, "front-left"sv}};
+  for (const auto &needle : storage) {
+    replacements.emplace_back(needle, "unused"sv);
+  }
+  return replacements;
+}
+
+/// Returns a (deep) copy which can be modified without copying the tree.
+wkc::Configuration PrepareCopy(const wkc::Configuration &cfg) {
+  wkc::Configuration copy{cfg};
+  copy.SetBool("unshare"sv, true);
+  return copy;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+/// Arguments: number of <search, replacement> pairs, number of placeholder
+/// repetitions per string.
+static void BM_ReplaceStringPlaceholders(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(state.range(1));
+  std::vector<std::string> storage{};
+  const Replacements replacements = CreateReplacements(storage, state.range(0));
+  wkc::Configuration copy{};
+  for (auto _ : state) {
+    // The previous copy is destroyed while the timer is paused.
+    state.PauseTiming();
+    copy = PrepareCopy(cfg);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.ReplaceStringPlaceholders(replacements));
+  }
+}
+BENCHMARK(BM_ReplaceStringPlaceholders)
+    ->ArgsProduct({{3, 32, 256}, {1, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Placeholder replacement followed by a separate path adjustment.
+static void BM_ReplaceThenAdjustPaths(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(1);
+  std::vector<std::string> storage{};
+  const Replacements replacements = CreateReplacements(storage, 3);
+  wkc::Configuration copy{};
+  for (auto _ : state) {
+    // The previous copy is destroyed while the timer is paused.
+    state.PauseTiming();
+    copy = PrepareCopy(cfg);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.ReplaceStringPlaceholders(replacements));
+    benchmark::DoNotOptimize(
+        copy.AdjustRelativePaths("/mnt/storage"sv, {"*.path*"sv}));
+  }
+}
+BENCHMARK(BM_ReplaceThenAdjustPaths)->Unit(benchmark::kMillisecond);
+
+/// Placeholder replacement and path adjustment within a single traversal.
+static void BM_RewriteStrings(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration(1);
+  std::vector<std::string> storage{};
+  const Replacements replacements = CreateReplacements(storage, 3);
+  wkc::Configuration copy{};
+  for (auto _ : state) {
+    // The previous copy is destroyed while the timer is paused.
+    state.PauseTiming();
+    copy = PrepareCopy(cfg);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.RewriteStrings(
+        replacements, "/mnt/storage"sv, {"*.path*"sv}));
+  }
+}
+BENCHMARK(BM_RewriteStrings)->Unit(benchmark::kMillisecond);
+
+// NOLINTEND
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+namespace {
+wkc::Configuration CreateConfiguration() {
+  wkc::Configuration cfg{};
+  for (int group = 0; group < 100; ++group) {
+    const std::string prefix = "group" + std::to_string(group) + ".";
+    for (int param = 0; param < 10; ++param) {
+      cfg.SetDouble(prefix + "param" + std::to_string(param), param);
+    }
+  }
+  cfg.SetString("camera.name"sv, "cam");
+  return cfg;
+}
+
+constexpr std::string_view kExisting{"group50.param5"};
+constexpr std::string_view kMissing{"group50.param50"};
+constexpr std::string_view kMismatch{"camera.name"};
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_GetDoubleHit(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.GetDouble(kExisting));
+  }
+}
+BENCHMARK(BM_GetDoubleHit);
+
+static void BM_TryGetHit(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.TryGet<double>(kExisting));
+  }
+}
+BENCHMARK(BM_TryGetHit);
+
+static void BM_GetDoubleMiss(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    try {
+      benchmark::DoNotOptimize(cfg.GetDouble(kMissing));
+    } catch (const wkc::KeyError &e) {
+      benchmark::DoNotOptimize(e);
+    }
+  }
+}
+BENCHMARK(BM_GetDoubleMiss);
+
+static void BM_GetOptionalDoubleMiss(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.GetOptionalDouble(kMissing));
+  }
+}
+BENCHMARK(BM_GetOptionalDoubleMiss);
+
+static void BM_TryGetMiss(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.TryGet<double>(kMissing));
+  }
+}
+BENCHMARK(BM_TryGetMiss);
+
+static void BM_GetDoubleMismatch(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    try {
+      benchmark::DoNotOptimize(cfg.GetDouble(kMismatch));
+    } catch (const wkc::TypeError &e) {
+      benchmark::DoNotOptimize(e);
+    }
+  }
+}
+BENCHMARK(BM_GetDoubleMismatch);
+
+static void BM_TryGetMismatch(benchmark::State &state) {
+  const wkc::Configuration cfg = CreateConfiguration();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cfg.TryGet<double>(kMismatch));
+  }
+}
+BENCHMARK(BM_TryGetMismatch);
+
+// NOLINTEND
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <cstdint>
+#include <string>
+
+namespace wkc = werkzeugkiste::config;
+
+namespace {
+/// Creates a YAML document with `num_cameras` maps, each holding a few
+/// scalars, a sequence of intrinsics and a nested map.
+std::string CreateYAML(int num_cameras) {
+  std::string str{};
+  for (int cam = 0; cam < num_cameras; ++cam) {
+    str += "camera" + std::to_string(cam) + ":\n";
+    str += "  name: cam" + std::to_string(cam) + "\n";
+    str += "  enabled: true\n";
+    str += "  serial: " + std::to_string(1000 + cam) + "\n";
+    str += "  calibrated: 2023-04-14T21:27:28Z\n";
+    str += "  distortion: [0.1, -0.2, 0.0, 0.0, 0.3, ~]\n";
+    str += "  intrinsics:\n";
+    for (int idx = 0; idx < 4; ++idx) {
+      str += "    - { fx: 800.0, fy: 750.0, cx: 400.0, cy: 300.0 }\n";
+    }
+    str += "  stream:\n";
+    str += "    url: rtsp://localhost\n";
+    str += "    fps: !!int 30\n";
+  }
+  return str;
+}
+}  // namespace
+
+// NOLINTBEGIN
+
+static void BM_LoadYAMLString(benchmark::State &state) {
+  const std::string str = CreateYAML(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        wkc::LoadYAMLString(str, wkc::NullValuePolicy::Skip));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(str.size()));
+  state.SetComplexityN(state.range(0));
+}
+// Loading time should scale linearly with the number of nodes.
+BENCHMARK(BM_LoadYAMLString)->RangeMultiplier(4)->Range(4, 1024)->Complexity();
+
+// NOLINTEND
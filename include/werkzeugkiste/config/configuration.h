@@ -8,7 +8,10 @@
 
 #include <Eigen/Core>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <iosfwd>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -17,6 +20,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 /// @brief Utilities to handle configurations in a unified manner via the
@@ -79,6 +83,52 @@
 /// @endcode
 namespace werkzeugkiste::config {
 
+namespace detail {
+/// @brief Internal accessor to the underlying parameter tree (used by the
+///   parsers and serializers).
+struct ConfigurationAccess;
+}  // namespace detail
+
+/// @brief Immutable configuration snapshot, see `frozen.h`.
+class FrozenConfiguration;
+
+/// @brief Cache of parsed nested configuration files, see
+///   `Configuration::LoadNestedConfigurations`.
+class NestedConfigurationCache;
+
+/// @brief Differences between two configurations, see `Configuration::Diff`.
+///
+/// Each entry is the fully qualified name of the top-most differing
+/// parameter, *i.e.* if a whole group has been added, only the group's name
+/// is listed (but none of its parameters). Lists are compared as a whole.
+struct WERKZEUGKISTE_CONFIG_EXPORT ConfigurationDiff {
+  /// @brief Parameters which only exist in the other configuration.
+  std::vector<std::string> added{};
+
+  /// @brief Parameters which only exist in this configuration.
+  std::vector<std::string> removed{};
+
+  /// @brief Parameters which exist in both configurations, but differ in
+  ///   type or value.
+  std::vector<std::string> changed{};
+
+  /// @brief Returns true if the configurations are equal.
+  bool Empty() const {
+    return added.empty() && removed.empty() && changed.empty();
+  }
+
+  /// @brief Returns true if the given parameter (or any of its
+  ///   sub-parameters) differs.
+  ///
+  /// This allows subsystems to subscribe to a key prefix, *e.g.*
+  /// `diff.Affects("camera"sv)` is true if `camera.fx` has changed, as well
+  /// as if the whole `camera` group has been added. An empty key matches
+  /// any difference.
+  ///
+  /// @param key Fully qualified parameter name.
+  bool Affects(std::string_view key) const;
+};
+
 /// @brief Alias for a dynamic-size row-major matrix.
 /// @tparam Tp Scalar type of the matrix.
 template <typename Tp>
@@ -133,10 +183,13 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @brief Destructor.
   ~Configuration();
 
-  /// @brief Copy constructor - creates a deep copy.
+  /// @brief Copy constructor.
+  ///
+  /// Copies are cheap, because the parameters are shared until either
+  /// configuration is modified (copy-on-write).
   Configuration(const Configuration &other);
 
-  /// @brief Copy assignment - creates a deep copy.
+  /// @brief Copy assignment, see copy constructor.
   Configuration &operator=(const Configuration &other);
 
   /// @brief Move constructor.
@@ -153,18 +206,109 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @param filename Path to the `.toml` file.
   static Configuration LoadTOMLFile(std::string_view filename);
 
+  /// @brief Loads a binary snapshot, see `SaveBinary`.
+  ///
+  /// Large files are memory-mapped (see `files::MappedFile`). The file is
+  /// decoded in a single pass, *i.e.* without any text parsing.
+  ///
+  /// Raises a `ParseError` if the file cannot be read or is not a valid
+  /// snapshot (or has been created by an incompatible version).
+  ///
+  /// @param filename Path to the binary snapshot.
+  static Configuration LoadBinary(std::string_view filename);
+
+  /// @brief Loads a binary snapshot from memory, see `WriteBinary`.
+  /// @param buffer Content of the binary snapshot.
+  static Configuration LoadBinaryBuffer(std::string_view buffer);
+
   /// @brief Returns true if this configuration has no parameters set.
   bool Empty() const;
 
   /// @brief Returns true if all configuration keys and values match exactly.
   bool Equals(const Configuration &other) const;
 
+  /// @brief Returns true if all configuration keys and values match exactly.
+  ///
+  /// If `parallel` is true, the (top-level) subtrees are compared
+  /// concurrently on up to `std::thread::hardware_concurrency()` threads.
+  /// This only pays off for huge configurations, *e.g.* with several
+  /// hundred thousand parameters.
+  ///
+  /// @param other The configuration to compare against.
+  /// @param parallel If true, compare the subtrees concurrently.
+  bool Equals(const Configuration &other, bool parallel) const;
+
   /// @brief Returns true if all configuration keys and values match exactly.
   bool operator==(const Configuration &other) const;
 
   /// @brief Returns true if any configuration key or value differs.
   bool operator!=(const Configuration &other) const;
 
+  /// @brief Returns a 64-bit hash of all parameter names and values.
+  ///
+  /// The hash is computed from the parameter tree, *i.e.* without
+  /// serializing it. It is consistent with `Equals`: equal configurations
+  /// have the same hash, independent of the order in which their
+  /// parameters have been added. The hash is stable across processes and
+  /// platforms, thus, it can be used as key to cache derived data. It is not
+  /// a cryptographic hash, though.
+  ///
+  /// The hashes of all groups are memoized (and shared by copies of this
+  /// configuration). A modification only invalidates the hashes of the
+  /// affected groups. Thus, hashing an unchanged configuration again takes
+  /// constant time.
+  uint64_t Hash() const;
+
+  /// @brief Returns the hash of the given parameter, see `Hash()`.
+  ///
+  /// The hash of a group is the same as the hash of the corresponding
+  /// configuration, *i.e.* `cfg.Hash("grp") == cfg.GetGroup("grp").Hash()`.
+  /// Raises a `KeyError` if the parameter does not exist.
+  ///
+  /// @param key Fully qualified parameter name. If empty, the hash of the
+  ///   whole configuration will be returned.
+  uint64_t Hash(std::string_view key) const;
+
+  /// @brief Returns the hash of the given parameter, optionally computed by
+  ///   multiple threads.
+  ///
+  /// If `parallel` is true, the groups whose hashes are not yet memoized
+  /// are split into independent subtrees, which are hashed concurrently.
+  /// The result is the same as for `Hash(key)`. This only pays off for
+  /// large configurations that have not been hashed before.
+  ///
+  /// @param key Fully qualified parameter name, or empty for the whole
+  ///   configuration.
+  /// @param parallel If true, the hash is computed by multiple threads.
+  uint64_t Hash(std::string_view key, bool parallel) const;
+
+  /// @brief Computes the differences to the other configuration.
+  ///
+  /// Both parameter trees are traversed once, in lockstep. Unchanged groups
+  /// which are shared (see copy constructor and `GetGroup`) are skipped.
+  ///
+  /// @param other The configuration to compare against, *e.g.* a reloaded
+  ///   version of this configuration.
+  ConfigurationDiff Diff(const Configuration &other) const;
+
+  /// @brief Updates this configuration to match the other configuration.
+  ///
+  /// Only the parameters listed in the `diff` (which must have been computed
+  /// via `Diff(other)`) will be removed, inserted or replaced.
+  ///
+  /// Raises a `KeyError` if a listed parameter does not exist in the
+  /// respective configuration, *i.e.* if the `diff` does not belong to these
+  /// configurations. In this case, the configuration remains unchanged.
+  ///
+  /// @param other The updated configuration.
+  /// @param diff Differences between this and the other configuration.
+  void ApplyPatch(const Configuration &other, const ConfigurationDiff &diff);
+
+  /// @brief Returns an immutable snapshot of this configuration which can be
+  ///   shared across threads, see `FrozenConfiguration` (requires
+  ///   `#include <werkzeugkiste/config/frozen.h>`).
+  FrozenConfiguration Freeze() const;
+
   /// @brief Checks if the given key exists in this configuration.
   /// @param key Fully qualified identifier of the parameter.
   bool Contains(std::string_view key) const;
@@ -241,6 +385,35 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
     return ListParameterNames(""sv, include_array_entries, recursive);
   };
 
+  /// @brief Function to be invoked for each fully qualified parameter name,
+  ///   see `VisitParameterNames`.
+  using NameVisitor = std::function<void(std::string_view fqn)>;
+
+  /// @brief Invokes the visitor for each (fully qualified) parameter name
+  ///   below the given key, in the same order as `ListParameterNames`.
+  ///
+  /// In contrast to `ListParameterNames`, no list of names is created. All
+  /// names are assembled within a single buffer instead, *i.e.* the passed
+  /// `std::string_view` is only valid until the visitor returns.
+  ///
+  /// @param key Fully qualified name of the parameter.
+  /// @param include_array_entries See `ListParameterNames`.
+  /// @param recursive See `ListParameterNames`.
+  /// @param visitor Function to be invoked for each parameter name.
+  void VisitParameterNames(std::string_view key,
+      bool include_array_entries,
+      bool recursive,
+      const NameVisitor &visitor) const;
+
+  /// @brief Invokes the visitor for each (fully qualified) parameter name
+  ///   below the configuration root, see `VisitParameterNames` above.
+  inline void VisitParameterNames(bool include_array_entries,
+      bool recursive,
+      const NameVisitor &visitor) const {
+    using namespace std::string_view_literals;
+    VisitParameterNames(""sv, include_array_entries, recursive, visitor);
+  }
+
   /// @brief Raises a `TypeError` if the parameter exists, but is of a
   ///   different type.
   /// @param key Fully qualified parameter name.
@@ -255,6 +428,252 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @return The Fully qualified name, *i.e.* `key[index]`.
   static std::string KeyForListElement(std::string_view key, std::size_t index);
 
+  //---------------------------------------------------------------------------
+  // Key handles
+
+  /// @name Key handles
+  ///
+  /// @desc Pre-parsed parameter names for repeated lookups.
+  ///
+  /// @{
+
+  /// @brief A parameter name which has been split into its path components
+  ///   once, *e.g.* `camera.intrinsics[2].fx` into the table keys `camera`,
+  ///   `intrinsics`, `fx` and the list index `2`.
+  ///
+  /// Looking up a parameter via its string name requires parsing the name
+  /// upon each query. If the same parameters are queried repeatedly (for
+  /// example, within a processing loop), a `KeyHandle` avoids this overhead.
+  /// Additionally, the handle remembers the resolved parameter and reuses it
+  /// until the configuration is structurally modified (*e.g.* a parameter
+  /// or list element is deleted or replaced).
+  ///
+  /// @code {.cpp}
+  /// const wkc::Configuration::KeyHandle fx{"camera.intrinsics[2].fx"sv};
+  /// for (...) {
+  ///   const double val = cfg.Get<double>(fx);
+  /// }
+  /// @endcode
+  ///
+  /// A handle caches the resolved parameter, and thus, must not be used
+  /// concurrently from multiple threads without external synchronization.
+  class WERKZEUGKISTE_CONFIG_EXPORT KeyHandle {
+   public:
+    /// @brief Parses the fully qualified parameter name.
+    ///
+    /// Raises a `KeyError` if the name contains a malformed list index,
+    ///   *e.g.* `arr[x]` or `arr[0`.
+    ///
+    /// @param key Fully qualified parameter name.
+    explicit KeyHandle(std::string_view key);
+
+    /// @brief Returns the fully qualified parameter name.
+    const std::string &Key() const { return key_; }
+
+   private:
+    friend class Configuration;
+
+    /// @brief A single path component: either a (sub-)string of `key_`, or a
+    ///   list index.
+    struct Segment {
+      std::size_t offset{0};
+      std::size_t length{0};
+      std::size_t index{0};
+      bool is_index{false};
+    };
+
+    /// @brief Splits the parameter name into its path components and
+    ///   appends them to `segments`. String offsets are shifted by `offset`.
+    static void Split(std::string_view key,
+        std::size_t offset,
+        std::vector<Segment> &segments);
+
+    /// The fully qualified parameter name.
+    std::string key_{};
+
+    /// Path components, from the root to the parameter.
+    std::vector<Segment> segments_{};
+
+    /// The resolved (internal) node, valid as long as `generation_` matches
+    /// the generation of the looked up configuration.
+    mutable const void *node_{nullptr};
+
+    /// Generation of the configuration which `node_` belongs to.
+    mutable uint64_t generation_{0};
+  };
+
+  /// @brief Checks if the parameter referred to by the handle exists.
+  /// @param key Pre-parsed parameter name.
+  bool Contains(const KeyHandle &key) const;
+
+  /// @brief Returns the parameter referred to by the handle.
+  ///
+  /// Supported types are the scalar parameter types, *i.e.* `bool`,
+  /// `int32_t`, `int64_t`, `double`, `std::string`, `date`, `time` and
+  /// `date_time`, as well as `std::vector`s of these types. Numeric
+  /// conversions follow the same rules as the string-based getters, *e.g.*
+  /// `Get<double>(handle)` behaves like `GetDouble(key)`.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `TypeError` if the parameter is of a different type.
+  ///
+  /// @tparam Tp Type of the parameter.
+  /// @param key Pre-parsed parameter name.
+  template <typename Tp>
+  Tp Get(const KeyHandle &key) const;
+
+  /// @}
+
+  //---------------------------------------------------------------------------
+  // Non-throwing access
+
+  /// @name Non-throwing access
+  ///
+  /// @desc Look up parameters without raising exceptions.
+  ///
+  /// @{
+
+  /// @brief Returns the parameter or the reason why it cannot be looked up.
+  ///
+  /// Supports the same types as `Get(const KeyHandle &)`. In contrast to the
+  /// getters, a missing parameter or a type mismatch is reported via the
+  /// returned `LookupResult` instead of raising an exception. Thus, failed
+  /// lookups are cheap, *i.e.* they neither allocate memory nor look up
+  /// similar keys. The parameter name is resolved exactly once.
+  ///
+  /// @code {.cpp}
+  /// const double fx = cfg.TryGet<double>("camera.fx"sv).ValueOr(500.0);
+  /// @endcode
+  ///
+  /// @tparam Tp Type of the parameter.
+  /// @param key Fully qualified parameter name.
+  template <typename Tp>
+  LookupResult<Tp> TryGet(std::string_view key) const;
+
+  /// @brief Returns the parameter referred to by the handle or the reason why
+  ///   it cannot be looked up, see `TryGet(std::string_view)`.
+  /// @tparam Tp Type of the parameter.
+  /// @param key Pre-parsed parameter name.
+  template <typename Tp>
+  LookupResult<Tp> TryGet(const KeyHandle &key) const;
+
+  /// @}
+
+  //---------------------------------------------------------------------------
+  // Batch access
+
+  /// @name Batch access
+  ///
+  /// @desc Look up many parameters at once.
+  ///
+  /// @{
+
+  /// @brief Binds parameters to typed destinations, see `Bind`.
+  ///
+  /// Supports the same types as `Get(const KeyHandle &)`. The binder refers
+  /// to the configuration which created it, thus, the configuration must
+  /// outlive it.
+  class WERKZEUGKISTE_CONFIG_EXPORT Binder {
+   public:
+    /// @brief Binds a required parameter.
+    ///
+    /// Raises a `KeyError` if the name contains a malformed list index.
+    /// Raises a `ValueError` if the destination is a nullptr.
+    ///
+    /// @param key Fully qualified parameter name.
+    /// @param destination The parameter value will be stored here.
+    template <typename Tp>
+    Binder &Field(std::string_view key, Tp *destination) {
+      Add(key, Destination{destination}, /*optional=*/false);
+      return *this;
+    }
+
+    /// @brief Binds an optional parameter, *i.e.* if it does not exist,
+    ///   the destination will not be changed (and thus keeps its default).
+    ///
+    /// Raises a `KeyError` if the name contains a malformed list index.
+    /// Raises a `ValueError` if the destination is a nullptr.
+    ///
+    /// @param key Fully qualified parameter name.
+    /// @param destination The parameter value will be stored here.
+    template <typename Tp>
+    Binder &Optional(std::string_view key, Tp *destination) {
+      Add(key, Destination{destination}, /*optional=*/true);
+      return *this;
+    }
+
+    /// @brief Looks up all bound parameters and stores their values.
+    ///
+    /// The parameters are looked up in sorted order, such that shared
+    /// path prefixes (*e.g.* `camera` of `camera.fx` and `camera.fy`) are
+    /// only resolved once. A binder can be resolved repeatedly, *e.g.* to
+    /// refresh the destinations after the configuration has been modified.
+    ///
+    /// Instead of failing at the first invalid parameter, all errors are
+    /// collected and reported within a single exception. Its message lists
+    /// one error per line. Destinations of valid parameters will be set
+    /// nonetheless.
+    ///
+    /// Raises a `KeyError` if any required parameter does not exist.
+    /// Otherwise, raises a `TypeError` if any parameter is of a different
+    ///   type.
+    void Resolve();
+
+   private:
+    friend class Configuration;
+
+    using Destination = std::variant<bool *, int32_t *, int64_t *, double *,
+        std::string *, date *, time *, date_time *, std::vector<bool> *,
+        std::vector<int32_t> *, std::vector<int64_t> *, std::vector<double> *,
+        std::vector<std::string> *, std::vector<date> *, std::vector<time> *,
+        std::vector<date_time> *>;
+
+    /// @brief A bound parameter, whose name and path components are stored
+    ///   in the binder's shared buffers.
+    struct Binding {
+      std::size_t key_offset;
+      std::size_t key_length;
+      std::size_t segments_begin;
+      std::size_t segments_end;
+      Destination destination;
+      bool optional;
+    };
+
+    explicit Binder(const Configuration &config) : config_{&config} {}
+
+    void Add(std::string_view key, Destination destination, bool optional);
+
+    /// The configuration to look up the parameters.
+    const Configuration *config_;
+
+    /// The bound parameters, in the order of their registration.
+    std::vector<Binding> bindings_{};
+
+    /// The concatenated names of all bound parameters.
+    std::string keys_{};
+
+    /// The path components of all bound parameters.
+    std::vector<KeyHandle::Segment> segments_{};
+
+    /// Indices into `bindings_`, sorted by parameter name. Computed upon
+    /// the first `Resolve` after adding a parameter.
+    std::vector<std::size_t> order_{};
+  };
+
+  /// @brief Returns a binder to look up many parameters at once.
+  ///
+  /// @code {.cpp}
+  /// double fx{0.0};
+  /// std::string name{"default"};
+  /// cfg.Bind()
+  ///     .Field("camera.fx"sv, &fx)
+  ///     .Optional("camera.name"sv, &name)
+  ///     .Resolve();
+  /// @endcode
+  Binder Bind() const;
+
+  /// @}
+
   //---------------------------------------------------------------------------
   // Booleans
 
@@ -617,6 +1036,26 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @param key Fully qualified parameter name.
   std::vector<double> GetDoubleList(std::string_view key) const;
 
+  /// @brief Loads a list of double-precision floating point values into a
+  ///   preallocated buffer.
+  ///
+  /// Intended for large lists, *e.g.* lookup tables: no intermediate
+  /// `std::vector` is allocated and, if the list holds only floating point
+  /// values, the per-element type checks are skipped.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `ValueError` if the number of list elements differs from
+  /// `size`, see `Size(key)`.
+  /// Raises a `TypeError` if the parameter is not a list of numbers, or if a
+  /// value cannot be exactly represented by a double.
+  ///
+  /// @param key Fully qualified parameter name.
+  /// @param data Pointer to the first element of the output buffer.
+  /// @param size Number of elements of the output buffer.
+  void GetDoubleListInto(std::string_view key,
+      double *data,
+      std::size_t size) const;
+
   /// @brief Sets or replaces a list of double-precision floating point values.
   ///
   /// Raises a `TypeError` if the parameter exists but is of a different type.
@@ -1079,6 +1518,10 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @{
 
   /// @brief Returns a copy of the sub-group.
+  ///
+  /// This is a constant-time operation, because the sub-group shares the
+  /// parameters with this configuration until either of them is modified.
+  ///
   /// @param key Fully qualified name of the parameter (which must be a
   ///   group, e.g. a JSON dictionary, a TOML table, or a libconfig group).
   Configuration GetGroup(std::string_view key) const;
@@ -1097,6 +1540,12 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @param group The group to be inserted.
   void SetGroup(std::string_view key, const Configuration &group);
 
+  /// @brief Inserts (or replaces) the given configuration group.
+  ///
+  /// Same as `SetGroup(key, const Configuration &)`, but avoids copying the
+  /// group's parameters if they are not shared with another configuration.
+  void SetGroup(std::string_view key, Configuration &&group);
+
   /// @} // Group/Sub-Configuration
 
   //---------------------------------------------------------------------------
@@ -1249,6 +1698,29 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @return Matrix of `double` values in row-major order.
   Matrix<double> GetMatrixDouble(std::string_view key) const;
 
+  /// @brief Loads a list/nested list into a preallocated 2D matrix.
+  ///
+  /// Behaves like `GetMatrixDouble`, but writes into the given matrix, block
+  /// or `Eigen::Map` instead of allocating a new matrix. If the (nested)
+  /// lists hold only floating point values, the per-element type checks are
+  /// skipped.
+  ///
+  /// @code {.cpp}
+  /// wkc::Matrix<double> lut(cfg.Size("lut"sv), 1);
+  /// cfg.GetMatrixInto("lut"sv, lut);
+  /// @endcode
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `ValueError` if the shape of `mat` differs from the shape of
+  /// the parameter. A single list corresponds to a Nx1 matrix.
+  /// Raises a `TypeError` if the parameter cannot be converted to a matrix
+  /// of `double` values.
+  ///
+  /// @param key Fully qualified name of the parameter.
+  /// @param mat Correctly sized, row-major output matrix.
+  void GetMatrixInto(std::string_view key,
+      Eigen::Ref<Matrix<double>> mat) const;
+
   /// @brief Stores a matrix as list.
   ///
   /// Matrices will be stored as lists of either 64-bit integers or
@@ -1272,27 +1744,17 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
     using TpCfg =
         std::conditional_t<std::is_integral_v<TpMat>, int64_t, double>;
 
-    if (EnsureTypeIfExists(key, ConfigType::List)) {
-      ClearList(key);
+    if constexpr (std::is_same_v<TpMat, TpCfg>) {
+      SetMatrixValues(key, Eigen::Ref<const Matrix<TpCfg>>{mat});
     } else {
-      CreateList(key);
-    }
-
-    // Matrix will be flattened if it holds only 1 row or column
-    const bool single_list = (mat.rows() == 1) || (mat.cols() == 1);
-
-    for (int row = 0; row < mat.rows(); ++row) {
-      const std::string nested_key =
-          single_list ? std::string{key}
-                      : KeyForListElement(key, static_cast<std::size_t>(row));
-      if (!single_list) {
-        AppendList(key);
-      }
-
-      for (int col = 0; col < mat.cols(); ++col) {
-        Append(nested_key,
-            checked_numcast<TpCfg, TpMat, TypeError>(mat.coeff(row, col)));
+      Matrix<TpCfg> values(mat.rows(), mat.cols());
+      for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+        for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+          values(row, col) =
+              checked_numcast<TpCfg, TpMat, TypeError>(mat.coeff(row, col));
+        }
       }
+      SetMatrixValues(key, values);
     }
   }
 
@@ -1367,6 +1829,14 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
 
   /// @brief Visits all string parameters below the given `key` group and
   ///   replaces any occurrence of the given needle/replacement pairs.
+  ///
+  /// Each string is scanned only once, *i.e.* the runtime is linear in the
+  /// string length, independent of the number of pairs. Matches do not
+  /// overlap: the leftmost match wins and, if several needles start at the
+  /// same position, the longest one. Replaced text is not searched again.
+  ///
+  /// Raises a `ValueError` if any search string is empty.
+  ///
   /// @param key Fully qualified parameter name.
   /// @param replacements List of `<search, replacement>` pairs.
   /// @return True if any placeholder has actually been replaced.
@@ -1385,6 +1855,40 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
     return ReplaceStringPlaceholders(""sv, replacements);
   }
 
+  /// @brief Replaces placeholders and adjusts relative paths of the string
+  ///   parameters below the given `key` group within a single traversal.
+  ///
+  /// Same as calling `ReplaceStringPlaceholders` and then
+  /// `AdjustRelativePaths`, but visits each string parameter only once.
+  /// Thus, a path parameter may use placeholders, *e.g.*
+  /// `"${SESSION}/video.mp4"`, and will be made absolute after the
+  /// placeholders have been replaced.
+  ///
+  /// @param key Fully qualified parameter name.
+  /// @param replacements List of `<search, replacement>` pairs.
+  /// @param base_path Base path to be prepended to relative file paths.
+  /// @param path_parameters A list of parameter names / patterns which hold
+  ///   file paths, see `AdjustRelativePaths`.
+  /// @return True if any parameter has been changed.
+  bool RewriteStrings(std::string_view key,
+      const std::vector<std::pair<std::string_view, std::string_view>>
+          &replacements,
+      std::string_view base_path,
+      const std::vector<std::string_view> &path_parameters);
+
+  /// @brief Replaces placeholders and adjusts relative paths of the string
+  ///   parameters below the configuration root within a single traversal.
+  ///
+  /// See `RewriteStrings(key, replacements, base_path, path_parameters)`.
+  inline bool RewriteStrings(
+      const std::vector<std::pair<std::string_view, std::string_view>>
+          &replacements,
+      std::string_view base_path,
+      const std::vector<std::string_view> &path_parameters) {
+    using namespace std::string_view_literals;
+    return RewriteStrings(""sv, replacements, base_path, path_parameters);
+  }
+
   /// @brief Loads a nested configuration.
   ///
   /// For example, if your configuration had a field "storage", which
@@ -1410,6 +1914,45 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   ///     given as string.
   void LoadNestedConfiguration(std::string_view key);
 
+  /// @brief Loads all nested configurations whose parameter names match.
+  ///
+  /// Similar to `LoadNestedConfiguration`, but collects all matching string
+  /// parameters within a single traversal and loads the referenced files
+  /// concurrently. The loaded configurations are then inserted in the order
+  /// of their parameter names, *i.e.* the result does not depend on the
+  /// order in which the files have been parsed.
+  ///
+  /// A file that is included multiple times (*i.e.* resolves to the same
+  /// canonical path) is only parsed once. Nothing is cached across calls,
+  /// unless a `NestedConfigurationCache` is provided.
+  ///
+  /// If any file cannot be loaded, the configuration remains unchanged.
+  ///
+  /// Raises a `TypeError` if a matching parameter is not a direct child of
+  ///   a table node (*i.e.* an array element).
+  /// Raises a `ParseError` if parsing an external configuration failed.
+  ///
+  /// @param keys Patterns of the parameter names which hold the file names
+  ///   of the nested configurations, *e.g.* `{"*.include"sv}`. Parameters
+  ///   which match but are not strings are ignored.
+  /// @return True if any nested configuration has been loaded.
+  bool LoadNestedConfigurations(const KeyMatcher &keys);
+
+  /// @brief Loads all nested configurations whose parameter names match,
+  ///   reusing the files which have already been parsed by previous calls.
+  ///
+  /// Same as `LoadNestedConfigurations(keys)`, but files are only parsed
+  /// if they are not in the given cache, or if they have been modified
+  /// since they were cached.
+  ///
+  /// @param keys Patterns of the parameter names which hold the file names
+  ///   of the nested configurations.
+  /// @param cache Cache of the parsed files, which will be updated. It can
+  ///   be shared by multiple threads.
+  /// @return True if any nested configuration has been loaded.
+  bool LoadNestedConfigurations(const KeyMatcher &keys,
+      NestedConfigurationCache &cache);
+
   /// @}  // Utilities
 
   //---------------------------------------------------------------------------
@@ -1417,7 +1960,8 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
 
   /// @name Serialization
   ///
-  /// @desc Represent this configuration as a string in a specific format.
+  /// @desc Represent this configuration as a string in a specific format, or
+  ///   write it to an output stream.
   ///
   /// @{
 
@@ -1433,6 +1977,38 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
   /// @brief Returns a libconfig-formatted string of this configuration.
   std::string ToLibconfig() const;
 
+  /// @brief Writes the TOML representation of this configuration to the
+  ///   given stream, i.e. without creating an intermediate string.
+  void WriteTOML(std::ostream &out) const;
+
+  /// @brief Writes the JSON representation of this configuration to the
+  ///   given stream.
+  void WriteJSON(std::ostream &out) const;
+
+  /// @brief Writes the YAML representation of this configuration to the
+  ///   given stream.
+  void WriteYAML(std::ostream &out) const;
+
+  /// @brief Writes the libconfig representation of this configuration to the
+  ///   given stream.
+  void WriteLibconfig(std::ostream &out) const;
+
+  /// @brief Writes a binary snapshot of this configuration to the given
+  ///   stream, see `SaveBinary`. The stream should be opened in binary mode.
+  void WriteBinary(std::ostream &out) const;
+
+  /// @brief Saves a binary snapshot of this configuration.
+  ///
+  /// The compact, versioned little-endian encoding stores all keys and
+  /// strings once in a string table and homogeneous lists of scalars as
+  /// contiguous arrays. Loading a snapshot via `LoadBinary` avoids parsing
+  /// the original (text) configuration on every start.
+  ///
+  /// Raises a `werkzeugkiste::files::IOError` if the file cannot be written.
+  ///
+  /// @param filename Output file path.
+  void SaveBinary(std::string_view filename) const;
+
   /// @}  // Serialization
 
   /// @brief Applies the selected `NullValuePolicy` to the given parameter.
@@ -1452,6 +2028,52 @@ class WERKZEUGKISTE_CONFIG_EXPORT Configuration {
       bool append);
 
  private:
+  friend struct detail::ConfigurationAccess;
+
+  /// @brief Creates or replaces the list `key` by the given matrix, see
+  ///   `SetMatrix`.
+  void SetMatrixValues(std::string_view key,
+      Eigen::Ref<const Matrix<int64_t>> mat);
+
+  /// @brief Creates or replaces the list `key` by the given matrix, see
+  ///   `SetMatrix`.
+  void SetMatrixValues(std::string_view key,
+      Eigen::Ref<const Matrix<double>> mat);
+
+  /// Forward declaration of internal implementation struct.
+  struct Impl;
+
+  /// Pointer to internal implementation.
+  std::unique_ptr<Impl> pimpl_;
+};
+
+/// @brief Cache of parsed nested configuration files, see
+///   `Configuration::LoadNestedConfigurations`.
+///
+/// Files are identified by their canonical path. A cached configuration is
+/// only reused as long as the file's size and modification time did not
+/// change. The cache is owned by the caller, *i.e.* its lifetime (and thus,
+/// its memory usage) is under the caller's control.
+class WERKZEUGKISTE_CONFIG_EXPORT NestedConfigurationCache {
+ public:
+  NestedConfigurationCache();
+  ~NestedConfigurationCache();
+
+  NestedConfigurationCache(const NestedConfigurationCache &) = delete;
+  NestedConfigurationCache &operator=(
+      const NestedConfigurationCache &) = delete;
+  NestedConfigurationCache(NestedConfigurationCache &&) noexcept;
+  NestedConfigurationCache &operator=(NestedConfigurationCache &&) noexcept;
+
+  /// @brief Returns the number of cached files.
+  std::size_t Size() const;
+
+  /// @brief Removes all cached files.
+  void Clear();
+
+ private:
+  friend class Configuration;
+
   /// Forward declaration of internal implementation struct.
   struct Impl;
 
@@ -1549,6 +2171,22 @@ WERKZEUGKISTE_CONFIG_EXPORT
 Configuration LoadYAMLString(const std::string &yaml_string,
     NullValuePolicy none_policy = NullValuePolicy::Skip);
 
+/// @brief Loads a configuration from the environment variables which start
+///   with the given prefix, followed by a double underscore.
+///
+/// Double underscores separate the group names, *e.g.* the variable
+/// `WZK_CFG__camera__fps=30` sets the parameter `camera.fps` for the prefix
+/// `WZK_CFG`. Values are parsed as TOML values, *e.g.* `30` is an integer,
+/// `[1, 2]` a list and `"30"` a string. Values which are not valid TOML are
+/// loaded as strings, *e.g.* `front-left`.
+///
+/// Raises a `ParseError` if variables conflict, *e.g.* if both
+/// `WZK_CFG__camera` and `WZK_CFG__camera__fps` are set.
+///
+/// @param prefix Prefix of the environment variables to load.
+WERKZEUGKISTE_CONFIG_EXPORT
+Configuration LoadEnvironment(std::string_view prefix);
+
 /// @}
 
 /// @name String Representation
@@ -1578,6 +2216,31 @@ inline std::string DumpYAMLString(const Configuration &cfg) {
 
 /// @}
 
+/// @name Error Messages
+///
+/// @{
+
+/// @brief Enables or disables suggestions of similar parameter names within
+///   the message of a `KeyError` (enabled by default).
+///
+/// The suggestions are looked up in an index of all parameter names, which is
+/// built upon the first failed lookup and rebuilt after the configuration has
+/// been modified. Applications which probe optional parameters via exceptions
+/// can disable suggestions to avoid this overhead.
+///
+/// This setting affects all configurations of the process.
+///
+/// @param enable If false, a `KeyError` will only state the missing key.
+WERKZEUGKISTE_CONFIG_EXPORT
+void EnableKeySuggestions(bool enable);
+
+/// @brief Returns true if a `KeyError` suggests similar parameter names, see
+///   `EnableKeySuggestions`.
+WERKZEUGKISTE_CONFIG_EXPORT
+bool AreKeySuggestionsEnabled();
+
+/// @}
+
 }  // namespace werkzeugkiste::config
 
 #endif  // WERKZEUGKISTE_CONFIG_CONFIGURATION_H
@@ -0,0 +1,195 @@
+#ifndef WERKZEUGKISTE_CONFIG_FROZEN_H
+#define WERKZEUGKISTE_CONFIG_FROZEN_H
+
+#include <werkzeugkiste/config/config_export.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/types.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace werkzeugkiste::config {
+//-----------------------------------------------------------------------------
+// Immutable configuration snapshots
+
+/// @brief An immutable, read-only snapshot of a `Configuration`.
+///
+/// Created via `Configuration::Freeze()`. All parameters are stored in a
+/// single contiguous array, where the elements of a list or group are
+/// adjacent. Fully qualified parameter names are kept in a sorted index,
+/// thus a lookup is a binary search instead of a tree traversal.
+///
+/// A frozen configuration cannot be modified. Copies share the same
+/// (reference-counted) data, *i.e.* copying is cheap and any number of
+/// threads can read the same snapshot without synchronization. To replace a
+/// shared snapshot at runtime, *e.g.* when reloading the configuration file,
+/// use an `AtomicFrozenConfiguration`.
+///
+/// Only the scalar, list and group getters are provided. Points and matrices
+/// cannot be queried from a snapshot, load them from the `Configuration`
+/// before freezing it.
+///
+/// @code {.cpp}
+/// wkc::FrozenConfiguration frozen = wkc::LoadFile("config.toml").Freeze();
+/// // Can be safely passed to (and read by) multiple threads:
+/// double value = frozen.GetDouble("section.value"sv);
+/// @endcode
+class WERKZEUGKISTE_CONFIG_EXPORT FrozenConfiguration {
+ public:
+  /// @brief Constructs an empty configuration.
+  FrozenConfiguration();
+
+  /// @brief Returns true if this configuration has no parameters set.
+  bool Empty() const;
+
+  /// @brief Checks if the given key exists in this configuration.
+  /// @param key Fully qualified identifier of the parameter.
+  bool Contains(std::string_view key) const;
+
+  /// @brief Returns the length of the parameter list/group named `key`.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `TypeError` if the parameter is not a list or a group.
+  ///
+  /// @param key Fully qualified identifier of the parameter.
+  std::size_t Size(std::string_view key) const;
+
+  /// @brief Returns the number of parameters (key-value pairs) in this
+  /// configuration.
+  inline std::size_t Size() const { return Size(""); }
+
+  /// @brief Returns the type of the parameter at the given key.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  ///
+  /// @param key Fully qualified identifier of the parameter.
+  ConfigType Type(std::string_view key) const;
+
+  /// @brief Returns the fully qualified names of all named parameters in
+  ///   lexicographic order.
+  ///
+  /// List elements are not included, but named parameters within lists are,
+  /// *e.g.* `lst[3].name`.
+  std::vector<std::string> ListParameterNames() const;
+
+  /// @name Typed getters
+  ///
+  /// @desc The typed getters follow the same conversion rules as the
+  ///   corresponding `Configuration` getters. Thus, they raise a `KeyError`
+  ///   if the parameter does not exist and a `TypeError` if the parameter is
+  ///   of a different type (and cannot be converted exactly). The `...Or`
+  ///   variants return the default value and the `GetOptional...` variants
+  ///   return `std::nullopt` if the parameter does not exist.
+  ///
+  /// @{
+  bool GetBool(std::string_view key) const;
+  bool GetBoolOr(std::string_view key, bool default_val) const;
+  std::optional<bool> GetOptionalBool(std::string_view key) const;
+  std::vector<bool> GetBoolList(std::string_view key) const;
+
+  int32_t GetInt32(std::string_view key) const;
+  int32_t GetInt32Or(std::string_view key, int32_t default_val) const;
+  std::optional<int32_t> GetOptionalInt32(std::string_view key) const;
+  std::vector<int32_t> GetInt32List(std::string_view key) const;
+
+  int64_t GetInt64(std::string_view key) const;
+  int64_t GetInt64Or(std::string_view key, int64_t default_val) const;
+  std::optional<int64_t> GetOptionalInt64(std::string_view key) const;
+  std::vector<int64_t> GetInt64List(std::string_view key) const;
+
+  double GetDouble(std::string_view key) const;
+  double GetDoubleOr(std::string_view key, double default_val) const;
+  std::optional<double> GetOptionalDouble(std::string_view key) const;
+  std::vector<double> GetDoubleList(std::string_view key) const;
+
+  std::string GetString(std::string_view key) const;
+  std::string GetStringOr(std::string_view key,
+      std::string_view default_val) const;
+  std::optional<std::string> GetOptionalString(std::string_view key) const;
+  std::vector<std::string> GetStringList(std::string_view key) const;
+
+  date GetDate(std::string_view key) const;
+  date GetDateOr(std::string_view key, const date &default_val) const;
+  std::optional<date> GetOptionalDate(std::string_view key) const;
+  std::vector<date> GetDateList(std::string_view key) const;
+
+  time GetTime(std::string_view key) const;
+  time GetTimeOr(std::string_view key, const time &default_val) const;
+  std::optional<time> GetOptionalTime(std::string_view key) const;
+  std::vector<time> GetTimeList(std::string_view key) const;
+
+  date_time GetDateTime(std::string_view key) const;
+  date_time GetDateTimeOr(std::string_view key,
+      const date_time &default_val) const;
+  std::optional<date_time> GetOptionalDateTime(std::string_view key) const;
+  std::vector<date_time> GetDateTimeList(std::string_view key) const;
+  /// @}
+
+  /// @brief Returns a snapshot of the sub-group.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `TypeError` if the parameter is not a group.
+  ///
+  /// @param key Fully qualified name of the group.
+  FrozenConfiguration GetGroup(std::string_view key) const;
+
+ private:
+  friend class Configuration;
+  friend class AtomicFrozenConfiguration;
+
+  /// Forward declaration of internal implementation struct.
+  struct Impl;
+
+  explicit FrozenConfiguration(std::shared_ptr<const Impl> data);
+
+  /// Shared, immutable data.
+  std::shared_ptr<const Impl> pimpl_;
+};
+
+/// @brief Holds a `FrozenConfiguration` which can be replaced at runtime,
+///   *e.g.* when a configuration file is reloaded.
+///
+/// `Load`, `Store` and `Exchange` can be called concurrently from any
+/// number of threads. A reader keeps the snapshot returned by `Load` alive,
+/// even if it is replaced in the meantime.
+///
+/// @code {.cpp}
+/// wkc::AtomicFrozenConfiguration shared{cfg.Freeze()};
+/// // Worker thread(s):
+/// const wkc::FrozenConfiguration snapshot = shared.Load();
+/// // Reloading thread:
+/// shared.Store(wkc::LoadFile("config.toml").Freeze());
+/// @endcode
+class WERKZEUGKISTE_CONFIG_EXPORT AtomicFrozenConfiguration {
+ public:
+  /// @brief Holds an empty configuration.
+  AtomicFrozenConfiguration();
+
+  /// @brief Holds the given snapshot.
+  explicit AtomicFrozenConfiguration(const FrozenConfiguration &cfg);
+
+  AtomicFrozenConfiguration(const AtomicFrozenConfiguration &) = delete;
+  AtomicFrozenConfiguration &operator=(
+      const AtomicFrozenConfiguration &) = delete;
+
+  /// @brief Returns the current snapshot.
+  FrozenConfiguration Load() const;
+
+  /// @brief Replaces the current snapshot.
+  void Store(const FrozenConfiguration &cfg);
+
+  /// @brief Replaces the current snapshot and returns the previous one.
+  FrozenConfiguration Exchange(const FrozenConfiguration &cfg);
+
+ private:
+  /// Must only be accessed via the atomic `std::shared_ptr` functions.
+  std::shared_ptr<const FrozenConfiguration::Impl> data_;
+};
+
+}  // namespace werkzeugkiste::config
+
+#endif  // WERKZEUGKISTE_CONFIG_FROZEN_H
@@ -16,6 +16,10 @@ namespace werkzeugkiste::config {
 
 /// @brief Matches keys (fully qualified parameter names) against user-defined
 /// patterns.
+///
+/// A pattern may contain the wildcard '*', which matches any (possibly empty)
+/// sequence of characters, e.g. "lst[*].name" or "*.filename". All other
+/// characters must match exactly.
 class WERKZEUGKISTE_CONFIG_EXPORT KeyMatcher {
  public:
   /// @brief Default constructor.
@@ -0,0 +1,150 @@
+#ifndef WERKZEUGKISTE_CONFIG_LAYERED_H
+#define WERKZEUGKISTE_CONFIG_LAYERED_H
+
+#include <werkzeugkiste/config/config_export.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace werkzeugkiste::config {
+//-----------------------------------------------------------------------------
+// Layered configurations
+
+/// @brief A read-only view which stacks multiple configurations, *e.g.* a
+///   base configuration, site-specific settings and per-host overrides.
+///
+/// Lookups resolve top-down, *i.e.* a parameter of a higher layer overrides
+/// the same parameter of all lower layers. The layers are not merged:
+/// Each layer shares the parameter tree of the configuration it has been
+/// created from (see the copy-on-write semantics of `Configuration`), thus
+/// adding a layer does not copy any parameters. Use `Flatten()` if a merged
+/// configuration is needed.
+///
+/// The layers are combined as if they had been merged bottom-up:
+/// * Groups are merged recursively, *i.e.* a higher layer only needs to
+///   specify the parameters of a group which it overrides.
+/// * Scalars and lists replace the parameter of a lower layer as a whole.
+///   This also hides any parameters below this key, *e.g.* if the top layer
+///   sets `camera = "none"`, the parameter `camera.fps` of a lower layer is
+///   no longer visible.
+///
+/// @code {.cpp}
+/// wkc::LayeredConfiguration cfg{};
+/// cfg.PushLayer(wkc::LoadFile("base.toml"));
+/// cfg.PushLayer(wkc::LoadFile("site.toml"));
+/// // Allow overrides such as `WZK_CFG__camera__fps=30`:
+/// cfg.PushLayer(wkc::LoadEnvironment("WZK_CFG"sv));
+/// double fps = cfg.GetDouble("camera.fps"sv);
+/// @endcode
+class WERKZEUGKISTE_CONFIG_EXPORT LayeredConfiguration {
+ public:
+  /// @brief Constructs a view without any layers.
+  LayeredConfiguration() = default;
+
+  /// @brief Adds a layer on top of all previously added layers.
+  ///
+  /// The layer shares the parameters of the given configuration. Any later
+  /// modification of `layer` does not affect this view.
+  void PushLayer(const Configuration &layer);
+
+  /// @brief Returns the number of layers.
+  std::size_t NumLayers() const { return layers_.size(); }
+
+  /// @brief Returns true if no layer contains any parameter.
+  bool Empty() const;
+
+  /// @brief Checks if any layer provides the given key (and the key is not
+  ///   hidden by a higher layer).
+  /// @param key Fully qualified identifier of the parameter.
+  bool Contains(std::string_view key) const;
+
+  /// @brief Returns the type of the parameter at the given key.
+  ///
+  /// Raises a `KeyError` if the parameter does not exist.
+  ///
+  /// @param key Fully qualified identifier of the parameter.
+  ConfigType Type(std::string_view key) const;
+
+  /// @brief Returns the merged configuration of all layers.
+  ///
+  /// If there is only a single layer, its parameters are shared instead of
+  /// copied.
+  Configuration Flatten() const;
+
+  /// @brief Returns the merged group `key` of all layers.
+  ///
+  /// Only the parameters below `key` will be copied.
+  /// Raises a `KeyError` if the parameter does not exist.
+  /// Raises a `TypeError` if the parameter is not a group.
+  ///
+  /// @param key Fully qualified identifier of the group.
+  Configuration GetGroup(std::string_view key) const;
+
+  /// @name Typed getters
+  ///
+  /// @desc The typed getters resolve the layer which provides the parameter
+  ///   and then follow the conversion rules of the corresponding
+  ///   `Configuration` getters. Thus, they raise a `KeyError` if the
+  ///   parameter does not exist and a `TypeError` if the parameter is of a
+  ///   different type (and cannot be converted exactly). The `...Or`
+  ///   variants return the default value if the parameter does not exist.
+  ///
+  /// @{
+  bool GetBool(std::string_view key) const;
+  bool GetBoolOr(std::string_view key, bool default_val) const;
+  std::optional<bool> GetOptionalBool(std::string_view key) const;
+  std::vector<bool> GetBoolList(std::string_view key) const;
+
+  int32_t GetInt32(std::string_view key) const;
+  int32_t GetInt32Or(std::string_view key, int32_t default_val) const;
+  std::optional<int32_t> GetOptionalInt32(std::string_view key) const;
+  std::vector<int32_t> GetInt32List(std::string_view key) const;
+
+  int64_t GetInt64(std::string_view key) const;
+  int64_t GetInt64Or(std::string_view key, int64_t default_val) const;
+  std::optional<int64_t> GetOptionalInt64(std::string_view key) const;
+  std::vector<int64_t> GetInt64List(std::string_view key) const;
+
+  double GetDouble(std::string_view key) const;
+  double GetDoubleOr(std::string_view key, double default_val) const;
+  std::optional<double> GetOptionalDouble(std::string_view key) const;
+  std::vector<double> GetDoubleList(std::string_view key) const;
+
+  std::string GetString(std::string_view key) const;
+  std::string GetStringOr(std::string_view key,
+      std::string_view default_val) const;
+  std::optional<std::string> GetOptionalString(std::string_view key) const;
+  std::vector<std::string> GetStringList(std::string_view key) const;
+
+  date GetDate(std::string_view key) const;
+  date GetDateOr(std::string_view key, const date &default_val) const;
+
+  time GetTime(std::string_view key) const;
+  time GetTimeOr(std::string_view key, const time &default_val) const;
+
+  date_time GetDateTime(std::string_view key) const;
+  date_time GetDateTimeOr(std::string_view key,
+      const date_time &default_val) const;
+  /// @}
+
+ private:
+  /// Layers from bottom (lowest priority) to top.
+  std::vector<Configuration> layers_{};
+
+  /// Returns the topmost layer which provides the key, or nullptr.
+  const Configuration *Find(std::string_view key) const;
+
+  /// Returns the topmost layer which provides the key or raises a
+  /// `KeyError`.
+  const Configuration &Layer(std::string_view key) const;
+};
+
+}  // namespace werkzeugkiste::config
+
+#endif  // WERKZEUGKISTE_CONFIG_LAYERED_H
@@ -0,0 +1,575 @@
+#ifndef WERKZEUGKISTE_CONFIG_REFLECTION_H
+#define WERKZEUGKISTE_CONFIG_REFLECTION_H
+
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Field descriptors of parameter structs
+
+/// @brief Declares the fields of a (parameter) struct, such that it can be
+///   loaded from and stored to a `Configuration` via `Load` and `Store`.
+///
+/// Must be placed in the namespace of the struct (after its definition).
+/// The field names are used as parameter names. Supported field types are
+/// the scalar parameter types (`bool`, `int32_t`, `int64_t`, `double`,
+/// `std::string`, `date`, `time` and `date_time`), `std::vector`s of these,
+/// other structs declared via `WZK_CONFIG_STRUCT`, and `std::vector`s of such
+/// structs. Up to 32 fields can be declared.
+///
+/// @code {.cpp}
+/// namespace app {
+/// struct Intrinsics {
+///   double fx{0.0};
+///   double fy{0.0};
+/// };
+/// WZK_CONFIG_STRUCT(Intrinsics, fx, fy)
+///
+/// struct Camera {
+///   std::string name{};
+///   Intrinsics intrinsics{};
+///   std::vector<double> distortion{};
+/// };
+/// WZK_CONFIG_STRUCT(Camera, name, intrinsics, distortion)
+/// }  // namespace app
+///
+/// const auto cam = wkc::Load<app::Camera>(cfg, "camera"sv);
+/// @endcode
+#define WZK_CONFIG_STRUCT(Type, ...)                                        \
+  [[maybe_unused]] constexpr auto WzkConfigFields(const Type * /* tag */) { \
+    return std::make_tuple(WZK_CONFIG_DETAIL_FOR_EACH(                      \
+        WZK_CONFIG_DETAIL_FIELD, Type, __VA_ARGS__));                       \
+  }
+
+#define WZK_CONFIG_DETAIL_FIELD(Type, name) \
+  ::werkzeugkiste::config::detail::MakeFieldDescriptor(#name, &Type::name)
+
+// Helper macros to apply a macro to each (variadic) argument. The additional
+// expansion step is required by MSVC's traditional preprocessor.
+#define WZK_CONFIG_DETAIL_EXPAND(x) x
+#define WZK_CONFIG_DETAIL_FE_1(M, T, x) M(T, x)
+#define WZK_CONFIG_DETAIL_FE_2(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_1(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_3(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_2(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_4(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_3(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_5(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_4(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_6(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_5(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_7(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_6(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_8(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_7(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_9(M, T, x, ...) \
+  M(T, x),                                   \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_8(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_10(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_9(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_11(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_10(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_12(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_11(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_13(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_12(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_14(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_13(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_15(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_14(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_16(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_15(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_17(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_16(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_18(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_17(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_19(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_18(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_20(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_19(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_21(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_20(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_22(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_21(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_23(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_22(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_24(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_23(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_25(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_24(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_26(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_25(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_27(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_26(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_28(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_27(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_29(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_28(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_30(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_29(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_31(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_30(M, T, __VA_ARGS__))
+#define WZK_CONFIG_DETAIL_FE_32(M, T, x, ...) \
+  M(T, x),                                    \
+  WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_FE_31(M, T, __VA_ARGS__))
+
+#define WZK_CONFIG_DETAIL_SELECT_FE(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10,   \
+    _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, \
+    _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+
+#define WZK_CONFIG_DETAIL_FOR_EACH(M, T, ...)                                  \
+    WZK_CONFIG_DETAIL_EXPAND(WZK_CONFIG_DETAIL_SELECT_FE(__VA_ARGS__,          \
+    WZK_CONFIG_DETAIL_FE_32, WZK_CONFIG_DETAIL_FE_31, WZK_CONFIG_DETAIL_FE_30, \
+    WZK_CONFIG_DETAIL_FE_29, WZK_CONFIG_DETAIL_FE_28, WZK_CONFIG_DETAIL_FE_27, \
+    WZK_CONFIG_DETAIL_FE_26, WZK_CONFIG_DETAIL_FE_25, WZK_CONFIG_DETAIL_FE_24, \
+    WZK_CONFIG_DETAIL_FE_23, WZK_CONFIG_DETAIL_FE_22, WZK_CONFIG_DETAIL_FE_21, \
+    WZK_CONFIG_DETAIL_FE_20, WZK_CONFIG_DETAIL_FE_19, WZK_CONFIG_DETAIL_FE_18, \
+    WZK_CONFIG_DETAIL_FE_17, WZK_CONFIG_DETAIL_FE_16, WZK_CONFIG_DETAIL_FE_15, \
+    WZK_CONFIG_DETAIL_FE_14, WZK_CONFIG_DETAIL_FE_13, WZK_CONFIG_DETAIL_FE_12, \
+    WZK_CONFIG_DETAIL_FE_11, WZK_CONFIG_DETAIL_FE_10, WZK_CONFIG_DETAIL_FE_9,  \
+    WZK_CONFIG_DETAIL_FE_8, WZK_CONFIG_DETAIL_FE_7, WZK_CONFIG_DETAIL_FE_6,    \
+    WZK_CONFIG_DETAIL_FE_5, WZK_CONFIG_DETAIL_FE_4, WZK_CONFIG_DETAIL_FE_3,    \
+    WZK_CONFIG_DETAIL_FE_2, WZK_CONFIG_DETAIL_FE_1)(M, T, __VA_ARGS__))
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// @brief Describes a single field of a parameter struct, *i.e.* its
+///   parameter name and the pointer to the member.
+template <typename Struct, typename Member>
+struct FieldDescriptor {
+  std::string_view name;
+  Member Struct::*member;
+};
+
+template <typename Struct, typename Member>
+constexpr FieldDescriptor<Struct, Member> MakeFieldDescriptor(
+    std::string_view name,
+    Member Struct::*member) {
+  return FieldDescriptor<Struct, Member>{name, member};
+}
+
+/// @brief Type trait to check if the fields of a struct have been declared
+///   via `WZK_CONFIG_STRUCT`.
+template <typename T, typename = void>
+struct IsConfigStruct : std::false_type {};
+
+template <typename T>
+struct IsConfigStruct<T,
+    std::void_t<decltype(WzkConfigFields(static_cast<const T *>(nullptr)))>>
+    : std::true_type {};
+
+/// @brief Type trait to check for a `std::vector` of parameter structs.
+template <typename T>
+struct IsConfigStructVector : std::false_type {};
+
+template <typename T>
+struct IsConfigStructVector<std::vector<T>> : IsConfigStruct<T> {};
+
+/// @brief Returns the field descriptors of a parameter struct. These are
+///   evaluated at compile time.
+template <typename T>
+constexpr auto ConfigStructFields() {
+  return WzkConfigFields(static_cast<const T *>(nullptr));
+}
+
+/// @brief Appends `.name` (or `name` at the root) to the parameter name.
+inline void AppendKey(std::string &key, std::string_view name) {
+  if (!key.empty()) {
+    key += '.';
+  }
+  key += name;
+}
+
+/// @brief Returns the parameter via the type-specific getter.
+template <typename T>
+T GetParameter(const Configuration &cfg, std::string_view key) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return cfg.GetBool(key);
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return cfg.GetInt32(key);
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return cfg.GetInt64(key);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return cfg.GetDouble(key);
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return cfg.GetString(key);
+  } else if constexpr (std::is_same_v<T, date>) {
+    return cfg.GetDate(key);
+  } else if constexpr (std::is_same_v<T, time>) {
+    return cfg.GetTime(key);
+  } else if constexpr (std::is_same_v<T, date_time>) {
+    return cfg.GetDateTime(key);
+  } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+    return cfg.GetBoolList(key);
+  } else if constexpr (std::is_same_v<T, std::vector<int32_t>>) {
+    return cfg.GetInt32List(key);
+  } else if constexpr (std::is_same_v<T, std::vector<int64_t>>) {
+    return cfg.GetInt64List(key);
+  } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+    return cfg.GetDoubleList(key);
+  } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+    return cfg.GetStringList(key);
+  } else if constexpr (std::is_same_v<T, std::vector<date>>) {
+    return cfg.GetDateList(key);
+  } else if constexpr (std::is_same_v<T, std::vector<time>>) {
+    return cfg.GetTimeList(key);
+  } else {
+    static_assert(std::is_same_v<T, std::vector<date_time>>,
+        "Unsupported parameter type!");
+    return cfg.GetDateTimeList(key);
+  }
+}
+
+/// @brief Collects the errors while loading a parameter struct.
+struct LoadErrors {
+  std::string missing{};
+  std::string invalid{};
+
+  static void Append(std::string &errors,
+      const std::string &group,
+      const char *what) {
+    if (!group.empty()) {
+      errors += "In group `";
+      errors += group;
+      errors += "`: ";
+    }
+    errors += what;
+    errors += '\n';
+  }
+};
+
+template <typename T>
+void LoadStruct(const Configuration &group,
+    const std::string &prefix,
+    T &obj,
+    LoadErrors &errors);
+
+/// @brief Loads a single field from the group (named `prefix`).
+template <typename T>
+void LoadValue(const Configuration &group,
+    const std::string &prefix,
+    std::string_view name,
+    T &value,
+    LoadErrors &errors) {
+  try {
+    if constexpr (IsConfigStruct<T>::value) {
+      std::string key{prefix};
+      AppendKey(key, name);
+      LoadStruct(group.GetGroup(name), key, value, errors);
+    } else if constexpr (IsConfigStructVector<T>::value) {
+      std::string key{prefix};
+      AppendKey(key, name);
+      value.resize(group.Size(name));
+      for (std::size_t idx = 0; idx < value.size(); ++idx) {
+        LoadStruct(group.GetGroup(Configuration::KeyForListElement(name, idx)),
+            Configuration::KeyForListElement(key, idx), value[idx], errors);
+      }
+    } else {
+      value = GetParameter<T>(group, name);
+    }
+  } catch (const KeyError &e) {
+    LoadErrors::Append(errors.missing, prefix, e.what());
+  } catch (const TypeError &e) {
+    LoadErrors::Append(errors.invalid, prefix, e.what());
+  }
+}
+
+/// @brief Loads all fields of the struct from the given group (named
+///   `prefix`), *i.e.* each (nested) group is looked up only once.
+template <typename T>
+void LoadStruct(const Configuration &group,
+    const std::string &prefix,
+    T &obj,
+    LoadErrors &errors) {
+  std::apply(
+      [&](const auto &...fields) -> void {
+        (LoadValue(group, prefix, fields.name, obj.*(fields.member), errors),
+            ...);
+      },
+      ConfigStructFields<T>());
+}
+
+template <typename T>
+void AppendFieldHandles(std::string &key,
+    std::vector<Configuration::KeyHandle> &handles);
+
+/// @brief Appends the handle of a single field, or the handles of all
+///   fields of a nested struct.
+template <typename M>
+void AppendFieldHandle(std::string &key,
+    std::vector<Configuration::KeyHandle> &handles) {
+  if constexpr (IsConfigStruct<M>::value) {
+    AppendFieldHandles<M>(key, handles);
+  } else {
+    handles.emplace_back(key);
+  }
+}
+
+/// @brief Appends the handles of all fields of the struct (and of its nested
+///   structs), where `key` is the name of the struct's group relative to
+///   the loaded group (which will be extended in-place by the field names).
+template <typename T>
+void AppendFieldHandles(std::string &key,
+    std::vector<Configuration::KeyHandle> &handles) {
+  const std::size_t length = key.length();
+  std::apply(
+      [&](const auto &...fields) -> void {
+        ((AppendKey(key, fields.name),
+             AppendFieldHandle<std::remove_reference_t<
+                 decltype(std::declval<T &>().*(fields.member))>>(
+                 key, handles),
+             key.resize(length)),
+            ...);
+      },
+      ConfigStructFields<T>());
+}
+
+/// @brief Returns the (pre-parsed) parameter names of all fields of the
+///   struct, in the order in which `TryLoadStruct` visits them.
+///
+/// A handle memoizes the resolved parameter, thus, each thread uses its own
+/// handles.
+template <typename T>
+const std::vector<Configuration::KeyHandle> &FieldHandles() {
+  thread_local const std::vector<Configuration::KeyHandle> handles = []() {
+    std::vector<Configuration::KeyHandle> result{};
+    std::string key{};
+    AppendFieldHandles<T>(key, result);
+    return result;
+  }();
+  return handles;
+}
+
+template <typename T>
+bool TryLoadStruct(const Configuration &group,
+    const std::vector<Configuration::KeyHandle> &handles,
+    std::size_t &handle_idx,
+    T &obj);
+
+/// @brief Loads a single field via its handle. Returns false (instead of
+///   raising an exception) if the field cannot be loaded.
+template <typename M>
+bool TryLoadValue(const Configuration &group,
+    const std::vector<Configuration::KeyHandle> &handles,
+    std::size_t &handle_idx,
+    M &value) {
+  if constexpr (IsConfigStruct<M>::value) {
+    return TryLoadStruct(group, handles, handle_idx, value);
+  } else if constexpr (IsConfigStructVector<M>::value) {
+    const Configuration::KeyHandle &handle = handles[handle_idx++];
+    if (!group.Contains(handle) ||
+        (group.Type(handle.Key()) != ConfigType::List)) {
+      return false;
+    }
+    using Element = typename M::value_type;
+    value.resize(group.Size(handle.Key()));
+    for (std::size_t idx = 0; idx < value.size(); ++idx) {
+      const std::string key =
+          Configuration::KeyForListElement(handle.Key(), idx);
+      if (group.Type(key) != ConfigType::Group) {
+        return false;
+      }
+      std::size_t element_idx{0};
+      if (!TryLoadStruct(group.GetGroup(key), FieldHandles<Element>(),
+              element_idx, value[idx])) {
+        return false;
+      }
+    }
+    return true;
+  } else {
+    auto result = group.TryGet<M>(handles[handle_idx++]);
+    if (!result) {
+      return false;
+    }
+    value = std::move(result).Value();
+    return true;
+  }
+}
+
+/// @brief Loads all fields of the struct via the precomputed handles, *i.e.*
+///   without parsing any parameter name or copying nested groups. Returns
+///   false as soon as a field cannot be loaded.
+template <typename T>
+bool TryLoadStruct(const Configuration &group,
+    const std::vector<Configuration::KeyHandle> &handles,
+    std::size_t &handle_idx,
+    T &obj) {
+  return std::apply(
+      [&](const auto &...fields) -> bool {
+        return (
+            TryLoadValue(group, handles, handle_idx, obj.*(fields.member)) &&
+            ...);
+      },
+      ConfigStructFields<T>());
+}
+
+template <typename T>
+void StoreStruct(Configuration &cfg, std::string &key, const T &obj);
+
+template <typename T>
+void StoreValue(Configuration &cfg, const std::string &key, const T &value) {
+  if constexpr (IsConfigStruct<T>::value) {
+    std::string prefix{key};
+    StoreStruct(cfg, prefix, value);
+  } else if constexpr (IsConfigStructVector<T>::value) {
+    if (cfg.Contains(key)) {
+      cfg.ClearList(key);
+    } else {
+      cfg.CreateList(key);
+    }
+    for (const auto &elem : value) {
+      Configuration group{};
+      std::string prefix{};
+      StoreStruct(group, prefix, elem);
+      cfg.Append(key, group);
+    }
+  } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+    cfg.SetBoolList(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<int32_t>>) {
+    cfg.SetInt32List(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<int64_t>>) {
+    cfg.SetInt64List(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+    cfg.SetDoubleList(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+    cfg.SetStringList(key, {value.begin(), value.end()});
+  } else if constexpr (std::is_same_v<T, std::vector<date>>) {
+    cfg.SetDateList(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<time>>) {
+    cfg.SetTimeList(key, value);
+  } else if constexpr (std::is_same_v<T, std::vector<date_time>>) {
+    cfg.SetDateTimeList(key, value);
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    cfg.SetString(key, value);
+  } else {
+    cfg.Set(key, value);
+  }
+}
+
+/// @brief Sets all fields of the struct, where `key` is the name of the
+///   parameter group (which will be extended in-place by the field names).
+template <typename T>
+void StoreStruct(Configuration &cfg, std::string &key, const T &obj) {
+  const std::size_t length = key.length();
+  std::apply(
+      [&](const auto &...fields) -> void {
+        ((AppendKey(key, fields.name),
+             StoreValue(cfg, key, obj.*(fields.member)),
+             key.resize(length)),
+            ...);
+      },
+      ConfigStructFields<T>());
+}
+}  // namespace detail
+
+/// @brief Loads a parameter struct declared via `WZK_CONFIG_STRUCT`.
+///
+/// The parameter names of all fields (including the fields of nested
+/// structs) are parsed only once into `KeyHandle`s. Thus, loading a struct
+/// neither parses parameter names nor copies nested groups (except for the
+/// elements of struct lists). Loading from the root of an unchanged
+/// configuration again even skips the lookups. Missing or invalid
+/// parameters are reported together.
+///
+/// Raises a `KeyError` if a parameter does not exist.
+/// Raises a `TypeError` if a parameter is of a different type.
+///
+/// @tparam T The parameter struct type.
+/// @param cfg The configuration.
+/// @param key Fully qualified name of the parameter group, or an empty
+///   string to load the struct from the root of the configuration.
+template <typename T>
+T Load(const Configuration &cfg, std::string_view key) {
+  static_assert(detail::IsConfigStruct<T>::value,
+      "The struct fields must be declared via WZK_CONFIG_STRUCT!");
+  std::optional<Configuration> subgroup{};
+  if (!key.empty()) {
+    subgroup = cfg.GetGroup(key);
+  }
+  const Configuration &group = subgroup.has_value() ? *subgroup : cfg;
+
+  // Usually, all fields can be looked up via their precomputed handles.
+  T obj{};
+  std::size_t handle_idx{0};
+  if (detail::TryLoadStruct(
+          group, detail::FieldHandles<T>(), handle_idx, obj)) {
+    return obj;
+  }
+
+  // Otherwise, the fields are loaded one by one to report all errors.
+  obj = T{};
+  detail::LoadErrors errors{};
+  detail::LoadStruct(group, std::string{key}, obj, errors);
+
+  if (!errors.missing.empty() || !errors.invalid.empty()) {
+    std::string msg{"Cannot load all struct parameters:\n"};
+    msg += errors.missing;
+    msg += errors.invalid;
+    msg.pop_back();
+    if (!errors.missing.empty()) {
+      throw KeyError{msg};
+    }
+    throw TypeError{msg};
+  }
+  return obj;
+}
+
+/// @brief Stores a parameter struct declared via `WZK_CONFIG_STRUCT`, *i.e.*
+///   sets (or replaces) its fields as parameters of the given group.
+///
+/// Raises a `TypeError` if a parameter exists and is of a different type.
+///
+/// @tparam T The parameter struct type.
+/// @param cfg The configuration.
+/// @param key Fully qualified name of the parameter group, or an empty
+///   string to store the fields at the root of the configuration.
+/// @param obj The parameter struct.
+template <typename T>
+void Store(Configuration &cfg, std::string_view key, const T &obj) {
+  static_assert(detail::IsConfigStruct<T>::value,
+      "The struct fields must be declared via WZK_CONFIG_STRUCT!");
+  std::string prefix{key};
+  detail::StoreStruct(cfg, prefix, obj);
+}
+}  // namespace werkzeugkiste::config
+
+#endif  // WERKZEUGKISTE_CONFIG_REFLECTION_H
@@ -0,0 +1,119 @@
+#ifndef WERKZEUGKISTE_CONFIG_SCHEMA_H
+#define WERKZEUGKISTE_CONFIG_SCHEMA_H
+
+#include <werkzeugkiste/config/config_export.h>
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/types.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace werkzeugkiste::config {
+//-----------------------------------------------------------------------------
+// Schema validation
+
+/// @brief A parameter which does not satisfy its schema rule.
+struct WERKZEUGKISTE_CONFIG_EXPORT SchemaViolation {
+  /// @brief Fully qualified parameter name.
+  std::string key{};
+
+  /// @brief Description of the violation.
+  std::string message{};
+};
+
+/// @brief Describes the expected parameters of a configuration, *i.e.*
+///   their types, value ranges, list lengths and matrix shapes.
+///
+/// A schema is described by a configuration (*e.g.* a TOML or JSON file),
+/// which holds a list of rules named `parameters`. Each rule must specify
+/// the `key` of the parameter and can specify the following constraints:
+/// * `type`: The expected `ConfigType`, *e.g.* `"integer"` or `"group"`, see
+///   `ConfigTypeToString`. An integer also satisfies `"floating_point"`,
+///   because it can be queried as such.
+/// * `required`: If true, the parameter must exist. Defaults to false.
+/// * `min`, `max`: Inclusive range of a numeric parameter.
+/// * `min_length`, `max_length`: Inclusive range of the length of a list.
+/// * `element_type`: The expected type of all elements of a list.
+/// * `shape`: The number of rows and columns of a matrix, *i.e.* a list of
+///   equally long lists of numbers. A negative dimension matches any size.
+///
+/// The key can refer to all elements of a list via `[*]`, *e.g.*
+/// `cameras[*].fx`.
+///
+/// @code {.toml}
+/// [[parameters]]
+/// key = "camera.fx"
+/// type = "floating_point"
+/// required = true
+/// min = 0.0
+///
+/// [[parameters]]
+/// key = "camera.K"
+/// shape = [3, 3]
+/// @endcode
+///
+/// Upon construction, the rules are compiled into a traversal plan, which
+/// mirrors the parameter hierarchy. Thus, validating a configuration visits
+/// each referenced parameter once, and shared path prefixes (*e.g.*
+/// `camera` above) are looked up only once. A schema is immutable, *i.e.*
+/// copies are cheap and can be used concurrently.
+///
+/// @code {.cpp}
+/// const wkc::Schema schema = wkc::Schema::LoadFile("schema.toml"sv);
+/// schema.Validate(wkc::LoadFile("config.toml"sv));
+/// @endcode
+class WERKZEUGKISTE_CONFIG_EXPORT Schema {
+ public:
+  /// @brief Constructs an empty schema, which accepts any configuration.
+  Schema();
+
+  /// @brief Compiles the schema from its description (see class
+  ///   documentation).
+  ///
+  /// Raises a `ParseError` if the description is invalid, *e.g.* if a rule
+  ///   has no key, an unknown type or an unsupported constraint.
+  ///
+  /// @param description The rules of the schema.
+  static Schema FromConfiguration(const Configuration &description);
+
+  /// @brief Loads the schema description from a file (see `LoadFile`) and
+  ///   compiles it.
+  ///
+  /// Raises a `ParseError` if the file cannot be loaded or if the
+  ///   description is invalid.
+  ///
+  /// @param filename Path to the schema description.
+  static Schema LoadFile(std::string_view filename);
+
+  /// @brief Returns the number of rules.
+  std::size_t NumRules() const;
+
+  /// @brief Checks the configuration and returns all violations, or an
+  ///   empty list if it satisfies the schema.
+  /// @param cfg The configuration to be checked.
+  std::vector<SchemaViolation> Check(const Configuration &cfg) const;
+
+  /// @brief Checks the configuration.
+  ///
+  /// Raises a `ValueError` if the configuration violates the schema. Its
+  ///   message lists all violations, one per line.
+  ///
+  /// @param cfg The configuration to be checked.
+  void Validate(const Configuration &cfg) const;
+
+ private:
+  /// Forward declaration of internal implementation struct.
+  struct Impl;
+
+  /// The compiled (immutable) rules, shared between copies.
+  std::shared_ptr<const Impl> pimpl_;
+
+  explicit Schema(std::shared_ptr<const Impl> impl);
+};
+
+}  // namespace werkzeugkiste::config
+
+#endif  // WERKZEUGKISTE_CONFIG_SCHEMA_H
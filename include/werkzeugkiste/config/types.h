@@ -11,6 +11,7 @@
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <utility>
 
 namespace werkzeugkiste::config {
 //-----------------------------------------------------------------------------
@@ -105,6 +106,103 @@ enum class NullValuePolicy : unsigned char {
   Fail
 };
 
+//-----------------------------------------------------------------------------
+// Non-throwing lookups
+
+/// @brief Reasons why a non-throwing lookup (see `Configuration::TryGet`)
+///   failed.
+enum class LookupError : unsigned char {
+  /// @brief The parameter does not exist, *i.e.* a getter would raise a
+  ///   `KeyError`.
+  KeyNotFound,
+
+  /// @brief The parameter is of a different type, *e.g.* a string instead of
+  ///   a number. A getter would raise a `TypeError`.
+  TypeMismatch,
+
+  /// @brief The numeric parameter (or one of the list elements) cannot be
+  ///   represented exactly by the requested type, *e.g.* 3.5 as an integer.
+  ///   A getter would raise a `TypeError`.
+  NotRepresentable
+};
+
+/// @brief Returns the string representation.
+WERKZEUGKISTE_CONFIG_EXPORT
+std::string LookupErrorToString(const LookupError &error);
+
+/// @brief Prints the string representation of a `LookupError` out to the
+///   stream.
+WERKZEUGKISTE_CONFIG_EXPORT
+std::ostream &operator<<(std::ostream &os, const LookupError &error);
+
+/// @brief Result of a non-throwing lookup, which holds either the parameter
+///   value or the reason why the lookup failed.
+///
+/// @code {.cpp}
+/// const auto result = cfg.TryGet<double>("camera.fx"sv);
+/// if (result) {
+///   use(result.Value());
+/// } else if (result.Error() == wkc::LookupError::TypeMismatch) {
+///   ...
+/// }
+/// @endcode
+///
+/// @tparam Tp Type of the parameter value.
+template <typename Tp>
+class LookupResult {
+ public:
+  /// @brief Constructs a successful result.
+  // NOLINTNEXTLINE(*explicit*)
+  LookupResult(Tp value) : value_{std::move(value)} {}
+
+  /// @brief Constructs a failed result.
+  // NOLINTNEXTLINE(*explicit*)
+  LookupResult(LookupError error) : error_{error} {}
+
+  /// @brief Returns true if the lookup succeeded.
+  bool HasValue() const { return value_.has_value(); }
+
+  /// @brief Returns true if the lookup succeeded.
+  explicit operator bool() const { return HasValue(); }
+
+  /// @brief Returns the parameter value.
+  ///
+  /// Raises a `ValueError` if the lookup failed.
+  const Tp &Value() const & {
+    EnsureValue();
+    return *value_;
+  }
+
+  /// @brief Returns the parameter value.
+  ///
+  /// Raises a `ValueError` if the lookup failed.
+  Tp &&Value() && {
+    EnsureValue();
+    return std::move(*value_);
+  }
+
+  /// @brief Returns the parameter value or the given default value if the
+  ///   lookup failed.
+  Tp ValueOr(Tp default_value) const & {
+    return HasValue() ? *value_ : std::move(default_value);
+  }
+
+  /// @brief Returns the reason why the lookup failed. Must only be called if
+  ///   `HasValue()` is false.
+  LookupError Error() const { return error_; }
+
+ private:
+  std::optional<Tp> value_{};
+  LookupError error_{LookupError::KeyNotFound};
+
+  void EnsureValue() const {
+    if (!value_.has_value()) {
+      throw ValueError{"Cannot access the value of a failed lookup (" +
+                       LookupErrorToString(error_) + ")!"};
+    }
+  }
+};
+
 //-----------------------------------------------------------------------------
 // Date
 
@@ -0,0 +1,132 @@
+#ifndef WERKZEUGKISTE_CONFIG_WATCHER_H
+#define WERKZEUGKISTE_CONFIG_WATCHER_H
+
+#include <werkzeugkiste/config/config_export.h>
+#include <werkzeugkiste/config/configuration.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace werkzeugkiste::config {
+//-----------------------------------------------------------------------------
+// Hot reloading
+
+/// @brief Settings of a `ConfigurationWatcher`.
+struct WERKZEUGKISTE_CONFIG_EXPORT WatcherOptions {
+  /// @brief Parameters which refer to nested configuration files, see
+  ///   `Configuration::LoadNestedConfiguration`. These will be loaded after
+  ///   each (re)load and their files will be watched, too.
+  std::vector<std::string> nested_keys{};
+
+  /// @brief A reload is triggered once the watched files have not been
+  ///   modified for this duration, *i.e.* a burst of writes (*e.g.* an
+  ///   editor saving a file) results in a single reload.
+  std::chrono::milliseconds debounce{100};
+
+  /// @brief Interval to check the files for modifications if file system
+  ///   notifications are not available.
+  std::chrono::milliseconds poll_interval{250};
+
+  /// @brief Always check for modifications via polling, even if file system
+  ///   notifications (inotify on Linux) are available.
+  bool force_polling{false};
+};
+
+/// @brief Watches a configuration file and reloads it in the background
+///   whenever it (or one of its nested configuration files) changes.
+///
+/// The files are watched via inotify on Linux. On other platforms (or if
+/// inotify is not available), the files' modification times are polled.
+/// Loading and parsing happen on a background thread. Each successfully
+/// reloaded configuration is published as a new, immutable snapshot. Thus,
+/// readers never block on I/O or parsing and a snapshot stays valid (and
+/// unchanged) for as long as the reader holds it.
+///
+/// If a reload fails (*e.g.* because the file is being written or contains
+/// a syntax error), the previous snapshot is kept and the error message is
+/// available via `LastError`.
+///
+/// Configuration files larger than `files::MappedFile::kMaxBufferedSize` are
+/// memory-mapped while they are parsed. Such files must be replaced
+/// atomically (*i.e.* written to a new file which is then renamed) instead
+/// of being truncated, see `files::MappedFile`.
+///
+/// @code {.cpp}
+/// wkc::ConfigurationWatcher watcher{"config.toml"sv};
+/// watcher.OnReload([](const wkc::Configuration &cfg,
+///                     const wkc::ConfigurationDiff &diff) {
+///   if (diff.Affects("camera"sv)) { /* Re-initialize camera. */ }
+/// });
+/// // Processing loop:
+/// const auto cfg = watcher.Current();
+/// double value = cfg->GetDouble("section.value"sv);
+/// @endcode
+class WERKZEUGKISTE_CONFIG_EXPORT ConfigurationWatcher {
+ public:
+  /// @brief Function to be notified after a successful reload.
+  ///
+  /// The callback will be invoked on the background thread and receives the
+  /// new configuration, as well as the differences to the previous one.
+  /// Exceptions raised by the callback are caught, and their message is
+  /// available via `LastError`. The new configuration is published anyway.
+  using Callback = std::function<void(const Configuration &cfg,
+      const ConfigurationDiff &diff)>;
+
+  /// @brief Loads the configuration and starts watching it.
+  ///
+  /// Raises a `ParseError` if the initial configuration cannot be loaded,
+  /// see `LoadFile`, or the exceptions of `LoadNestedConfiguration`.
+  ///
+  /// @param filename Path to the configuration file.
+  /// @param options Watcher settings.
+  explicit ConfigurationWatcher(std::string_view filename,
+      WatcherOptions options = WatcherOptions{});
+
+  /// @brief Stops watching, *i.e.* joins the background thread.
+  ~ConfigurationWatcher();
+
+  ConfigurationWatcher(const ConfigurationWatcher &) = delete;
+  ConfigurationWatcher &operator=(const ConfigurationWatcher &) = delete;
+  ConfigurationWatcher(ConfigurationWatcher &&) = delete;
+  ConfigurationWatcher &operator=(ConfigurationWatcher &&) = delete;
+
+  /// @brief Returns the most recently loaded configuration.
+  ///
+  /// Can be called concurrently from any number of threads.
+  std::shared_ptr<const Configuration> Current() const;
+
+  /// @brief Returns the number of published configurations, *i.e.* 1 after
+  ///   construction, increased by each reload which changed a parameter.
+  uint64_t Version() const;
+
+  /// @brief Returns the error message of the most recent reload, or an
+  ///   empty string if it succeeded.
+  std::string LastError() const;
+
+  /// @brief Returns the watched files, *i.e.* the configuration file
+  ///   followed by the nested configuration files.
+  std::vector<std::string> WatchedFiles() const;
+
+  /// @brief Returns true if modifications are detected via polling.
+  bool IsPolling() const;
+
+  /// @brief Registers the callback to be invoked after each reload which
+  ///   changed a parameter. Replaces a previously registered callback.
+  void OnReload(Callback callback);
+
+ private:
+  /// Forward declaration of internal implementation struct.
+  struct Impl;
+
+  /// Pointer to internal implementation.
+  std::unique_ptr<Impl> pimpl_;
+};
+
+}  // namespace werkzeugkiste::config
+
+#endif  // WERKZEUGKISTE_CONFIG_WATCHER_H
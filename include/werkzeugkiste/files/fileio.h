@@ -4,6 +4,7 @@
 #include <werkzeugkiste/files/files_export.h>
 
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -24,6 +25,69 @@ std::vector<std::string> WERKZEUGKISTE_FILES_EXPORT ReadAsciiFile(
 /// @brief Reads the plain text file into a single string.
 std::string WERKZEUGKISTE_FILES_EXPORT CatAsciiFile(std::string_view filename);
 
+/// @brief Read-only, memory-mapped view of a file's content.
+///
+/// In contrast to `CatAsciiFile`, the file content is not copied into a
+/// string, i.e. parsers can work directly on the mapped bytes. The view is
+/// valid until the `MappedFile` is destroyed or moved from.
+///
+/// Files of up to `kMaxBufferedSize` bytes are read into an owned buffer
+/// instead, because mapping them is not faster. On POSIX systems, this also
+/// avoids a hazard of mappings: if another process truncates the file while
+/// it is mapped, accessing the view will raise `SIGBUS`. Thus, larger files
+/// must not be truncated while they are mapped (replace them atomically
+/// instead, *i.e.* write a new file and rename it).
+///
+/// @code {.cpp}
+/// wkf::MappedFile file{"large-file.json"};
+/// std::string_view content = file.View();
+/// @endcode
+class WERKZEUGKISTE_FILES_EXPORT MappedFile {
+ public:
+  /// @brief Files up to this size (in bytes) will be read instead of mapped.
+  static constexpr std::size_t kMaxBufferedSize{1U << 20U};
+
+  /// @brief Maps the given file into memory.
+  ///
+  /// Raises an `IOError` if the file cannot be opened or mapped.
+  explicit MappedFile(std::string_view filename);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /// @brief Returns the file content. Note that the view is not
+  ///   null-terminated.
+  std::string_view View() const { return {data_, size_}; }
+
+  /// @brief Returns the file size in bytes.
+  std::size_t Size() const { return size_; }
+
+  /// @brief Returns true if the file is empty.
+  bool Empty() const { return size_ == 0; }
+
+  /// @brief Returns true if the content is mapped, or false if it has been
+  ///   read into a buffer.
+  bool IsMapped() const { return (data_ != nullptr) && !buffer_; }
+
+ private:
+  /// @brief Releases the mapping (or the buffer).
+  void Unmap() noexcept;
+
+  /// @brief Start of the mapped (or buffered) file content.
+  const char *data_{nullptr};
+
+  /// @brief Number of mapped (or buffered) bytes.
+  std::size_t size_{0};
+
+  /// @brief Content of a small file, see `kMaxBufferedSize`.
+  std::unique_ptr<char[]> buffer_{};
+};
+
 // TODO doc
 // TODO test
 class WERKZEUGKISTE_FILES_EXPORT AsciiFileIterator {
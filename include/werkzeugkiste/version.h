@@ -0,0 +1,28 @@
+#ifndef WERKZEUGKISTE_VERSION_H
+#define WERKZEUGKISTE_VERSION_H
+
+#include <string>
+
+/// @brief ``werkzeugkiste`` is yet another C++ utility library: a collection
+///   of commonly used, reusable C++ snippets.
+namespace werkzeugkiste {
+
+/// @brief The major version, *i.e.* `0`.
+inline constexpr unsigned version_major = 0;
+
+/// @brief The minor version, *i.e.* `19`.
+inline constexpr unsigned version_minor = 19;
+
+/// @brief The patch version, *i.e.* `0`.
+inline constexpr unsigned version_patch = 0;
+
+/// @brief Returns a string representation of the library version, *i.e.* `"0.19.0"`.
+inline constexpr auto Version() {
+  using namespace std::literals;
+  auto version = "0.19.0"sv;
+  return version;
+}
+
+}  // namespace werkzeugkiste
+
+#endif  // WERKZEUGKISTE_VERSION_
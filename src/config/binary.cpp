@@ -0,0 +1,540 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/files/fileio.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "configuration_access.h"
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// Binary snapshot layout (version 1), all values are little-endian:
+///
+///   magic       8 bytes, "WZKCFGB" followed by a null byte
+///   version     uint32
+///   num_strings uint32
+///   strings     num_strings x (uint32 length, length bytes)
+///   root        group content (see below)
+///
+/// Each node starts with its `BinaryTag`, followed by:
+///   Group       uint32 size, size x (uint32 key id, node)
+///   List        uint32 size, size x node
+///   Bool        uint8
+///   Int         int64
+///   Float       float64 (IEEE 754 bit pattern)
+///   String      uint32 string id
+///   Date        uint16 year, uint8 month, uint8 day
+///   Time        uint8 hour, uint8 minute, uint8 second, uint32 nanosecond
+///   DateTime    date, time, uint8 has_offset, int16 offset minutes
+///   *List       uint32 size, size x value (without tags)
+///
+/// Keys and string values are stored once in the string table and referred
+/// to by their index. Homogeneous lists of scalars are stored as contiguous,
+/// untagged arrays.
+constexpr std::array<char, 8> kBinaryMagic{
+    'W', 'Z', 'K', 'C', 'F', 'G', 'B', '\0'};
+constexpr uint32_t kBinaryVersion{1};
+
+/// Limits the recursion depth when decoding (corrupt) snapshots.
+constexpr std::size_t kBinaryMaxDepth{512};
+
+enum class BinaryTag : uint8_t {
+  Group = 0,
+  List,
+  Bool,
+  Int,
+  Float,
+  String,
+  Date,
+  Time,
+  DateTime,
+  BoolList,
+  IntList,
+  FloatList,
+  StringList
+};
+
+/// @brief Encodes a TOML tree in a single walk. The string table can only
+///   be written after the walk, thus the nodes are encoded into a separate
+///   buffer.
+class BinaryWriter {
+ public:
+  void Write(const toml::table &root, std::ostream &out) {
+    body_.clear();
+    EncodeGroupContent(root);
+
+    std::string header{kBinaryMagic.data(), kBinaryMagic.size()};
+    PutUInt(header, kBinaryVersion, 4);
+    PutUInt(header, strings_.size(), 4);
+    for (const auto &str : strings_) {
+      PutUInt(header, str.length(), 4);
+      header += str;
+    }
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(body_.data(), static_cast<std::streamsize>(body_.size()));
+  }
+
+ private:
+  std::string body_{};
+  std::vector<std::string_view> strings_{};
+  std::unordered_map<std::string_view, uint32_t> string_ids_{};
+
+  static void PutUInt(std::string &buffer, uint64_t value, int num_bytes) {
+    for (int i = 0; i < num_bytes; ++i) {
+      buffer += static_cast<char>((value >> (8 * i)) & 0xFFU);
+    }
+  }
+
+  void Put(uint64_t value, int num_bytes) { PutUInt(body_, value, num_bytes); }
+
+  void Put(BinaryTag tag) { Put(static_cast<uint8_t>(tag), 1); }
+
+  void PutSize(std::size_t size) {
+    if (size > std::numeric_limits<uint32_t>::max()) {
+      // LCOV_EXCL_START
+      throw ValueError{
+          "Groups and lists in binary snapshots must not exceed 2^32-1 "
+          "elements!"};
+      // LCOV_EXCL_STOP
+    }
+    Put(size, 4);
+  }
+
+  void PutDouble(double value) {
+    uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    Put(bits, 8);
+  }
+
+  void PutString(std::string_view str) {
+    auto it = string_ids_.find(str);
+    if (it == string_ids_.end()) {
+      if (str.length() > std::numeric_limits<uint32_t>::max()) {
+        // LCOV_EXCL_START
+        throw ValueError{"Strings in binary snapshots must not exceed 4 GB!"};
+        // LCOV_EXCL_STOP
+      }
+      it = string_ids_
+               .emplace(str, static_cast<uint32_t>(strings_.size()))
+               .first;
+      strings_.push_back(str);
+    }
+    Put(it->second, 4);
+  }
+
+  void PutDate(const toml::date &d) {
+    Put(d.year, 2);
+    Put(d.month, 1);
+    Put(d.day, 1);
+  }
+
+  void PutTime(const toml::time &t) {
+    Put(t.hour, 1);
+    Put(t.minute, 1);
+    Put(t.second, 1);
+    Put(t.nanosecond, 4);
+  }
+
+  void EncodeGroupContent(const toml::table &tbl) {
+    PutSize(tbl.size());
+    for (auto &&[key, value] : tbl) {
+      PutString(key.str());
+      EncodeNode(value);
+    }
+  }
+
+  template <typename Tp>
+  void EncodeHomogeneousList(const toml::array &arr) {
+    PutSize(arr.size());
+    for (auto &&value : arr) {
+      if constexpr (std::is_same_v<Tp, bool>) {
+        Put(value.as_boolean()->get() ? 1 : 0, 1);
+      } else if constexpr (std::is_same_v<Tp, int64_t>) {
+        Put(static_cast<uint64_t>(value.as_integer()->get()), 8);
+      } else if constexpr (std::is_same_v<Tp, double>) {
+        PutDouble(value.as_floating_point()->get());
+      } else {
+        PutString(value.as_string()->get());
+      }
+    }
+  }
+
+  void EncodeList(const toml::array &arr) {
+    if (!arr.empty()) {
+      if (arr.is_homogeneous(toml::node_type::integer)) {
+        Put(BinaryTag::IntList);
+        EncodeHomogeneousList<int64_t>(arr);
+        return;
+      }
+      if (arr.is_homogeneous(toml::node_type::floating_point)) {
+        Put(BinaryTag::FloatList);
+        EncodeHomogeneousList<double>(arr);
+        return;
+      }
+      if (arr.is_homogeneous(toml::node_type::boolean)) {
+        Put(BinaryTag::BoolList);
+        EncodeHomogeneousList<bool>(arr);
+        return;
+      }
+      if (arr.is_homogeneous(toml::node_type::string)) {
+        Put(BinaryTag::StringList);
+        EncodeHomogeneousList<std::string>(arr);
+        return;
+      }
+    }
+
+    Put(BinaryTag::List);
+    PutSize(arr.size());
+    for (auto &&value : arr) {
+      EncodeNode(value);
+    }
+  }
+
+  void EncodeNode(const toml::node &node) {
+    switch (node.type()) {
+      case toml::node_type::table:
+        Put(BinaryTag::Group);
+        EncodeGroupContent(*node.as_table());
+        break;
+
+      case toml::node_type::array:
+        EncodeList(*node.as_array());
+        break;
+
+      case toml::node_type::boolean:
+        Put(BinaryTag::Bool);
+        Put(node.as_boolean()->get() ? 1 : 0, 1);
+        break;
+
+      case toml::node_type::integer:
+        Put(BinaryTag::Int);
+        Put(static_cast<uint64_t>(node.as_integer()->get()), 8);
+        break;
+
+      case toml::node_type::floating_point:
+        Put(BinaryTag::Float);
+        PutDouble(node.as_floating_point()->get());
+        break;
+
+      case toml::node_type::string:
+        Put(BinaryTag::String);
+        PutString(node.as_string()->get());
+        break;
+
+      case toml::node_type::date:
+        Put(BinaryTag::Date);
+        PutDate(node.as_date()->get());
+        break;
+
+      case toml::node_type::time:
+        Put(BinaryTag::Time);
+        PutTime(node.as_time()->get());
+        break;
+
+      case toml::node_type::date_time: {
+        const toml::date_time &dt = node.as_date_time()->get();
+        Put(BinaryTag::DateTime);
+        PutDate(dt.date);
+        PutTime(dt.time);
+        Put(dt.offset.has_value() ? 1 : 0, 1);
+        Put(static_cast<uint16_t>(
+                dt.offset.has_value() ? dt.offset->minutes : 0),
+            2);
+        break;
+      }
+
+      // LCOV_EXCL_START
+      case toml::node_type::none:
+        throw std::logic_error{
+            "Invalid TOML node type `none` in binary serialization. Please "
+            "report at https://github.com/snototter/werkzeugkiste/issues"};
+        // LCOV_EXCL_STOP
+    }
+  }
+};
+
+/// @brief Decodes a binary snapshot in a single pass.
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_{data} {}
+
+  toml::table Read() {
+    const std::string_view magic = Take(kBinaryMagic.size());
+    if (magic != std::string_view{kBinaryMagic.data(), kBinaryMagic.size()}) {
+      throw ParseError{"Invalid binary configuration (magic bytes mismatch)!"};
+    }
+
+    const auto version = static_cast<uint32_t>(GetUInt(4));
+    if (version != kBinaryVersion) {
+      std::string msg{"Unsupported binary configuration version "};
+      msg += std::to_string(version);
+      msg += ", expected ";
+      msg += std::to_string(kBinaryVersion);
+      msg += '!';
+      throw ParseError{msg};
+    }
+
+    const std::size_t num_strings = GetSize(4);
+    strings_.reserve(num_strings);
+    for (std::size_t idx = 0; idx < num_strings; ++idx) {
+      strings_.push_back(Take(GetSize(1)));
+    }
+
+    toml::table root = DecodeGroupContent(0);
+    if (pos_ != data_.size()) {
+      throw ParseError{
+          "Invalid binary configuration (trailing data after root group)!"};
+    }
+    return root;
+  }
+
+ private:
+  std::string_view data_;
+  std::size_t pos_{0};
+  std::vector<std::string_view> strings_{};
+
+  [[noreturn]] static void ThrowTruncated() {
+    throw ParseError{"Invalid binary configuration (truncated data)!"};
+  }
+
+  std::string_view Take(std::size_t num_bytes) {
+    if (num_bytes > data_.size() - pos_) {
+      ThrowTruncated();
+    }
+    const std::string_view view = data_.substr(pos_, num_bytes);
+    pos_ += num_bytes;
+    return view;
+  }
+
+  uint64_t GetUInt(int num_bytes) {
+    const std::string_view bytes = Take(static_cast<std::size_t>(num_bytes));
+    uint64_t value{0};
+    for (int i = 0; i < num_bytes; ++i) {
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i]))
+               << (8 * i);
+    }
+    return value;
+  }
+
+  /// Reads a 32-bit size and ensures that the remaining data can hold (at
+  /// least) `min_element_size` bytes per element.
+  std::size_t GetSize(std::size_t min_element_size) {
+    const auto size = static_cast<std::size_t>(GetUInt(4));
+    if (size > (data_.size() - pos_) / min_element_size) {
+      ThrowTruncated();
+    }
+    return size;
+  }
+
+  double GetDouble() {
+    const uint64_t bits = GetUInt(8);
+    double value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string_view GetString() {
+    const auto id = static_cast<std::size_t>(GetUInt(4));
+    if (id >= strings_.size()) {
+      throw ParseError{"Invalid binary configuration (unknown string id)!"};
+    }
+    return strings_[id];
+  }
+
+  toml::date GetDate() {
+    const auto year = static_cast<uint16_t>(GetUInt(2));
+    const auto month = static_cast<uint8_t>(GetUInt(1));
+    const auto day = static_cast<uint8_t>(GetUInt(1));
+    return toml::date{year, month, day};
+  }
+
+  toml::time GetTime() {
+    const auto hour = static_cast<uint8_t>(GetUInt(1));
+    const auto minute = static_cast<uint8_t>(GetUInt(1));
+    const auto second = static_cast<uint8_t>(GetUInt(1));
+    const auto nanosecond = static_cast<uint32_t>(GetUInt(4));
+    return toml::time{hour, minute, second, nanosecond};
+  }
+
+  toml::date_time GetDateTime() {
+    const toml::date d = GetDate();
+    const toml::time t = GetTime();
+    const bool has_offset = GetUInt(1) != 0;
+    const auto minutes = static_cast<int16_t>(GetUInt(2));
+    if (has_offset) {
+      return toml::date_time{d, t, toml::time_offset{0, minutes}};
+    }
+    return toml::date_time{d, t};
+  }
+
+  /// Where to insert a decoded node, i.e. either into a group (with the
+  /// given key) or at the end of a list.
+  struct Parent {
+    toml::table *tbl{nullptr};
+    toml::array *arr{nullptr};
+    std::string_view key{};
+
+    template <typename Tp>
+    void Insert(Tp &&value) const {
+      if (tbl != nullptr) {
+        tbl->insert(key, std::forward<Tp>(value));
+      } else {
+        arr->push_back(std::forward<Tp>(value));
+      }
+    }
+  };
+
+  toml::table DecodeGroupContent(std::size_t depth) {
+    // Each parameter requires at least a key id and a tag.
+    const std::size_t size = GetSize(5);
+    toml::table tbl{};
+    for (std::size_t idx = 0; idx < size; ++idx) {
+      const std::string_view key = GetString();
+      DecodeNode(depth, Parent{&tbl, nullptr, key});
+    }
+    return tbl;
+  }
+
+  template <typename Tp>
+  toml::array DecodeHomogeneousList(std::size_t element_size) {
+    const std::size_t size = GetSize(element_size);
+    toml::array arr{};
+    arr.reserve(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+      if constexpr (std::is_same_v<Tp, bool>) {
+        arr.push_back(GetUInt(1) != 0);
+      } else if constexpr (std::is_same_v<Tp, int64_t>) {
+        arr.push_back(static_cast<int64_t>(GetUInt(8)));
+      } else if constexpr (std::is_same_v<Tp, double>) {
+        arr.push_back(GetDouble());
+      } else {
+        arr.push_back(std::string{GetString()});
+      }
+    }
+    return arr;
+  }
+
+  /// Decodes the next node and inserts it into the given parent.
+  void DecodeNode(std::size_t depth, const Parent &parent) {
+    if (depth >= kBinaryMaxDepth) {
+      throw ParseError{
+          "Invalid binary configuration (exceeds maximum nesting depth)!"};
+    }
+
+    const auto tag = static_cast<BinaryTag>(GetUInt(1));
+    switch (tag) {
+      case BinaryTag::Group:
+        parent.Insert(DecodeGroupContent(depth + 1));
+        break;
+
+      case BinaryTag::List: {
+        // Each element requires at least its tag.
+        const std::size_t size = GetSize(1);
+        toml::array arr{};
+        arr.reserve(size);
+        for (std::size_t idx = 0; idx < size; ++idx) {
+          DecodeNode(depth + 1, Parent{nullptr, &arr, {}});
+        }
+        parent.Insert(std::move(arr));
+        break;
+      }
+
+      case BinaryTag::Bool:
+        parent.Insert(GetUInt(1) != 0);
+        break;
+
+      case BinaryTag::Int:
+        parent.Insert(static_cast<int64_t>(GetUInt(8)));
+        break;
+
+      case BinaryTag::Float:
+        parent.Insert(GetDouble());
+        break;
+
+      case BinaryTag::String:
+        parent.Insert(std::string{GetString()});
+        break;
+
+      case BinaryTag::Date:
+        parent.Insert(GetDate());
+        break;
+
+      case BinaryTag::Time:
+        parent.Insert(GetTime());
+        break;
+
+      case BinaryTag::DateTime:
+        parent.Insert(GetDateTime());
+        break;
+
+      case BinaryTag::BoolList:
+        parent.Insert(DecodeHomogeneousList<bool>(1));
+        break;
+
+      case BinaryTag::IntList:
+        parent.Insert(DecodeHomogeneousList<int64_t>(8));
+        break;
+
+      case BinaryTag::FloatList:
+        parent.Insert(DecodeHomogeneousList<double>(8));
+        break;
+
+      case BinaryTag::StringList:
+        parent.Insert(DecodeHomogeneousList<std::string>(4));
+        break;
+
+      default:
+        throw ParseError{"Invalid binary configuration (unknown node tag)!"};
+    }
+  }
+};
+}  // namespace detail
+
+void Configuration::WriteBinary(std::ostream &out) const {
+  detail::BinaryWriter writer{};
+  writer.Write(detail::ConfigurationAccess::Root(*this), out);
+}
+
+void Configuration::SaveBinary(std::string_view filename) const {
+  std::ofstream ofs{std::string{filename},
+      std::ios::out | std::ios::binary | std::ios::trunc};
+  if (!ofs.is_open()) {
+    std::string msg{"Cannot open file for writing. Check path: \""};
+    msg += filename;
+    msg += "\".";
+    throw files::IOError{msg};
+  }
+  WriteBinary(ofs);
+  if (!ofs.good()) {
+    std::string msg{"Writing binary configuration to \""};
+    msg += filename;
+    msg += "\" failed.";
+    throw files::IOError{msg};
+  }
+}
+
+Configuration Configuration::LoadBinaryBuffer(std::string_view buffer) {
+  detail::BinaryReader reader{buffer};
+  return detail::ConfigurationAccess::FromTable(reader.Read());
+}
+
+Configuration Configuration::LoadBinary(std::string_view filename) {
+  try {
+    const files::MappedFile file{filename};
+    return LoadBinaryBuffer(file.View());
+  } catch (const werkzeugkiste::files::IOError &e) {
+    throw ParseError(e.what());
+  }
+}
+}  // namespace werkzeugkiste::config
@@ -1,8 +1,3 @@
-// NOLINTBEGIN
-#define TOML_ENABLE_FORMATTERS 1
-#include <toml++/toml.h>
-// NOLINTEND
-
 #include <werkzeugkiste/config/casts.h>
 #include <werkzeugkiste/config/configuration.h>
 #include <werkzeugkiste/config/keymatcher.h>
@@ -12,14 +7,31 @@
 #include <werkzeugkiste/logging.h>
 #include <werkzeugkiste/strings/strings.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <exception>
 #include <functional>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include "configuration_access.h"
+#include "content_hash.h"
+#include "file_state.h"
+#include "string_rewriter.h"
+
 namespace werkzeugkiste::config {
 // NOLINTNEXTLINE(*macro-usage)
 #define WZK_CONFIG_LOOKUP_RAISE_PATH_CREATION_ERROR(KEY, PARENT)          \
@@ -49,20 +61,6 @@ namespace werkzeugkiste::config {
   } while (false)
 
 namespace detail {
-/// Returns the "fully qualified TOML path" for the given key and its parent
-/// path. For example, `key = param` & `parent_path = lvl1.lvl2` results
-/// in `lvl1.lvl2.param`.
-inline std::string FullyQualifiedPath(const toml::key &key,
-    std::string_view parent_path) {
-  if (parent_path.length() > 0) {
-    std::string fqn{parent_path};
-    fqn += '.';
-    fqn += key.str();
-    return fqn;
-  }
-  return std::string(key.str());
-}
-
 /// Returns the "fully qualified TOML path" for the given array index.
 /// For example, `path = section1.arr` & `array_index = 3` results
 /// in `section1.arr[3]`.
@@ -75,116 +73,325 @@ inline std::string FullyQualifiedArrayElementPath(std::string_view key,
   return fqn;
 }
 
+/// @brief A fully qualified parameter name which is formatted lazily.
+///
+/// Each segment (a key or an array index) refers to its parent segment, which
+/// must outlive it. Usually, all segments live on the stack of the functions
+/// which iterate the TOML tree. Thus, extending a path doesn't allocate, and
+/// the string representation is only created if it is actually needed, e.g.
+/// for an error message.
+class KeyPath {
+ public:
+  /// @brief Constructs the root segment, i.e. the fully qualified parameter
+  ///   name of the container which will be iterated (may be empty).
+  explicit KeyPath(std::string_view key) : key_{key} {}
+
+  /// @brief Constructs a segment for a named parameter within a table.
+  KeyPath(const KeyPath &parent, std::string_view key)
+      : parent_{&parent}, key_{key} {}
+
+  /// @brief Constructs a segment for an array element.
+  KeyPath(const KeyPath &parent, std::size_t index)
+      : parent_{&parent}, index_{index}, is_index_{true} {}
+
+  KeyPath(const KeyPath &) = delete;
+  KeyPath &operator=(const KeyPath &) = delete;
+  KeyPath(KeyPath &&) = delete;
+  KeyPath &operator=(KeyPath &&) = delete;
+  ~KeyPath() = default;
+
+  /// @brief Appends the fully qualified parameter name to the given string.
+  // NOLINTNEXTLINE(misc-no-recursion)
+  void AppendTo(std::string &str) const {
+    const std::size_t offset = str.length();
+    if (parent_ != nullptr) {
+      parent_->AppendTo(str);
+    }
+
+    if (is_index_) {
+      str += '[';
+      str += std::to_string(index_);
+      str += ']';
+    } else {
+      if (str.length() > offset) {
+        str += '.';
+      }
+      str += key_;
+    }
+  }
+
+  /// @brief Returns the fully qualified parameter name.
+  std::string ToString() const {
+    std::string str{};
+    AppendTo(str);
+    return str;
+  }
+
+  /// @brief Formats the fully qualified parameter name into the given
+  ///   (reusable) buffer.
+  std::string_view Format(std::string &buffer) const {
+    buffer.clear();
+    AppendTo(buffer);
+    return buffer;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, const KeyPath &path) {
+    out << path.ToString();
+    return out;
+  }
+
+ private:
+  const KeyPath *parent_{nullptr};
+  std::string_view key_{};
+  std::size_t index_{0};
+  bool is_index_{false};
+};
+
+/// @brief Returns the string representation of an eagerly or lazily
+///   formatted fully qualified parameter name, e.g. for error messages.
+inline std::string_view KeyString(std::string_view key) { return key; }
+
+inline std::string KeyString(const KeyPath &key) { return key.ToString(); }
+
 // Forward declaration.
-std::vector<std::string> ListTableKeys(const toml::table &tbl,
-    std::string_view path,
+template <typename Visitor>
+void VisitTableKeys(const toml::table &tbl,
+    std::string &path,
     bool include_array_entries,
-    bool recursive);
+    bool recursive,
+    Visitor &visit);
 
-/// Returns all fully qualified paths for named parameters within
-/// the given TOML array.
+/// @brief Invokes `visit(fqn)` for the fully qualified name of each
+///   parameter within the given TOML array (depth-first).
+///
+/// All names are assembled within the single `path` buffer, which holds the
+/// name of the array and will be restored before returning. Thus, the
+/// `std::string_view` passed to the visitor is only valid during the call.
 // NOLINTNEXTLINE(misc-no-recursion)
-std::vector<std::string> ListArrayKeys(const toml::array &arr,
-    std::string_view path,
+template <typename Visitor>
+void VisitArrayKeys(const toml::array &arr,
+    std::string &path,
     bool include_array_entries,
-    bool recursive) {
-  std::vector<std::string> keys;
+    bool recursive,
+    Visitor &visit) {
+  const std::size_t path_length = path.length();
   std::size_t array_index = 0;
   for (auto &&value : arr) {
-    const std::string fqn = FullyQualifiedArrayElementPath(path, array_index);
+    std::array<char, 24> digits{};
+    const auto res = std::to_chars(
+        digits.data(), digits.data() + digits.size(), array_index);
+    path += '[';
+    path.append(digits.data(), res.ptr);
+    path += ']';
     if (include_array_entries) {
-      keys.push_back(fqn);
+      visit(std::string_view{path});
     }
     if (recursive) {
       if (value.is_table()) {
-        const toml::table &tbl = *value.as_table();
-        const auto subkeys =
-            ListTableKeys(tbl, fqn, include_array_entries, recursive);
-        keys.insert(keys.end(), subkeys.begin(), subkeys.end());
+        VisitTableKeys(*value.as_table(),
+            path,
+            include_array_entries,
+            recursive,
+            visit);
       }
       if (value.is_array()) {
-        const toml::array &nested_arr = *value.as_array();
-        const auto subkeys =
-            ListArrayKeys(nested_arr, fqn, include_array_entries, recursive);
-        keys.insert(keys.end(), subkeys.begin(), subkeys.end());
+        VisitArrayKeys(*value.as_array(),
+            path,
+            include_array_entries,
+            recursive,
+            visit);
       }
     }
+    path.resize(path_length);
     ++array_index;
   }
-  return keys;
 }
 
-/// Returns all fully qualified paths for named parameters within
-/// the given TOML table.
+/// @brief Invokes `visit(fqn)` for the fully qualified name of each
+///   parameter within the given TOML table (depth-first).
+///
+/// See `VisitArrayKeys` for the lifetime of the passed names.
 // NOLINTNEXTLINE(misc-no-recursion)
-std::vector<std::string> ListTableKeys(const toml::table &tbl,
-    std::string_view path,
+template <typename Visitor>
+void VisitTableKeys(const toml::table &tbl,
+    std::string &path,
     bool include_array_entries,
-    bool recursive) {
-  std::vector<std::string> keys;
+    bool recursive,
+    Visitor &visit) {
+  const std::size_t path_length = path.length();
   for (auto &&[key, value] : tbl) {
     // Each parameter within a table is a "named parameter", i.e. it has
     // a separate name that should always be included.
-    keys.push_back(FullyQualifiedPath(key, path));
+    if (path_length > 0) {
+      path += '.';
+    }
+    path += key.str();
+    visit(std::string_view{path});
     if (recursive) {
       if (value.is_array()) {
-        const auto subkeys = ListArrayKeys(*value.as_array(),
-            FullyQualifiedPath(key, path),
+        VisitArrayKeys(*value.as_array(),
+            path,
             include_array_entries,
-            recursive);
-        keys.insert(keys.end(), subkeys.begin(), subkeys.end());
+            recursive,
+            visit);
       }
       if (value.is_table()) {
-        const auto subkeys = ListTableKeys(*value.as_table(),
-            FullyQualifiedPath(key, path),
+        VisitTableKeys(*value.as_table(),
+            path,
             include_array_entries,
-            recursive);
-        keys.insert(keys.end(), subkeys.begin(), subkeys.end());
+            recursive,
+            visit);
       }
     }
+    path.resize(path_length);
   }
+}
+
+/// Returns all fully qualified paths for named parameters within
+/// the given TOML table.
+std::vector<std::string> ListTableKeys(const toml::table &tbl,
+    std::string_view path,
+    bool include_array_entries,
+    bool recursive) {
+  std::vector<std::string> keys{};
+  std::string buffer{path};
+  auto collect = [&keys](std::string_view fqn) -> void {
+    keys.emplace_back(fqn);
+  };
+  VisitTableKeys(tbl, buffer, include_array_entries, recursive, collect);
   return keys;
 }
 
-/// @brief Prepares a KeyError with an alternative key suggestion.
-/// @param tbl The configuration root node/table.
+/// @brief Process-wide switch to enable/disable similar key suggestions.
+inline std::atomic<bool> &KeySuggestionsFlag() {
+  static std::atomic<bool> enabled{true};
+  return enabled;
+}
+
+/// @brief A parameter name which is similar to a missing key.
+struct SimilarKey {
+  /// Edit distance to the missing key.
+  std::size_t distance;
+
+  /// Position of the parameter within the (depth-first) list of all
+  /// parameter names, used to report equally similar keys in a stable order.
+  std::size_t rank;
+
+  std::string_view key;
+
+  bool operator<(const SimilarKey &other) const {
+    return (distance < other.distance) ||
+           ((distance == other.distance) && (rank < other.rank));
+  }
+};
+
+/// Maximum edit distance (exclusive) of suggested keys.
+constexpr std::size_t kMaxSuggestionDistance{3};
+
+/// @brief Index of all fully qualified parameter names of a configuration,
+///   which looks up similar keys without comparing against every name.
+///
+/// The names are organized in a BK-tree, i.e. each child of a node is labeled
+/// with its edit distance to the node's name. Due to the triangle inequality,
+/// a query only needs to descend into children whose label differs by less
+/// than the maximum distance from the query's distance to the node's name.
+class SimilarKeyIndex {
+ public:
+  explicit SimilarKeyIndex(const toml::table &tbl)
+      : keys_{ListTableKeys(tbl,
+            std::string_view{},
+            /*include_array_entries=*/true,
+            /*recursive=*/true)} {
+    nodes_.reserve(keys_.size());
+    for (std::size_t rank = 0; rank < keys_.size(); ++rank) {
+      Insert(rank);
+    }
+  }
+
+  /// @brief Returns all names which are less than `kMaxSuggestionDistance`
+  ///   edits away from the given key, sorted by similarity.
+  std::vector<SimilarKey> Find(std::string_view key) const {
+    std::vector<SimilarKey> similar{};
+    if (nodes_.empty()) {
+      return similar;
+    }
+
+    std::vector<std::size_t> stack{0};
+    while (!stack.empty()) {
+      const Node &node = nodes_[stack.back()];
+      stack.pop_back();
+
+      const std::string_view cand = keys_[node.rank];
+      const std::size_t distance = strings::LevenshteinDistance(key, cand);
+      if (distance < kMaxSuggestionDistance) {
+        similar.push_back(SimilarKey{distance, node.rank, cand});
+      }
+
+      for (const auto &[edge, child] : node.children) {
+        if ((edge + kMaxSuggestionDistance > distance) &&
+            (edge < distance + kMaxSuggestionDistance)) {
+          stack.push_back(child);
+        }
+      }
+    }
+    std::sort(similar.begin(), similar.end());
+    return similar;
+  }
+
+ private:
+  struct Node {
+    /// Index into `keys_`.
+    std::size_t rank;
+
+    /// Pairs of <edit distance, node index>.
+    std::vector<std::pair<std::size_t, std::size_t>> children{};
+  };
+
+  std::vector<std::string> keys_;
+  std::vector<Node> nodes_{};
+
+  void Insert(std::size_t rank) {
+    const std::size_t idx = nodes_.size();
+    nodes_.push_back(Node{rank});
+    if (idx == 0) {
+      return;
+    }
+
+    std::size_t parent = 0;
+    while (true) {
+      const std::size_t distance = strings::LevenshteinDistance(
+          keys_[rank], keys_[nodes_[parent].rank]);
+      auto &children = nodes_[parent].children;
+      auto it = std::find_if(children.begin(),
+          children.end(),
+          [distance](const std::pair<std::size_t, std::size_t> &child) {
+            return child.first == distance;
+          });
+      if (it == children.end()) {
+        children.emplace_back(distance, idx);
+        return;
+      }
+      parent = it->second;
+    }
+  }
+};
+
+/// @brief Prepares a KeyError which suggests the most similar keys.
 /// @param key The key which could not be found.
+/// @param similar Candidate keys, sorted by similarity.
 /// @return KeyError instance to be thrown.
-KeyError KeyErrorWithSimilarKeys(const toml::table &tbl, std::string_view key) {
-  constexpr std::size_t max_length_difference{5};
-  constexpr std::size_t max_levenshtein_distance{3};
-
-  using namespace std::string_view_literals;
+inline KeyError KeyErrorWithSuggestions(std::string_view key,
+    const std::vector<SimilarKey> &similar) {
   std::string msg{"Key `"};
   msg += key;
   msg += "` does not exist!";
 
-  const std::vector<std::string> keys = ListTableKeys(
-      tbl, ""sv, /*include_array_entries=*/true, /*recursive=*/true);
-  std::vector<std::pair<std::size_t, std::string_view>> candidates;
-  for (const auto &cand : keys) {
-    // The edit distance can't be less than the length difference between the
-    // two strings. So we can reject unsuitable keys earlier.
-    if (strings::LengthDifference(key, cand) < max_length_difference) {
-      const std::size_t edit_dist = strings::LevenshteinDistance(key, cand);
-      if (edit_dist < max_levenshtein_distance) {
-        candidates.emplace_back(edit_dist, cand);
-      }
-    }
-  }
-  if (!candidates.empty()) {
-    const std::vector<std::size_t> sorted_indices =
-        container::GetSortedIndices(candidates,
-            [](const std::pair<std::size_t, std::string_view> &a,
-                const std::pair<std::size_t, std::string_view> &b) -> bool {
-              return a.first < b.first;
-            });
+  if (!similar.empty()) {
     msg += " Did you mean: `";
     const std::size_t num_to_include =
-        std::min(sorted_indices.size(), static_cast<std::size_t>(3));
+        std::min(similar.size(), static_cast<std::size_t>(3));
     for (std::size_t idx = 0; idx < num_to_include; ++idx) {
-      const auto &cand = candidates[sorted_indices[idx]];
-      msg += cand.second;
+      msg += similar[idx].key;
       if (idx < num_to_include - 1) {
         msg += "`, `";
       }
@@ -195,6 +402,84 @@ KeyError KeyErrorWithSimilarKeys(const toml::table &tbl, std::string_view key) {
   return KeyError{msg};
 }
 
+/// @brief Lazily builds and caches the `SimilarKeyIndex` of a configuration.
+///
+/// Building the index is more expensive than comparing a key against all
+/// parameter names once. Thus, the first failed lookup after a modification
+/// scans all names, and only a repeated failure builds the index.
+///
+/// Must be invalidated whenever the configuration is modified. Concurrent
+/// (const) lookups are safe, they may build the index redundantly, though.
+class SimilarKeyCache {
+ public:
+  SimilarKeyCache() = default;
+
+  SimilarKeyCache(const SimilarKeyCache &other)
+      : index_{std::atomic_load(&other.index_)},
+        misses_{other.misses_.load(std::memory_order_relaxed)} {}
+
+  SimilarKeyCache &operator=(const SimilarKeyCache &other) = delete;
+
+  ~SimilarKeyCache() = default;
+
+  /// @brief Prepares a KeyError with alternative key suggestions.
+  /// @param tbl The configuration root node/table, i.e. the table which
+  ///   must be indexed by this cache.
+  /// @param key The key which could not be found.
+  KeyError MissingKey(const toml::table &tbl, std::string_view key) const {
+    if (!KeySuggestionsFlag().load(std::memory_order_relaxed)) {
+      return KeyErrorWithSuggestions(key, {});
+    }
+
+    std::shared_ptr<const SimilarKeyIndex> index = std::atomic_load(&index_);
+    if (!index) {
+      if (misses_.fetch_add(1, std::memory_order_relaxed) == 0) {
+        return Scan(tbl, key);
+      }
+      index = std::make_shared<const SimilarKeyIndex>(tbl);
+      std::atomic_store(&index_, index);
+    }
+    return KeyErrorWithSuggestions(key, index->Find(key));
+  }
+
+  /// @brief Discards the index. Must be called before the configuration
+  ///   is modified.
+  void Invalidate() {
+    misses_.store(0, std::memory_order_relaxed);
+    if (std::atomic_load(&index_)) {
+      std::atomic_store(&index_, std::shared_ptr<const SimilarKeyIndex>{});
+    }
+  }
+
+ private:
+  mutable std::shared_ptr<const SimilarKeyIndex> index_{};
+
+  /// Number of failed lookups since the last modification.
+  mutable std::atomic<uint32_t> misses_{0};
+
+  /// Compares the key against all parameter names.
+  static KeyError Scan(const toml::table &tbl, std::string_view key) {
+    const std::vector<std::string> keys = ListTableKeys(tbl,
+        std::string_view{},
+        /*include_array_entries=*/true,
+        /*recursive=*/true);
+    std::vector<SimilarKey> similar{};
+    for (std::size_t rank = 0; rank < keys.size(); ++rank) {
+      const std::string_view cand = keys[rank];
+      // The edit distance can't be less than the length difference between
+      // the two strings. So we can reject unsuitable keys earlier.
+      if (strings::LengthDifference(key, cand) < kMaxSuggestionDistance) {
+        const std::size_t distance = strings::LevenshteinDistance(key, cand);
+        if (distance < kMaxSuggestionDistance) {
+          similar.push_back(SimilarKey{distance, rank, cand});
+        }
+      }
+    }
+    std::sort(similar.begin(), similar.end());
+    return KeyErrorWithSuggestions(key, similar);
+  }
+};
+
 /// @brief Visits all child nodes of the given TOML configuration in a
 /// depth-first search style and invokes the function handle for each node.
 /// @param node Container node from which to start the traversal. The initial
@@ -203,17 +488,18 @@ KeyError KeyErrorWithSimilarKeys(const toml::table &tbl, std::string_view key) {
 /// @param path Path identifier/key of the given node. Must be empty for the
 /// root node.
 /// @param visit_func Function handle to be invoked for each node (except for
-/// the initial `node`).
+/// the initial `node`). The fully qualified name of the node is passed as a
+/// `KeyPath`, i.e. it will only be formatted if the function asks for it.
 // NOLINTNEXTLINE(misc-no-recursion)
 void Traverse(toml::node &node,
-    std::string_view path,
-    const std::function<void(toml::node &, std::string_view)> &visit_func) {
+    const KeyPath &path,
+    const std::function<void(toml::node &, const KeyPath &)> &visit_func) {
   // Iterate container nodes (i.e. table and array) and call the given functor
   // for each node.
   if (node.is_table()) {
     toml::table &tbl = *node.as_table();
     for (auto &&[key, value] : tbl) {
-      const std::string fqn = FullyQualifiedPath(key, path);
+      const KeyPath fqn{path, key.str()};
       visit_func(value, fqn);
 
       if (value.is_array() || value.is_table()) {
@@ -224,7 +510,7 @@ void Traverse(toml::node &node,
     toml::array &arr = *node.as_array();
     std::size_t index = 0;
     for (auto &value : arr) {
-      const std::string fqn = FullyQualifiedArrayElementPath(path, index);
+      const KeyPath fqn{path, index};
       visit_func(value, fqn);
 
       if (value.is_array() || value.is_table()) {
@@ -237,7 +523,7 @@ void Traverse(toml::node &node,
     std::string msg{
         "Traverse() can only be invoked with either `table` or "
         "`array` nodes, but `"};
-    msg += path;
+    msg += path.ToString();
     msg += "` is neither!";
     throw std::logic_error{msg};
     // LCOV_EXCL_STOP
@@ -286,8 +572,8 @@ constexpr const char *TomlTypeName() {
 }
 
 /// Utility to print the type name of a toml::node/toml::node_view.
-template <typename NodeView>
-inline const char *TomlTypeName(const NodeView &node, std::string_view key) {
+template <typename NodeView, typename Key>
+inline const char *TomlTypeName(const NodeView &node, const Key &key) {
   switch (node.type()) {
     case toml::node_type::array:
       return TomlTypeName<toml::array>();
@@ -319,7 +605,7 @@ inline const char *TomlTypeName(const NodeView &node, std::string_view key) {
     // LCOV_EXCL_START
     case toml::node_type::none: {
       std::string msg{"Internal node type for parameter `"};
-      msg += key;
+      msg += KeyString(key);
       msg +=
           "` is `none` (not-a-node)! Please report at "
           "https://github.com/snototter/werkzeugkiste/issues";
@@ -330,7 +616,7 @@ inline const char *TomlTypeName(const NodeView &node, std::string_view key) {
   }
   // LCOV_EXCL_START
   std::string msg{"TOML node type for key `"};
-  msg += key;
+  msg += KeyString(key);
   msg +=
       "` is not handled in `TomlTypeName`. This is a werkzeugkiste "
       "implementation error. Please report at "
@@ -375,8 +661,8 @@ bool IsScalar(toml::node_type tp) {
 /// Extracts the value from the toml::node or throws an error if the type
 /// is not correct.
 /// Tries converting numeric types if a lossless cast is feasible.
-template <typename Tcfg, typename NodeView>
-Tcfg ConvertTomlToConfigType(const NodeView &node, std::string_view key) {
+template <typename Tcfg, typename NodeView, typename Key>
+Tcfg ConvertTomlToConfigType(const NodeView &node, const Key &key) {
   if constexpr (std::is_same_v<Tcfg, bool>) {
     if (node.is_boolean()) {
       return static_cast<bool>(*node.as_boolean());
@@ -395,7 +681,7 @@ Tcfg ConvertTomlToConfigType(const NodeView &node, std::string_view key) {
     } catch (const std::domain_error &e) {
       // Re-throw with extended error message.
       std::string msg{"Cannot convert numeric parameter `"};
-      msg += key;
+      msg += KeyString(key);
       msg += "` to `";
       msg += TypeName<Tcfg>();
       msg += "`. ";
@@ -433,7 +719,7 @@ Tcfg ConvertTomlToConfigType(const NodeView &node, std::string_view key) {
   std::string msg{"Cannot query `"};
   msg += TomlTypeName(node, key);
   msg += "` parameter `";
-  msg += key;
+  msg += KeyString(key);
   msg += "` as `";
   msg += TypeName<Tcfg>();
   msg += "`!";
@@ -512,6 +798,7 @@ Ttoml ConvertConfigTypeToToml(const Tcfg &value, std::string_view key) {
 /// returned instead).
 template <typename T, typename DefaultType = T>
 T LookupScalar(const toml::table &tbl,
+    const SimilarKeyCache &similar_keys,
     std::string_view key,
     bool allow_default = false,
     DefaultType default_val = DefaultType{}) {
@@ -520,7 +807,7 @@ T LookupScalar(const toml::table &tbl,
       return T{default_val};
     }
 
-    throw KeyErrorWithSimilarKeys(tbl, key);
+    throw similar_keys.MissingKey(tbl, key);
   }
 
   const auto node = tbl.at_path(key);
@@ -701,21 +988,13 @@ void SetScalar(toml::table &tbl, std::string_view key, Tvalue value) {
   }
 }
 
-/// @brief Internal helper (no sanity check) to create an array (list of
-///   homogeneous elements).
-template <typename Ttoml, typename Tcfg>
-void CreateList(toml::table &tbl,
-    std::string_view key,
-    const std::vector<Tcfg> &vec) {
+/// @brief Internal helper (no sanity check) to insert an array at the given
+///   (not yet existing) key.
+void InsertArray(toml::table &tbl, std::string_view key, toml::array &&arr) {
   const auto path = SplitTomlPath(key);
   EnsureContainerPathExists(tbl, path.first);
   EnsureDottedOrBareKey(path.second);
 
-  toml::array arr{};
-  for (const auto &value : vec) {
-    arr.push_back(ConvertConfigTypeToToml<Ttoml>(value, key));
-  }
-
   toml::table *parent =
       path.first.empty() ? &tbl : tbl.at_path(path.first).as_table();
   if (parent == nullptr) {
@@ -724,7 +1003,7 @@ void CreateList(toml::table &tbl,
     // LCOV_EXCL_STOP
   }
 
-  auto result = parent->insert_or_assign(path.second, arr);
+  auto result = parent->insert_or_assign(path.second, std::move(arr));
   if (!ContainsKey(tbl, key)) {
     // LCOV_EXCL_START
     WZK_CONFIG_LOOKUP_RAISE_ASSIGNMENT_ERROR(
@@ -733,6 +1012,118 @@ void CreateList(toml::table &tbl,
   }
 }
 
+/// @brief Internal helper to insert (or replace) a group, see
+///   `Configuration::SetGroup`.
+/// @tparam Tbl `const toml::table &` or `toml::table &&`.
+template <typename Tbl>
+void InsertGroup(toml::table &tbl, std::string_view key, Tbl &&group) {
+  if (key.empty()) {
+    throw KeyError{
+        "Cannot replace this configuration with a parameter group. Key cannot "
+        "be empty in `SetGroup`!"};
+  }
+
+  if (ContainsKey(tbl, key)) {
+    const auto node = tbl.at_path(key);
+    if (!node.is_table()) {
+      std::string msg{"Cannot insert parameter group at `"};
+      msg += key;
+      msg += "`. Existing parameter is of type `";
+      msg += TomlTypeName(node, key);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+
+    auto &ref = *node.as_table();
+    ref = std::forward<Tbl>(group);
+  } else {
+    const auto path = SplitTomlPath(key);
+    EnsureContainerPathExists(tbl, path.first);
+    toml::table *parent =
+        path.first.empty() ? &tbl : tbl.at_path(path.first).as_table();
+    if (parent == nullptr) {
+      // LCOV_EXCL_START
+      WZK_CONFIG_LOOKUP_RAISE_PATH_CREATION_ERROR(key, path.first);
+      // LCOV_EXCL_STOP
+    }
+
+    auto result =
+        parent->insert_or_assign(path.second, std::forward<Tbl>(group));
+    if (!ContainsKey(tbl, key)) {
+      // LCOV_EXCL_START
+      WZK_CONFIG_LOOKUP_RAISE_ASSIGNMENT_ERROR(
+          key, result.second, path.first, path.second);
+      // LCOV_EXCL_STOP
+    }
+  }
+}
+
+/// @brief Internal helper (no sanity check) to create an array (list of
+///   homogeneous elements).
+template <typename Ttoml, typename Tcfg>
+void CreateList(toml::table &tbl,
+    std::string_view key,
+    const std::vector<Tcfg> &vec) {
+  toml::array arr{};
+  arr.reserve(vec.size());
+  for (const auto &value : vec) {
+    arr.push_back(ConvertConfigTypeToToml<Ttoml>(value, key));
+  }
+  InsertArray(tbl, key, std::move(arr));
+}
+
+/// @brief Returns the TOML node type which holds numbers of type `Ttoml`.
+template <typename Ttoml>
+constexpr toml::node_type NumberNodeType() {
+  static_assert(std::is_same_v<Ttoml, int64_t> || std::is_same_v<Ttoml, double>,
+      "Only int64_t and double are supported!");
+  return std::is_same_v<Ttoml, double> ? toml::node_type::floating_point
+                                       : toml::node_type::integer;
+}
+
+/// @brief Overwrites the value of a number node of type `Ttoml`.
+template <typename Ttoml>
+void SetNumber(toml::node &node, Ttoml value) {
+  if constexpr (std::is_same_v<Ttoml, double>) {
+    *node.as_floating_point() = value;
+  } else {
+    *node.as_integer() = value;
+  }
+}
+
+/// @brief Overwrites the elements of a homogeneous list of `Ttoml` numbers
+///   in place, *i.e.* without allocating new nodes.
+///
+/// This is only possible if the list holds exactly as many elements as the
+/// replacement vector. If a value cannot be converted, a `TypeError` is
+/// raised before the list is modified.
+///
+/// @return False if the list could not be overwritten in place.
+template <typename Ttoml, typename Tcfg>
+bool OverwriteNumberList(toml::array &arr,
+    std::string_view key,
+    const std::vector<Tcfg> &vec) {
+  if (arr.size() != vec.size()) {
+    return false;
+  }
+
+  if constexpr (std::is_same_v<Ttoml, Tcfg>) {
+    for (std::size_t idx = 0; idx < vec.size(); ++idx) {
+      SetNumber<Ttoml>(arr[idx], vec[idx]);
+    }
+  } else {
+    std::vector<Ttoml> converted{};
+    converted.reserve(vec.size());
+    for (const auto &value : vec) {
+      converted.push_back(ConvertConfigTypeToToml<Ttoml>(value, key));
+    }
+    for (std::size_t idx = 0; idx < converted.size(); ++idx) {
+      SetNumber<Ttoml>(arr[idx], converted[idx]);
+    }
+  }
+  return true;
+}
+
 /// @brief Internal helper for `ReplaceList`. Sanity checks are omitted on
 ///   purpose (they're part of `SetList > ReplaceList`).
 /// @tparam Ttoml Element type of existing TOML array.
@@ -745,10 +1136,11 @@ void ReplaceHomogeneousList(toml::array &arr,
     std::string_view key,
     const std::vector<Tcfg> &vec) {
   toml::array toml_arr{};
+  toml_arr.reserve(vec.size());
   for (const auto &value : vec) {
     toml_arr.push_back(ConvertConfigTypeToToml<Ttoml>(value, key));
   }
-  arr = toml_arr;
+  arr = std::move(toml_arr);
 }
 
 /// @brief Returns true if all elements of this TOML array are either integer
@@ -808,9 +1200,15 @@ void ReplaceList(toml::table &tbl,
   } else if (arr[0].is_boolean()) {
     ReplaceHomogeneousList<bool>(arr, key, vec);
   } else if (arr[0].is_integer()) {
-    ReplaceHomogeneousList<int64_t>(arr, key, vec);
+    // Each element of a TOML array is a separately allocated node. Thus, we
+    // reuse the existing nodes if the list of numbers keeps its length.
+    if (!OverwriteNumberList<int64_t>(arr, key, vec)) {
+      ReplaceHomogeneousList<int64_t>(arr, key, vec);
+    }
   } else if (arr[0].is_floating_point()) {
-    ReplaceHomogeneousList<double>(arr, key, vec);
+    if (!OverwriteNumberList<double>(arr, key, vec)) {
+      ReplaceHomogeneousList<double>(arr, key, vec);
+    }
   } else if (arr[0].is_string()) {
     ReplaceHomogeneousList<std::string>(arr, key, vec);
   } else if (arr[0].is_date()) {
@@ -844,9 +1242,11 @@ void SetList(toml::table &tbl,
   }
 }
 
-toml::array *GetExistingList(toml::table &tbl, std::string_view key) {
+toml::array *GetExistingList(toml::table &tbl,
+    const SimilarKeyCache &similar_keys,
+    std::string_view key) {
   if (!ContainsKey(tbl, key)) {
-    throw KeyErrorWithSimilarKeys(tbl, key);
+    throw similar_keys.MissingKey(tbl, key);
   }
 
   auto node = tbl.at_path(key);
@@ -864,15 +1264,16 @@ toml::array *GetExistingList(toml::table &tbl, std::string_view key) {
 
 template <typename Ttoml, typename Tcfg>
 void AppendScalarListElement(toml::table &tbl,
+    const SimilarKeyCache &similar_keys,
     std::string_view key,
     Tcfg value) {
-  toml::array *arr = GetExistingList(tbl, key);
+  toml::array *arr = GetExistingList(tbl, similar_keys, key);
   arr->push_back(ConvertConfigTypeToToml<Ttoml>(value, key));
 }
 
 /// @brief Extracts a single pointXd from the given toml::table.
 template <typename Pt>
-inline Pt ConvertTableToPoint(const toml::table &tbl, std::string_view key) {
+inline Pt ConvertTableToPoint(const toml::table &tbl, const KeyPath &key) {
   using namespace std::string_view_literals;
   constexpr std::array<std::string_view, 3> point_keys{"x"sv, "y"sv, "z"sv};
   static_assert(Pt::ndim <= point_keys.size(),
@@ -904,7 +1305,7 @@ inline Pt ConvertTableToPoint(const toml::table &tbl, std::string_view key) {
 
 /// @brief Extracts a single pointXd from the given toml::table.
 template <typename Pt>
-inline Pt ConvertArrayToPoint(const toml::array &arr, std::string_view key) {
+inline Pt ConvertArrayToPoint(const toml::array &arr, const KeyPath &key) {
   using CoordType = typename Pt::value_type;
 
   // The array must have at least Dim entries - more are also allowed, as
@@ -918,7 +1319,7 @@ inline Pt ConvertArrayToPoint(const toml::array &arr, std::string_view key) {
 
   std::array<CoordType, Pt::ndim> values{};
   for (std::size_t idx = 0; idx < Pt::ndim; ++idx) {
-    const auto fqn = FullyQualifiedArrayElementPath(key, idx);
+    const KeyPath fqn{key, idx};
     values[idx] = ConvertTomlToConfigType<CoordType>(arr[idx], fqn);
   }
 
@@ -932,21 +1333,24 @@ inline Pt ConvertArrayToPoint(const toml::array &arr, std::string_view key) {
 }
 
 template <typename Pt>
-Pt GetPoint(const toml::table &tbl, std::string_view key) {
+Pt GetPoint(const toml::table &tbl,
+    const SimilarKeyCache &similar_keys,
+    std::string_view key) {
   static_assert(std::is_arithmetic_v<typename Pt::value_type>);
   static_assert(Pt::ndim == 2 || Pt::ndim == 3);
   if (!ContainsKey(tbl, key)) {
-    throw KeyErrorWithSimilarKeys(tbl, key);
+    throw similar_keys.MissingKey(tbl, key);
   }
 
   const auto node = tbl.at_path(key);
+  const KeyPath path{key};
   if (node.is_array()) {
     const auto &pt = *node.as_array();
-    return ConvertArrayToPoint<Pt>(pt, key);
+    return ConvertArrayToPoint<Pt>(pt, path);
   }
   if (node.is_table()) {
     const auto &pt = *node.as_table();
-    return ConvertTableToPoint<Pt>(pt, key);
+    return ConvertTableToPoint<Pt>(pt, path);
   }
 
   std::string msg{"Cannot convert `"};
@@ -960,11 +1364,13 @@ Pt GetPoint(const toml::table &tbl, std::string_view key) {
 }
 
 template <typename Pt>
-std::vector<Pt> GetPoints(const toml::table &tbl, std::string_view key) {
+std::vector<Pt> GetPoints(const toml::table &tbl,
+    const SimilarKeyCache &similar_keys,
+    std::string_view key) {
   static_assert(std::is_arithmetic_v<typename Pt::value_type>);
   static_assert(Pt::ndim == 2 || Pt::ndim == 3);
   if (!ContainsKey(tbl, key)) {
-    throw KeyErrorWithSimilarKeys(tbl, key);
+    throw similar_keys.MissingKey(tbl, key);
   }
 
   const auto node = tbl.at_path(key);
@@ -978,10 +1384,12 @@ std::vector<Pt> GetPoints(const toml::table &tbl, std::string_view key) {
   }
 
   const toml::array &arr = *node.as_array();
+  const KeyPath path{key};
   std::size_t arr_index = 0;
   std::vector<Pt> points;
+  points.reserve(arr.size());
   for (auto &&value : arr) {
-    const auto fqn = FullyQualifiedArrayElementPath(key, arr_index);
+    const KeyPath fqn{path, arr_index};
     if (value.is_array()) {
       const auto &pt = *value.as_array();
       points.push_back(ConvertArrayToPoint<Pt>(pt, fqn));
@@ -992,7 +1400,7 @@ std::vector<Pt> GetPoints(const toml::table &tbl, std::string_view key) {
       std::string msg{
           "Invalid point list. All parameter entries must be either arrays or "
           "tables, but `"};
-      msg += fqn;
+      msg += fqn.ToString();
       msg += "` is not!";
       throw TypeError{msg};
     }
@@ -1003,10 +1411,12 @@ std::vector<Pt> GetPoints(const toml::table &tbl, std::string_view key) {
 
 template <typename Tcfg>
 std::vector<Tcfg> GetList(const toml::array &arr, std::string_view key) {
+  const KeyPath path{key};
   std::size_t arr_index = 0;
   std::vector<Tcfg> scalars{};
+  scalars.reserve(arr.size());
   for (auto &&value : arr) {
-    const auto fqn = FullyQualifiedArrayElementPath(key, arr_index);
+    const KeyPath fqn{path, arr_index};
     if (value.is_value()) {
       scalars.push_back(ConvertTomlToConfigType<Tcfg>(value, fqn));
     } else {
@@ -1015,7 +1425,7 @@ std::vector<Tcfg> GetList(const toml::array &arr, std::string_view key) {
       msg += "`: All entries must be of scalar type `";
       msg += TypeName<Tcfg>();
       msg += "`, but `";
-      msg += fqn;
+      msg += fqn.ToString();
       msg += "` is `";
       msg += TomlTypeName(value, fqn);
       msg += "`!";
@@ -1039,8 +1449,9 @@ Matrix<Tp> GetMatrix(const toml::array &lst, std::string_view key) {
   const std::size_t num_cols{is_2d ? lst[0].as_array()->size() : 1};
 
   Matrix<Tp> mat(num_rows, num_cols);
+  const KeyPath path{key};
   for (std::size_t idx_lst = 0; idx_lst < num_rows; ++idx_lst) {
-    const std::string row_key = FullyQualifiedArrayElementPath(key, idx_lst);
+    const KeyPath row_key{path, idx_lst};
     // Eigen requires signed indices
     const int row = static_cast<int>(idx_lst);
 
@@ -1050,7 +1461,7 @@ Matrix<Tp> GetMatrix(const toml::array &lst, std::string_view key) {
       // length.
       if (!lst[idx_lst].is_array()) {
         std::string msg{"Cannot extract 2D matrix, because value at `"};
-        msg += row_key + "` is not a list, but a `" +
+        msg += row_key.ToString() + "` is not a list, but a `" +
                TomlTypeName(lst[idx_lst], row_key) + "`!";
         throw TypeError{msg};
       }
@@ -1061,15 +1472,14 @@ Matrix<Tp> GetMatrix(const toml::array &lst, std::string_view key) {
       if (nested_size != num_cols) {
         std::string msg{"Cannot extract 2D matrix of size "};
         msg += std::to_string(num_rows) + 'x' + std::to_string(num_cols) +
-               ", because list at `" + row_key + "` contains " +
+               ", because list at `" + row_key.ToString() + "` contains " +
                std::to_string(nested_size) + " elements!";
         throw TypeError{msg};
       }
 
       for (std::size_t idx_nested = 0; idx_nested < num_cols; ++idx_nested) {
         const int col = static_cast<int>(idx_nested);
-        const std::string col_key =
-            FullyQualifiedArrayElementPath(row_key, idx_nested);
+        const KeyPath col_key{row_key, idx_nested};
         mat(row, col) =
             ConvertTomlToConfigType<Tp>(nested_lst[idx_nested], col_key);
       }
@@ -1081,61 +1491,446 @@ Matrix<Tp> GetMatrix(const toml::array &lst, std::string_view key) {
   return mat;
 }
 
-}  // namespace detail
+/// @brief Copies a list of numbers into the given buffer.
+///
+/// The element types are checked only once for the whole list: if all
+/// elements are floating point values, they are copied without per-element
+/// conversion checks. Otherwise, each element is converted separately, which
+/// raises a `TypeError` if an element is not a number or cannot be exactly
+/// represented as a double.
+///
+/// @param arr The list, must not be longer than the buffer.
+/// @param path Fully qualified parameter name of the list.
+/// @param data Pointer to the first element of the output buffer.
+/// @param stride Offset between two consecutive output elements.
+void CopyDoubleList(const toml::array &arr,
+    const KeyPath &path,
+    double *data,
+    Eigen::Index stride) {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const std::size_t num_elements = arr.size();
+  if (arr.is_homogeneous(toml::node_type::floating_point)) {
+    for (std::size_t idx = 0; idx < num_elements; ++idx) {
+      data[static_cast<Eigen::Index>(idx) * stride] =
+          arr[idx].as_floating_point()->get();
+    }
+    return;
+  }
 
-// Abusing the PImpl idiom to hide the internally used TOML table.
-struct Configuration::Impl {
-  toml::table config_root{};
+  for (std::size_t idx = 0; idx < num_elements; ++idx) {
+    const KeyPath fqn{path, idx};
+    data[static_cast<Eigen::Index>(idx) * stride] =
+        ConvertTomlToConfigType<double>(arr[idx], fqn);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
 
-  const toml::table &ImmutableTable(std::string_view key) const {
-    if (key.empty()) {
-      return config_root;
-    }
+/// @brief Loads a list/nested list into the given, correctly sized matrix.
+void GetMatrixInto(const toml::array &lst,
+    std::string_view key,
+    Eigen::Ref<Matrix<double>> &mat) {
+  const bool is_2d = !lst.empty() && lst[0].is_array();
+  const std::size_t num_rows{lst.size()};
+  std::size_t num_cols{0};
+  if (!lst.empty()) {
+    num_cols = is_2d ? lst[0].as_array()->size() : 1;
+  }
+
+  if ((static_cast<Eigen::Index>(num_rows) != mat.rows()) ||
+      (static_cast<Eigen::Index>(num_cols) != mat.cols())) {
+    std::string msg{"Cannot load parameter `"};
+    msg += key;
+    msg += "` as " + std::to_string(num_rows) + 'x' +
+           std::to_string(num_cols) + " matrix into a matrix of size " +
+           std::to_string(mat.rows()) + 'x' + std::to_string(mat.cols()) +
+           '!';
+    throw ValueError{msg};
+  }
 
-    if (!detail::ContainsKey(config_root, key)) {
-      throw detail::KeyErrorWithSimilarKeys(config_root, key);
+  const KeyPath path{key};
+  if (!is_2d) {
+    // A single list is loaded as column vector.
+    CopyDoubleList(lst, path, mat.data(), mat.outerStride());
+    return;
+  }
+
+  for (std::size_t idx_lst = 0; idx_lst < num_rows; ++idx_lst) {
+    const KeyPath row_key{path, idx_lst};
+    if (!lst[idx_lst].is_array()) {
+      std::string msg{"Cannot extract 2D matrix, because value at `"};
+      msg += row_key.ToString() + "` is not a list, but a `" +
+             TomlTypeName(lst[idx_lst], row_key) + "`!";
+      throw TypeError{msg};
     }
 
-    const auto &node = config_root.at_path(key);
-    if (!node.is_table()) {
-      std::string msg{"Cannot lookup parameter `"};
-      msg += key;
-      msg += "` as group, because it is a `";
-      msg += detail::TomlTypeName(node, key);
-      msg += "`!";
+    const toml::array &nested_lst = *lst[idx_lst].as_array();
+    if (nested_lst.size() != num_cols) {
+      std::string msg{"Cannot extract 2D matrix of size "};
+      msg += std::to_string(num_rows) + 'x' + std::to_string(num_cols) +
+             ", because list at `" + row_key.ToString() + "` contains " +
+             std::to_string(nested_lst.size()) + " elements!";
       throw TypeError{msg};
     }
-    return *node.as_table();
+
+    CopyDoubleList(nested_lst,
+        row_key,
+        mat.row(static_cast<Eigen::Index>(idx_lst)).data(),
+        mat.innerStride());
   }
+}
 
-  toml::table &MutableTable(std::string_view key) {
-    if (key.empty()) {
-      return config_root;
+/// @brief Converts a matrix into a (nested) TOML array.
+///
+/// Nx1 or 1xN matrices (i.e. column or row vectors) result in a single
+/// list. RxC matrices result in nested lists.
+template <typename Tp>
+toml::array MatrixToArray(const Eigen::Ref<const Matrix<Tp>> &mat) {
+  const bool single_list = (mat.rows() == 1) || (mat.cols() == 1);
+  toml::array arr{};
+  if (single_list) {
+    arr.reserve(static_cast<std::size_t>(mat.size()));
+    for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+      for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+        arr.push_back(mat(row, col));
+      }
     }
+    return arr;
+  }
 
-    if (!detail::ContainsKey(config_root, key)) {
-      throw detail::KeyErrorWithSimilarKeys(config_root, key);
+  arr.reserve(static_cast<std::size_t>(mat.rows()));
+  for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+    toml::array nested{};
+    nested.reserve(static_cast<std::size_t>(mat.cols()));
+    for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+      nested.push_back(mat(row, col));
     }
+    arr.push_back(std::move(nested));
+  }
+  return arr;
+}
 
-    auto node = config_root.at_path(key);
-    if (!node.is_table()) {
-      std::string msg{"Cannot lookup parameter `"};
-      msg += key;
-      msg += "` as group, because it is a `";
-      msg += detail::TomlTypeName(node, key);
-      msg += "`!";
-      throw TypeError{msg};
+/// @brief Overwrites a (nested) list of numbers with the matrix values in
+///   place, *i.e.* without allocating new nodes, see `MatrixToArray`.
+///
+/// @return False if the list does not have the same shape as the matrix or
+///   holds elements of a different type. Then, the list is not modified.
+template <typename Tp>
+bool OverwriteMatrix(toml::array &arr,
+    const Eigen::Ref<const Matrix<Tp>> &mat) {
+  constexpr toml::node_type expected = NumberNodeType<Tp>();
+  const bool single_list = (mat.rows() == 1) || (mat.cols() == 1);
+  if (single_list) {
+    if ((arr.size() != static_cast<std::size_t>(mat.size())) ||
+        !arr.is_homogeneous(expected)) {
+      return false;
     }
-    return *node.as_table();
-  }
 
-  const toml::array &ImmutableList(std::string_view key) const {
-    if (!detail::ContainsKey(config_root, key)) {
-      throw detail::KeyErrorWithSimilarKeys(config_root, key);
+    std::size_t idx = 0;
+    for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+      for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+        SetNumber<Tp>(arr[idx++], mat(row, col));
+      }
     }
+    return true;
+  }
 
-    const auto &node = config_root.at_path(key);
-    if (!node.is_array()) {
+  if (arr.size() != static_cast<std::size_t>(mat.rows())) {
+    return false;
+  }
+  for (auto &&nested : arr) {
+    if (!nested.is_array() ||
+        (nested.as_array()->size() != static_cast<std::size_t>(mat.cols())) ||
+        !nested.as_array()->is_homogeneous(expected)) {
+      return false;
+    }
+  }
+
+  for (Eigen::Index row = 0; row < mat.rows(); ++row) {
+    toml::array &nested = *arr[static_cast<std::size_t>(row)].as_array();
+    for (Eigen::Index col = 0; col < mat.cols(); ++col) {
+      SetNumber<Tp>(nested[static_cast<std::size_t>(col)], mat(row, col));
+    }
+  }
+  return true;
+}
+
+/// @brief Returns a process-wide unique stamp to identify the structural state
+///   of a configuration (see `Configuration::KeyHandle`).
+inline uint64_t NextGeneration() {
+  static std::atomic<uint64_t> counter{0};
+  return ++counter;
+}
+
+/// @brief Type trait to check for `std::vector`.
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T>
+struct IsVector<std::vector<T>> : std::true_type {};
+
+/// @brief Returns the value of the node as the given scalar or list type.
+template <typename Tp>
+Tp ConvertNode(const toml::node &node, std::string_view key) {
+  if constexpr (IsVector<Tp>::value) {
+    if (!node.is_array()) {
+      std::string msg{"Cannot lookup parameter `"};
+      msg += key;
+      msg += "` as list, because it is a `";
+      msg += TomlTypeName(node, key);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+    return GetList<typename Tp::value_type>(*node.as_array(), key);
+  } else {
+    return ConvertTomlToConfigType<Tp>(node, key);
+  }
+}
+
+/// @brief Non-throwing counterpart of `ConvertTomlToConfigType` for scalars.
+template <typename Tcfg>
+LookupResult<Tcfg> TryConvertScalar(const toml::node &node) {
+  if constexpr (std::is_same_v<Tcfg, bool>) {
+    if (node.is_boolean()) {
+      return node.as_boolean()->get();
+    }
+  } else if constexpr (std::is_arithmetic_v<Tcfg>) {
+    std::optional<Tcfg> value{};
+    if (node.is_integer()) {
+      value = numcast<Tcfg, int64_t>(node.as_integer()->get(),
+          /*may_throw=*/false);
+    } else if (node.is_floating_point()) {
+      value = numcast<Tcfg, double>(node.as_floating_point()->get(),
+          /*may_throw=*/false);
+    } else {
+      return LookupError::TypeMismatch;
+    }
+    if (!value.has_value()) {
+      return LookupError::NotRepresentable;
+    }
+    return *value;
+  } else if constexpr (std::is_same_v<Tcfg, std::string> ||
+                       std::is_same_v<Tcfg, date> ||
+                       std::is_same_v<Tcfg, time> ||
+                       std::is_same_v<Tcfg, date_time>) {
+    // The conversion of these types cannot fail once the node type matches.
+    constexpr toml::node_type expected =
+        std::is_same_v<Tcfg, std::string> ? toml::node_type::string
+        : std::is_same_v<Tcfg, date>      ? toml::node_type::date
+        : std::is_same_v<Tcfg, time>      ? toml::node_type::time
+                                          : toml::node_type::date_time;
+    if (node.type() == expected) {
+      return ConvertTomlToConfigType<Tcfg>(node, std::string_view{});
+    }
+  }
+  return LookupError::TypeMismatch;
+}
+
+/// @brief Non-throwing counterpart of `ConvertNode`.
+template <typename Tp>
+LookupResult<Tp> TryConvertNode(const toml::node &node) {
+  if constexpr (IsVector<Tp>::value) {
+    const toml::array *arr = node.as_array();
+    if (arr == nullptr) {
+      return LookupError::TypeMismatch;
+    }
+
+    Tp values{};
+    values.reserve(arr->size());
+    for (const auto &element : *arr) {
+      auto value = TryConvertScalar<typename Tp::value_type>(element);
+      if (!value) {
+        return value.Error();
+      }
+      values.push_back(std::move(value).Value());
+    }
+    return values;
+  } else {
+    return TryConvertScalar<Tp>(node);
+  }
+}
+}  // namespace detail
+
+// Abusing the PImpl idiom to hide the internally used TOML table.
+struct Configuration::Impl {
+  /// The parameter tree. Copies of a configuration and its groups (see
+  /// `GetGroup`) share the same tree until one of them is modified, i.e.
+  /// the tree must not be changed while it is shared (copy-on-write).
+  std::shared_ptr<toml::table> tree{std::make_shared<toml::table>()};
+
+  /// The root of this configuration, i.e. either `tree` itself or one of
+  /// its groups.
+  const toml::table *root{tree.get()};
+
+  /// Changes whenever nodes of `root` may have been destroyed or replaced,
+  /// i.e. whenever node pointers cached by a `KeyHandle` may have become
+  /// invalid. Inserting nodes does not affect existing nodes, and thus,
+  /// does not require a new generation.
+  uint64_t generation{detail::NextGeneration()};
+
+  /// Index of the parameter names of `root` to suggest similar keys.
+  detail::SimilarKeyCache similar_keys{};
+
+  /// Memoized content hashes of the groups of `tree`, shared by all
+  /// configurations which share the tree.
+  std::shared_ptr<detail::HashCache> hashes{
+      std::make_shared<detail::HashCache>()};
+
+  Impl() = default;
+
+  Impl(const Impl &other)
+      : tree{other.tree},
+        root{other.root},
+        similar_keys{other.similar_keys},
+        hashes{other.hashes} {}
+
+  /// Creates a configuration which shares the given group of `shared_tree`.
+  Impl(std::shared_ptr<toml::table> shared_tree,
+      const toml::table *group,
+      std::shared_ptr<detail::HashCache> shared_hashes)
+      : tree{std::move(shared_tree)},
+        root{group},
+        hashes{std::move(shared_hashes)} {}
+
+  Impl &operator=(const Impl &other) = delete;
+
+  ~Impl() = default;
+
+  /// Must be called after nodes have been erased or replaced.
+  void BumpGeneration() { generation = detail::NextGeneration(); }
+
+  /// Returns the root group for read-only access.
+  const toml::table &Root() const { return *root; }
+
+  /// Returns a KeyError which suggests similar keys.
+  KeyError MissingKey(std::string_view key) const {
+    return similar_keys.MissingKey(Root(), key);
+  }
+
+  /// Returns the root group for modification. If the tree is shared with
+  /// other configurations, this configuration's (sub)tree will be copied
+  /// first.
+  toml::table &MutableRoot() {
+    toml::table &tbl = Detach();
+    hashes->Clear();
+    return tbl;
+  }
+
+  /// Returns the root group to modify the given parameter (or its
+  /// subtree). Same as `MutableRoot()`, but only the memoized hashes of
+  /// the affected groups are invalidated.
+  toml::table &MutableRoot(std::string_view key) {
+    toml::table &tbl = Detach();
+    hashes->Invalidate(tbl, key);
+    return tbl;
+  }
+
+  /// Replaces the parameter tree.
+  void Reset(toml::table &&tbl) {
+    similar_keys.Invalidate();
+    tree = std::make_shared<toml::table>(std::move(tbl));
+    root = tree.get();
+    hashes = std::make_shared<detail::HashCache>();
+    BumpGeneration();
+  }
+
+  /// Returns the node referred to by the handle or nullptr if it does not
+  /// exist.
+  const toml::node *Resolve(const KeyHandle &handle) const {
+    if (handle.generation_ == generation) {
+      return static_cast<const toml::node *>(handle.node_);
+    }
+
+    const toml::node *node = &Root();
+    for (const auto &segment : handle.segments_) {
+      node = Step(*node, handle.key_, segment);
+      if (node == nullptr) {
+        return nullptr;
+      }
+    }
+
+    handle.node_ = node;
+    handle.generation_ = generation;
+    return node;
+  }
+
+  /// Returns the child of the node which is referred to by the given path
+  /// component of `key`, or nullptr if it does not exist.
+  static const toml::node *Step(const toml::node &node,
+      std::string_view key,
+      const KeyHandle::Segment &segment) {
+    if (segment.is_index) {
+      const toml::array *arr = node.as_array();
+      return (arr != nullptr) ? arr->get(segment.index) : nullptr;
+    }
+
+    const toml::table *tbl = node.as_table();
+    return (tbl != nullptr)
+               ? tbl->get(key.substr(segment.offset, segment.length))
+               : nullptr;
+  }
+
+  /// Checks if the path components (of the given parameter names) are equal.
+  static bool SameSegment(std::string_view lhs_key,
+      const KeyHandle::Segment &lhs,
+      std::string_view rhs_key,
+      const KeyHandle::Segment &rhs) {
+    if (lhs.is_index || rhs.is_index) {
+      return (lhs.is_index == rhs.is_index) && (lhs.index == rhs.index);
+    }
+    return lhs_key.substr(lhs.offset, lhs.length) ==
+           rhs_key.substr(rhs.offset, rhs.length);
+  }
+
+  const toml::table &ImmutableTable(std::string_view key) const {
+    if (key.empty()) {
+      return Root();
+    }
+
+    if (!detail::ContainsKey(Root(), key)) {
+      throw MissingKey(key);
+    }
+
+    const auto &node = Root().at_path(key);
+    if (!node.is_table()) {
+      std::string msg{"Cannot lookup parameter `"};
+      msg += key;
+      msg += "` as group, because it is a `";
+      msg += detail::TomlTypeName(node, key);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+    return *node.as_table();
+  }
+
+  toml::table &MutableTable(std::string_view key) {
+    if (key.empty()) {
+      return MutableRoot();
+    }
+
+    toml::table &tbl = MutableRoot(key);
+    if (!detail::ContainsKey(tbl, key)) {
+      throw MissingKey(key);
+    }
+
+    auto node = tbl.at_path(key);
+    if (!node.is_table()) {
+      std::string msg{"Cannot lookup parameter `"};
+      msg += key;
+      msg += "` as group, because it is a `";
+      msg += detail::TomlTypeName(node, key);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+    return *node.as_table();
+  }
+
+  const toml::array &ImmutableList(std::string_view key) const {
+    if (!detail::ContainsKey(Root(), key)) {
+      throw MissingKey(key);
+    }
+
+    const auto &node = Root().at_path(key);
+    if (!node.is_array()) {
       std::string msg{"Cannot lookup parameter `"};
       msg += key;
       msg += "` as list, because it is a `";
@@ -1145,8 +1940,38 @@ struct Configuration::Impl {
     }
     return *node.as_array();
   }
+
+ private:
+  /// Ensures that the tree is not shared with other configurations (see
+  /// `MutableRoot`).
+  toml::table &Detach() {
+    similar_keys.Invalidate();
+    if ((tree.use_count() > 1) || (root != tree.get())) {
+      tree = std::make_shared<toml::table>(*root);
+      root = tree.get();
+      hashes = std::make_shared<detail::HashCache>();
+      BumpGeneration();
+    } else {
+      // Synchronizes with the release of the previously sharing
+      // configurations (same as `std::shared_ptr` destruction requires).
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *tree;
+  }
 };
 
+namespace detail {
+Configuration ConfigurationAccess::FromTable(toml::table &&tbl) {
+  Configuration cfg{};
+  cfg.pimpl_->Reset(std::move(tbl));
+  return cfg;
+}
+
+const toml::table &ConfigurationAccess::Root(const Configuration &cfg) {
+  return cfg.pimpl_->Root();
+}
+}  // namespace detail
+
 Configuration::Configuration() : pimpl_{new Impl{}} {}
 
 Configuration::~Configuration() = default;
@@ -1176,7 +2001,7 @@ Configuration Configuration::LoadTOMLString(std::string_view toml_string) {
   try {
     toml::table tbl = toml::parse(toml_string);
     Configuration cfg{};
-    cfg.pimpl_->config_root = std::move(tbl);
+    cfg.pimpl_->Reset(std::move(tbl));
     return cfg;
   } catch (const toml::parse_error &err) {
     std::ostringstream msg;
@@ -1187,41 +2012,162 @@ Configuration Configuration::LoadTOMLString(std::string_view toml_string) {
 
 Configuration Configuration::LoadTOMLFile(std::string_view filename) {
   try {
-    return Configuration::LoadTOMLString(files::CatAsciiFile(filename));
+    // Parse directly from the mapped file content to avoid copying it.
+    const files::MappedFile file{filename};
+    return Configuration::LoadTOMLString(file.View());
   } catch (const werkzeugkiste::files::IOError &e) {
     throw ParseError(e.what());
   }
 }
 
 bool Configuration::Empty() const {
-  return (pimpl_ == nullptr) || (pimpl_->config_root.empty());
+  return (pimpl_ == nullptr) || (pimpl_->Root().empty());
 }
 
-bool Configuration::Equals(const Configuration &other) const {
-  using namespace std::string_view_literals;
-  const auto keys_this = detail::ListTableKeys(pimpl_->config_root,
-      ""sv,
-      /*include_array_entries=*/true,
-      /*recursive=*/true);
-  const auto keys_other = detail::ListTableKeys(other.pimpl_->config_root,
-      ""sv,
-      /*include_array_entries=*/true,
-      /*recursive=*/true);
-
-  if (keys_this.size() != keys_other.size()) {
-    return false;
-  }
+namespace detail {
+/// @brief Invokes `func(idx)` for each index in `[0, num_jobs)` on up to
+///   `hardware_concurrency` threads (including the calling thread). The
+///   additional threads are started anew by each call.
+template <typename Func>
+void ParallelFor(std::size_t num_jobs, Func &&func) {
+  std::atomic<std::size_t> next{0};
+  auto worker = [&next, &func, num_jobs]() -> void {
+    for (std::size_t idx = next++; idx < num_jobs; idx = next++) {
+      func(idx);
+    }
+  };
 
-  for (const auto &key : keys_this) {
-    const auto nv_this = pimpl_->config_root.at_path(key);
-    const auto nv_other = other.pimpl_->config_root.at_path(key);
-    if (nv_this != nv_other) {
-      return false;
+  const std::size_t num_threads = std::min(num_jobs,
+      static_cast<std::size_t>(
+          std::max(1U, std::thread::hardware_concurrency())));
+  std::vector<std::thread> pool{};
+  pool.reserve(num_threads);
+  for (std::size_t idx = 1; idx < num_threads; ++idx) {
+    try {
+      pool.emplace_back(worker);
+    } catch (const std::system_error &) {
+      // LCOV_EXCL_START
+      // The remaining jobs will be processed by the already running threads.
+      break;
+      // LCOV_EXCL_STOP
     }
   }
+  worker();
+  for (auto &thread : pool) {
+    thread.join();
+  }
+}
 
+/// @brief Corresponding nodes of two parameter trees.
+using NodePair = std::pair<const toml::node *, const toml::node *>;
+
+/// @brief Maximum depth up to which `SplitComparison` descends.
+constexpr std::size_t kMaxSplitDepth{4};
+
+/// @brief Splits the comparison of two parameter trees into pairs of
+///   corresponding subtrees, which can be compared independently.
+///
+/// The trees are split level by level, until there are at least `min_jobs`
+/// pairs (or `kMaxSplitDepth` is reached). Identical (shared) subtrees are
+/// skipped.
+///
+/// @return False if the trees already differ in their structure, *i.e.* in
+///   the number of parameters or their names.
+bool SplitComparison(const toml::table &lhs,
+    const toml::table &rhs,
+    std::size_t min_jobs,
+    std::vector<NodePair> &jobs) {
+  jobs.clear();
+  jobs.emplace_back(&lhs, &rhs);
+  std::vector<NodePair> next{};
+  for (std::size_t depth = 0;
+       (depth < kMaxSplitDepth) && (jobs.size() < min_jobs);
+       ++depth) {
+    next.clear();
+    bool split = false;
+    for (const auto &[node_lhs, node_rhs] : jobs) {
+      if (node_lhs->is_table() && node_rhs->is_table()) {
+        const toml::table &tbl_lhs = *node_lhs->as_table();
+        const toml::table &tbl_rhs = *node_rhs->as_table();
+        if (tbl_lhs.size() != tbl_rhs.size()) {
+          return false;
+        }
+        for (auto &&[key, value] : tbl_lhs) {
+          const toml::node *other = tbl_rhs.get(key.str());
+          if (other == nullptr) {
+            return false;
+          }
+          if (&value != other) {
+            next.emplace_back(&value, other);
+          }
+        }
+        split = true;
+      } else if (node_lhs->is_array() && node_rhs->is_array()) {
+        const toml::array &arr_lhs = *node_lhs->as_array();
+        const toml::array &arr_rhs = *node_rhs->as_array();
+        if (arr_lhs.size() != arr_rhs.size()) {
+          return false;
+        }
+        for (std::size_t idx = 0; idx < arr_lhs.size(); ++idx) {
+          if (arr_lhs.get(idx) != arr_rhs.get(idx)) {
+            next.emplace_back(arr_lhs.get(idx), arr_rhs.get(idx));
+          }
+        }
+        split = true;
+      } else {
+        next.emplace_back(node_lhs, node_rhs);
+      }
+    }
+    jobs.swap(next);
+    if (!split) {
+      break;
+    }
+  }
   return true;
 }
+}  // namespace detail
+
+bool Configuration::Equals(const Configuration &other) const {
+  // Shared (not yet modified) copies are equal.
+  if (pimpl_->root == other.pimpl_->root) {
+    return true;
+  }
+  return pimpl_->Root() == other.pimpl_->Root();
+}
+
+bool Configuration::Equals(const Configuration &other, bool parallel) const {
+  if (!parallel) {
+    return Equals(other);
+  }
+
+  if (pimpl_->root == other.pimpl_->root) {
+    return true;
+  }
+
+  // Multiple jobs per thread balance the (usually quite different) sizes of
+  // the subtrees.
+  const std::size_t num_threads = std::max(1U,
+      std::thread::hardware_concurrency());
+  std::vector<detail::NodePair> jobs{};
+  if (!detail::SplitComparison(
+          pimpl_->Root(), other.pimpl_->Root(), 8 * num_threads, jobs)) {
+    return false;
+  }
+
+  std::atomic<bool> equal{true};
+  detail::ParallelFor(jobs.size(), [&](std::size_t idx) -> void {
+    // Skip the remaining jobs once a difference has been found.
+    if (!equal.load(std::memory_order_relaxed)) {
+      return;
+    }
+    const toml::node_view<const toml::node> lhs{jobs[idx].first};
+    const toml::node_view<const toml::node> rhs{jobs[idx].second};
+    if (lhs != rhs) {
+      equal.store(false, std::memory_order_relaxed);
+    }
+  });
+  return equal.load();
+}
 
 bool Configuration::operator==(const Configuration &other) const {
   return Equals(other);
@@ -1231,19 +2177,270 @@ bool Configuration::operator!=(const Configuration &other) const {
   return !(*this == other);
 }
 
+uint64_t Configuration::Hash() const {
+  return pimpl_->hashes->Hash(pimpl_->Root());
+}
+
+uint64_t Configuration::Hash(std::string_view key) const {
+  return Hash(key, /*parallel=*/false);
+}
+
+uint64_t Configuration::Hash(std::string_view key, bool parallel) const {
+  const toml::node *node = &pimpl_->Root();
+  if (!key.empty()) {
+    if (!detail::ContainsKey(pimpl_->Root(), key)) {
+      throw pimpl_->MissingKey(key);
+    }
+    node = pimpl_->Root().at_path(key).node();
+  }
+
+  if (!parallel) {
+    return pimpl_->hashes->Hash(*node);
+  }
+
+  // Multiple jobs per thread, as for `Equals`.
+  const std::size_t num_threads = std::max(1U,
+      std::thread::hardware_concurrency());
+  return pimpl_->hashes->Hash(*node, 8 * num_threads,
+      [](std::size_t num_jobs, auto &&func) -> void {
+        detail::ParallelFor(num_jobs, func);
+      });
+}
+
+namespace detail {
+/// @brief Returns true if `key` equals `parent` or refers to one of its
+///   sub-parameters.
+inline bool IsSameOrNestedKey(std::string_view parent, std::string_view key) {
+  if (key.length() == parent.length()) {
+    return key == parent;
+  }
+  return (key.length() > parent.length()) &&
+         (key.substr(0, parent.length()) == parent) &&
+         ((key[parent.length()] == '.') || (key[parent.length()] == '['));
+}
+
+/// @brief Traverses two parameter trees in lockstep to collect their
+///   differences, see `Configuration::Diff`.
+class TreeDiff {
+ public:
+  explicit TreeDiff(ConfigurationDiff &diff) : diff_{diff} {}
+
+  void CompareGroups(const toml::table &lhs, const toml::table &rhs) {
+    // Shared groups are equal (copy-on-write).
+    if (&lhs == &rhs) {
+      return;
+    }
+
+    // Table keys are sorted, thus a single merge pass suffices.
+    auto it_lhs = lhs.begin();
+    auto it_rhs = rhs.begin();
+    while ((it_lhs != lhs.end()) && (it_rhs != rhs.end())) {
+      const std::string_view key_lhs = it_lhs->first.str();
+      const std::string_view key_rhs = it_rhs->first.str();
+      const int cmp = key_lhs.compare(key_rhs);
+      if (cmp < 0) {
+        diff_.removed.push_back(Fqn(key_lhs));
+        ++it_lhs;
+      } else if (cmp > 0) {
+        diff_.added.push_back(Fqn(key_rhs));
+        ++it_rhs;
+      } else {
+        CompareNodes(key_lhs, it_lhs->second, it_rhs->second);
+        ++it_lhs;
+        ++it_rhs;
+      }
+    }
+
+    for (; it_lhs != lhs.end(); ++it_lhs) {
+      diff_.removed.push_back(Fqn(it_lhs->first.str()));
+    }
+    for (; it_rhs != rhs.end(); ++it_rhs) {
+      diff_.added.push_back(Fqn(it_rhs->first.str()));
+    }
+  }
+
+ private:
+  ConfigurationDiff &diff_;
+  std::string path_{};
+
+  std::string Fqn(std::string_view key) const {
+    std::string fqn{path_};
+    if (!fqn.empty()) {
+      fqn += '.';
+    }
+    fqn += key;
+    return fqn;
+  }
+
+  void CompareNodes(std::string_view key,
+      const toml::node &lhs,
+      const toml::node &rhs) {
+    if (&lhs == &rhs) {
+      return;
+    }
+
+    if (lhs.is_table() && rhs.is_table()) {
+      const std::size_t path_length = path_.length();
+      if (path_length > 0) {
+        path_ += '.';
+      }
+      path_ += key;
+      CompareGroups(*lhs.as_table(), *rhs.as_table());
+      path_.resize(path_length);
+      return;
+    }
+
+    if (!ScalarsEqual(lhs, rhs)) {
+      diff_.changed.push_back(Fqn(key));
+    }
+  }
+
+  /// Compares scalars directly (the generic node comparison is
+  /// comparatively slow). Lists are compared as a whole.
+  static bool ScalarsEqual(const toml::node &lhs, const toml::node &rhs) {
+    if (lhs.type() != rhs.type()) {
+      return false;
+    }
+
+    switch (lhs.type()) {
+      case toml::node_type::integer:
+        return lhs.as_integer()->get() == rhs.as_integer()->get();
+
+      case toml::node_type::floating_point: {
+        // As for the node comparison, NaNs are considered equal.
+        const double value_lhs = lhs.as_floating_point()->get();
+        const double value_rhs = rhs.as_floating_point()->get();
+        return (value_lhs == value_rhs) ||
+               (std::isnan(value_lhs) && std::isnan(value_rhs));
+      }
+
+      case toml::node_type::boolean:
+        return lhs.as_boolean()->get() == rhs.as_boolean()->get();
+
+      case toml::node_type::string:
+        return lhs.as_string()->get() == rhs.as_string()->get();
+
+      default:
+        return toml::node_view<const toml::node>{lhs} ==
+               toml::node_view<const toml::node>{rhs};
+    }
+  }
+};
+}  // namespace detail
+
+bool ConfigurationDiff::Affects(std::string_view key) const {
+  if (key.empty()) {
+    return !Empty();
+  }
+
+  for (const auto *fqns : {&added, &removed, &changed}) {
+    for (const auto &fqn : *fqns) {
+      if (detail::IsSameOrNestedKey(key, fqn) ||
+          detail::IsSameOrNestedKey(fqn, key)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+ConfigurationDiff Configuration::Diff(const Configuration &other) const {
+  ConfigurationDiff diff{};
+  detail::TreeDiff{diff}.CompareGroups(
+      pimpl_->Root(), other.pimpl_->Root());
+  return diff;
+}
+
+void Configuration::ApplyPatch(const Configuration &other,
+    const ConfigurationDiff &diff) {
+  if (diff.Empty()) {
+    return;
+  }
+
+  // The whole patch is validated before modifying any parameter. Thus, if
+  // the diff does not belong to these configurations, this configuration
+  // remains unchanged.
+  const toml::table &src = other.pimpl_->Root();
+  const toml::table &dst = pimpl_->Root();
+  const auto begin_removed = diff.removed.begin();
+  for (auto it = begin_removed; it != diff.removed.end(); ++it) {
+    // Parameters of an already removed group no longer exist.
+    const bool exists =
+        detail::ContainsKey(dst, *it) &&
+        std::none_of(begin_removed, it, [it](const std::string &removed) {
+          return detail::IsSameOrNestedKey(removed, *it);
+        });
+    if (!exists) {
+      throw pimpl_->MissingKey(*it);
+    }
+    detail::EnsureDottedOrBareKey(*it);
+  }
+
+  std::vector<std::string_view> inserted{};
+  for (const auto *fqns : {&diff.added, &diff.changed}) {
+    for (const auto &fqn : *fqns) {
+      if (!src.at_path(fqn)) {
+        throw other.pimpl_->MissingKey(fqn);
+      }
+
+      // The parent is either a copy of the other configuration's group (if
+      // it is inserted beforehand), or must exist and must not be removed.
+      const auto path = detail::SplitTomlPath(fqn);
+      const auto is_parent = [&path](std::string_view key) -> bool {
+        return detail::IsSameOrNestedKey(key, path.first);
+      };
+      const toml::node *parent = &dst;
+      if (path.first.empty()) {
+        // The root is never removed or replaced.
+      } else if (std::any_of(inserted.begin(), inserted.end(), is_parent)) {
+        parent = src.at_path(path.first).node();
+      } else if (std::any_of(
+                     diff.removed.begin(), diff.removed.end(), is_parent)) {
+        parent = nullptr;
+      } else {
+        parent = dst.at_path(path.first).node();
+      }
+      if ((parent == nullptr) || !parent->is_table()) {
+        std::string msg{"Cannot apply patch for parameter `"};
+        msg += fqn;
+        msg += "`, because its parent group `";
+        msg += path.first;
+        msg += "` does not exist!";
+        throw KeyError{msg};
+      }
+      inserted.push_back(fqn);
+    }
+  }
+
+  for (const auto &fqn : diff.removed) {
+    Delete(fqn);
+  }
+
+  toml::table &root = pimpl_->MutableRoot();
+  for (const auto *fqns : {&diff.added, &diff.changed}) {
+    for (const auto &fqn : *fqns) {
+      const auto path = detail::SplitTomlPath(fqn);
+      toml::table *parent =
+          path.first.empty() ? &root : root.at_path(path.first).as_table();
+      parent->insert_or_assign(path.second, *src.at_path(fqn).node());
+    }
+  }
+  pimpl_->BumpGeneration();
+}
+
 bool Configuration::Contains(std::string_view key) const {
-  return detail::ContainsKey(pimpl_->config_root, key);
+  return detail::ContainsKey(pimpl_->Root(), key);
 }
 
 std::size_t Configuration::Size(std::string_view key) const {
   if (key.empty()) {
-    return pimpl_->config_root.size();
+    return pimpl_->Root().size();
   }
 
-  const auto nv = pimpl_->config_root.at_path(key);
+  const auto nv = pimpl_->Root().at_path(key);
 
   if (nv.type() == toml::node_type::none) {
-    throw detail::KeyErrorWithSimilarKeys(pimpl_->config_root, key);
+    throw pimpl_->MissingKey(key);
   }
 
   if (nv.type() == toml::node_type::array) {
@@ -1267,10 +2464,10 @@ ConfigType Configuration::Type(std::string_view key) const {
     return ConfigType::Group;
   }
 
-  const auto nv = pimpl_->config_root.at_path(key);
+  const auto nv = pimpl_->Root().at_path(key);
   switch (nv.type()) {
     case toml::node_type::none:
-      throw detail::KeyErrorWithSimilarKeys(pimpl_->config_root, key);
+      throw pimpl_->MissingKey(key);
 
     case toml::node_type::table:
       return ConfigType::Group;
@@ -1309,16 +2506,16 @@ ConfigType Configuration::Type(std::string_view key) const {
 }
 
 void Configuration::Delete(std::string_view key) {
-  if (!detail::ContainsKey(pimpl_->config_root, key)) {
-    throw detail::KeyErrorWithSimilarKeys(pimpl_->config_root, key);
+  if (!detail::ContainsKey(pimpl_->Root(), key)) {
+    throw pimpl_->MissingKey(key);
   }
 
   detail::EnsureDottedOrBareKey(key);
 
   const auto path = detail::SplitTomlPath(key);
-  toml::table *parent = path.first.empty()
-                          ? &pimpl_->config_root
-                          : pimpl_->config_root.at_path(path.first).as_table();
+  toml::table &root = pimpl_->MutableRoot(key);
+  toml::table *parent =
+      path.first.empty() ? &root : root.at_path(path.first).as_table();
   if (parent == nullptr) {
     // LCOV_EXCL_START
     // Should be unreachable due to the previous dotted/bare key check.
@@ -1330,6 +2527,7 @@ void Configuration::Delete(std::string_view key) {
   }
 
   const std::size_t erased = parent->erase(path.second);
+  pimpl_->BumpGeneration();
   // LCOV_EXCL_START
   if (erased == 0) {
     // Should be unreachable.
@@ -1344,11 +2542,11 @@ void Configuration::Delete(std::string_view key) {
 }
 
 bool Configuration::IsHomogeneousScalarList(std::string_view key) const {
-  if (!detail::ContainsKey(pimpl_->config_root, key)) {
-    throw detail::KeyErrorWithSimilarKeys(pimpl_->config_root, key);
+  if (!detail::ContainsKey(pimpl_->Root(), key)) {
+    throw pimpl_->MissingKey(key);
   }
 
-  auto node = pimpl_->config_root.at_path(key);
+  auto node = pimpl_->Root().at_path(key);
   if (!node.is_array()) {
     std::string msg{"Cannot check if `"};
     msg += key;
@@ -1375,6 +2573,18 @@ std::vector<std::string> Configuration::ListParameterNames(std::string_view key,
       pimpl_->ImmutableTable(key), ""sv, include_array_entries, recursive);
 }
 
+void Configuration::VisitParameterNames(std::string_view key,
+    bool include_array_entries,
+    bool recursive,
+    const NameVisitor &visitor) const {
+  std::string buffer{};
+  detail::VisitTableKeys(pimpl_->ImmutableTable(key),
+      buffer,
+      include_array_entries,
+      recursive,
+      visitor);
+}
+
 bool Configuration::EnsureTypeIfExists(std::string_view key,
     ConfigType expected) const {
   if (!Contains(key)) {
@@ -1398,28 +2608,308 @@ std::string Configuration::KeyForListElement(std::string_view key,
   return detail::FullyQualifiedArrayElementPath(key, index);
 }
 
+//---------------------------------------------------------------------------
+// Key handles
+
+Configuration::KeyHandle::KeyHandle(std::string_view key) : key_{key} {
+  Split(key_, 0, segments_);
+}
+
+void Configuration::KeyHandle::Split(std::string_view key,
+    std::size_t offset,
+    std::vector<Segment> &segments) {
+  const auto raise_malformed = [key]() -> void {
+    std::string msg{"Invalid list index in parameter name `"};
+    msg += key;
+    msg += "`!";
+    throw KeyError{msg};
+  };
+
+  const std::size_t num_segments = segments.size();
+  const std::size_t length = key.length();
+  std::size_t pos{0};
+  while (true) {
+    // A table key spans up to the next separator and may be empty (as TOML
+    // supports quoted empty keys).
+    const std::size_t sep = key.find_first_of(".[", pos);
+    const std::size_t end = (sep == std::string::npos) ? length : sep;
+    if ((end > pos) || (end == length) || (key[end] == '.') ||
+        (segments.size() > num_segments)) {
+      Segment segment{};
+      segment.offset = offset + pos;
+      segment.length = end - pos;
+      segments.push_back(segment);
+    }
+    pos = end;
+
+    // A table key can be followed by an arbitrary number of list indices.
+    while ((pos < length) && (key[pos] == '[')) {
+      const std::size_t close = key.find(']', pos);
+      if (close == std::string::npos) {
+        raise_malformed();
+      }
+
+      // Similar to TOML paths, the index may be padded by white space.
+      std::size_t first = pos + 1;
+      std::size_t last = close;
+      while ((first < last) && (key[first] == ' ')) {
+        ++first;
+      }
+      while ((last > first) && (key[last - 1] == ' ')) {
+        --last;
+      }
+      if (first == last) {
+        raise_malformed();
+      }
+
+      Segment segment{};
+      segment.is_index = true;
+      for (std::size_t idx = first; idx < last; ++idx) {
+        const char chr = key[idx];
+        if ((chr < '0') || (chr > '9')) {
+          raise_malformed();
+        }
+        // NOLINTNEXTLINE(*magic-numbers)
+        segment.index *= 10;
+        segment.index += static_cast<std::size_t>(chr - '0');
+      }
+      segments.push_back(segment);
+      pos = close + 1;
+    }
+
+    if (pos >= length) {
+      break;
+    }
+
+    if (key[pos] != '.') {
+      raise_malformed();
+    }
+    ++pos;
+  }
+}
+
+bool Configuration::Contains(const KeyHandle &key) const {
+  return pimpl_->Resolve(key) != nullptr;
+}
+
+template <typename Tp>
+Tp Configuration::Get(const KeyHandle &key) const {
+  const toml::node *node = pimpl_->Resolve(key);
+  if (node == nullptr) {
+    throw pimpl_->MissingKey(key.Key());
+  }
+
+  return detail::ConvertNode<Tp>(*node, key.Key());
+}
+
+// Explicit instantiations of the supported handle-based getters.
+template bool Configuration::Get<bool>(const KeyHandle &) const;
+template int32_t Configuration::Get<int32_t>(const KeyHandle &) const;
+template int64_t Configuration::Get<int64_t>(const KeyHandle &) const;
+template double Configuration::Get<double>(const KeyHandle &) const;
+template std::string Configuration::Get<std::string>(const KeyHandle &) const;
+template date Configuration::Get<date>(const KeyHandle &) const;
+template time Configuration::Get<time>(const KeyHandle &) const;
+template date_time Configuration::Get<date_time>(const KeyHandle &) const;
+template std::vector<bool> Configuration::Get<std::vector<bool>>(
+    const KeyHandle &) const;
+template std::vector<int32_t> Configuration::Get<std::vector<int32_t>>(
+    const KeyHandle &) const;
+template std::vector<int64_t> Configuration::Get<std::vector<int64_t>>(
+    const KeyHandle &) const;
+template std::vector<double> Configuration::Get<std::vector<double>>(
+    const KeyHandle &) const;
+template std::vector<std::string> Configuration::Get<std::vector<std::string>>(
+    const KeyHandle &) const;
+template std::vector<date> Configuration::Get<std::vector<date>>(
+    const KeyHandle &) const;
+template std::vector<time> Configuration::Get<std::vector<time>>(
+    const KeyHandle &) const;
+template std::vector<date_time> Configuration::Get<std::vector<date_time>>(
+    const KeyHandle &) const;
+
+template <typename Tp>
+LookupResult<Tp> Configuration::TryGet(std::string_view key) const {
+  const toml::node *node = pimpl_->Root().at_path(key).node();
+  if (node == nullptr) {
+    return LookupError::KeyNotFound;
+  }
+  return detail::TryConvertNode<Tp>(*node);
+}
+
+template <typename Tp>
+LookupResult<Tp> Configuration::TryGet(const KeyHandle &key) const {
+  const toml::node *node = pimpl_->Resolve(key);
+  if (node == nullptr) {
+    return LookupError::KeyNotFound;
+  }
+  return detail::TryConvertNode<Tp>(*node);
+}
+
+// NOLINTNEXTLINE(*macro-usage)
+#define WZK_CONFIG_INSTANTIATE_TRY_GET(TYPE)                                 \
+  template LookupResult<TYPE> Configuration::TryGet<TYPE>(std::string_view) \
+      const;                                                                \
+  template LookupResult<TYPE> Configuration::TryGet<TYPE>(                  \
+      const KeyHandle &) const;
+
+WZK_CONFIG_INSTANTIATE_TRY_GET(bool)
+WZK_CONFIG_INSTANTIATE_TRY_GET(int32_t)
+WZK_CONFIG_INSTANTIATE_TRY_GET(int64_t)
+WZK_CONFIG_INSTANTIATE_TRY_GET(double)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::string)
+WZK_CONFIG_INSTANTIATE_TRY_GET(date)
+WZK_CONFIG_INSTANTIATE_TRY_GET(time)
+WZK_CONFIG_INSTANTIATE_TRY_GET(date_time)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<bool>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<int32_t>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<int64_t>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<double>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<std::string>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<date>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<time>)
+WZK_CONFIG_INSTANTIATE_TRY_GET(std::vector<date_time>)
+#undef WZK_CONFIG_INSTANTIATE_TRY_GET
+
+//---------------------------------------------------------------------------
+// Batch access
+
+Configuration::Binder Configuration::Bind() const { return Binder{*this}; }
+
+void Configuration::Binder::Add(std::string_view key,
+    Destination destination,
+    bool optional) {
+  const bool is_null = std::visit(
+      [](auto *ptr) -> bool { return ptr == nullptr; }, destination);
+  if (is_null) {
+    std::string msg{"Destination of parameter `"};
+    msg += key;
+    msg += "` must not be a nullptr!";
+    throw ValueError{msg};
+  }
+
+  const std::size_t segments_begin = segments_.size();
+  KeyHandle::Split(key, keys_.length(), segments_);
+  bindings_.push_back(Binding{keys_.length(), key.length(), segments_begin,
+      segments_.size(), destination, optional});
+  keys_ += key;
+}
+
+void Configuration::Binder::Resolve() {
+  const std::string_view keys{keys_};
+  const auto key_of = [keys](const Binding *binding) -> std::string_view {
+    return keys.substr(binding->key_offset, binding->key_length);
+  };
+
+  // Sort the bindings by name, such that parameters which share a path
+  // prefix are adjacent.
+  if (order_.size() != bindings_.size()) {
+    order_.resize(bindings_.size());
+    for (std::size_t idx = 0; idx < order_.size(); ++idx) {
+      order_[idx] = idx;
+    }
+    std::sort(order_.begin(), order_.end(),
+        [this, &key_of](std::size_t lhs, std::size_t rhs) -> bool {
+          return key_of(&bindings_[lhs]) < key_of(&bindings_[rhs]);
+        });
+  }
+
+  const toml::table &root = config_->pimpl_->Root();
+  // Resolved nodes along the path of the previous binding.
+  std::vector<const toml::node *> path{};
+  const Binding *previous{nullptr};
+  std::string missing{};
+  std::string invalid{};
+  for (const std::size_t binding_idx : order_) {
+    const Binding *binding = &bindings_[binding_idx];
+    const std::size_t num_segments =
+        binding->segments_end - binding->segments_begin;
+    const KeyHandle::Segment *segments = &segments_[binding->segments_begin];
+
+    // Reuse the resolved nodes of the shared path prefix.
+    std::size_t depth{0};
+    if (previous != nullptr) {
+      const std::size_t max_depth = std::min({path.size(), num_segments,
+          previous->segments_end - previous->segments_begin});
+      const KeyHandle::Segment *prev_segments =
+          &segments_[previous->segments_begin];
+      while ((depth < max_depth) &&
+             Impl::SameSegment(
+                 keys, segments[depth], keys, prev_segments[depth])) {
+        ++depth;
+      }
+    }
+    path.resize(depth);
+    previous = binding;
+
+    const toml::node *node = (depth > 0) ? path.back() : &root;
+    for (; (node != nullptr) && (depth < num_segments); ++depth) {
+      node = Impl::Step(*node, keys, segments[depth]);
+      if (node != nullptr) {
+        path.push_back(node);
+      }
+    }
+
+    const std::string_view key = key_of(binding);
+    if (node == nullptr) {
+      if (!binding->optional) {
+        missing += config_->pimpl_->MissingKey(key).what();
+        missing += '\n';
+      }
+      continue;
+    }
+
+    try {
+      std::visit(
+          [node, key](auto *destination) -> void {
+            using Tp = std::decay_t<decltype(*destination)>;
+            *destination = detail::ConvertNode<Tp>(*node, key);
+          },
+          binding->destination);
+    } catch (const TypeError &e) {
+      invalid += e.what();
+      invalid += '\n';
+    }
+  }
+
+  if (missing.empty() && invalid.empty()) {
+    return;
+  }
+
+  std::string msg{"Cannot resolve all bound parameters:\n"};
+  msg += missing;
+  msg += invalid;
+  msg.pop_back();
+  if (!missing.empty()) {
+    throw KeyError{msg};
+  }
+  throw TypeError{msg};
+}
+
 //---------------------------------------------------------------------------
 // Boolean
 
 bool Configuration::GetBool(std::string_view key) const {
-  return detail::LookupScalar<bool>(pimpl_->config_root,
+  return detail::LookupScalar<bool>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 bool Configuration::GetBoolOr(std::string_view key, bool default_val) const {
-  return detail::LookupScalar<bool>(pimpl_->config_root,
+  return detail::LookupScalar<bool>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
 }
 
 std::optional<bool> Configuration::GetOptionalBool(std::string_view key) const {
-  return detail::LookupOptionalScalar<bool>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<bool>(pimpl_->Root(), key);
 }
 
 void Configuration::SetBool(std::string_view key, bool value) {
-  detail::SetScalar<bool>(pimpl_->config_root, key, value);
+  detail::SetScalar<bool>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<bool> Configuration::GetBoolList(std::string_view key) const {
@@ -1428,21 +2918,24 @@ std::vector<bool> Configuration::GetBoolList(std::string_view key) const {
 
 void Configuration::SetBoolList(std::string_view key,
     const std::vector<bool> &values) {
-  detail::SetList<bool>(pimpl_->config_root, key, values);
+  detail::SetList<bool>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 // Integer (32-bit)
 
 int32_t Configuration::GetInt32(std::string_view key) const {
-  return detail::LookupScalar<int32_t>(pimpl_->config_root,
+  return detail::LookupScalar<int32_t>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 int32_t Configuration::GetInt32Or(std::string_view key,
     int32_t default_val) const {
-  return detail::LookupScalar<int32_t>(pimpl_->config_root,
+  return detail::LookupScalar<int32_t>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
@@ -1450,12 +2943,12 @@ int32_t Configuration::GetInt32Or(std::string_view key,
 
 std::optional<int32_t> Configuration::GetOptionalInt32(
     std::string_view key) const {
-  return detail::LookupOptionalScalar<int32_t>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<int32_t>(pimpl_->Root(), key);
 }
 
 void Configuration::SetInt32(std::string_view key, int32_t value) {
   detail::SetScalar<int64_t>(
-      pimpl_->config_root, key, static_cast<int64_t>(value));
+      pimpl_->MutableRoot(key), key, static_cast<int64_t>(value));
 }
 
 std::vector<int32_t> Configuration::GetInt32List(std::string_view key) const {
@@ -1464,21 +2957,24 @@ std::vector<int32_t> Configuration::GetInt32List(std::string_view key) const {
 
 void Configuration::SetInt32List(std::string_view key,
     const std::vector<int32_t> &values) {
-  detail::SetList<int64_t>(pimpl_->config_root, key, values);
+  detail::SetList<int64_t>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 // Integer (64-bit)
 
 int64_t Configuration::GetInt64(std::string_view key) const {
-  return detail::LookupScalar<int64_t>(pimpl_->config_root,
+  return detail::LookupScalar<int64_t>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 int64_t Configuration::GetInt64Or(std::string_view key,
     int64_t default_val) const {
-  return detail::LookupScalar<int64_t>(pimpl_->config_root,
+  return detail::LookupScalar<int64_t>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
@@ -1486,11 +2982,11 @@ int64_t Configuration::GetInt64Or(std::string_view key,
 
 std::optional<int64_t> Configuration::GetOptionalInt64(
     std::string_view key) const {
-  return detail::LookupOptionalScalar<int64_t>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<int64_t>(pimpl_->Root(), key);
 }
 
 void Configuration::SetInt64(std::string_view key, int64_t value) {
-  detail::SetScalar<int64_t>(pimpl_->config_root, key, value);
+  detail::SetScalar<int64_t>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<int64_t> Configuration::GetInt64List(std::string_view key) const {
@@ -1499,39 +2995,46 @@ std::vector<int64_t> Configuration::GetInt64List(std::string_view key) const {
 
 void Configuration::SetInt64List(std::string_view key,
     const std::vector<int64_t> &values) {
-  detail::SetList<int64_t>(pimpl_->config_root, key, values);
+  detail::SetList<int64_t>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 point2d<int64_t> Configuration::GetInt64Point2D(std::string_view key) const {
-  return detail::GetPoint<point2d<int64_t>>(pimpl_->config_root, key);
+  return detail::GetPoint<point2d<int64_t>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 point3d<int64_t> Configuration::GetInt64Point3D(std::string_view key) const {
-  return detail::GetPoint<point3d<int64_t>>(pimpl_->config_root, key);
+  return detail::GetPoint<point3d<int64_t>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 std::vector<point2d<int64_t>> Configuration::GetInt64Points2D(
     std::string_view key) const {
-  return detail::GetPoints<point2d<int64_t>>(pimpl_->config_root, key);
+  return detail::GetPoints<point2d<int64_t>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 std::vector<point3d<int64_t>> Configuration::GetInt64Points3D(
     std::string_view key) const {
-  return detail::GetPoints<point3d<int64_t>>(pimpl_->config_root, key);
+  return detail::GetPoints<point3d<int64_t>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 //---------------------------------------------------------------------------
 // Floating Point
 
 double Configuration::GetDouble(std::string_view key) const {
-  return detail::LookupScalar<double>(pimpl_->config_root,
+  return detail::LookupScalar<double>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 double Configuration::GetDoubleOr(std::string_view key,
     double default_val) const {
-  return detail::LookupScalar<double>(pimpl_->config_root,
+  return detail::LookupScalar<double>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
@@ -1539,38 +3042,57 @@ double Configuration::GetDoubleOr(std::string_view key,
 
 std::optional<double> Configuration::GetOptionalDouble(
     std::string_view key) const {
-  return detail::LookupOptionalScalar<double>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<double>(pimpl_->Root(), key);
 }
 
 void Configuration::SetDouble(std::string_view key, double value) {
-  detail::SetScalar<double>(pimpl_->config_root, key, value);
+  detail::SetScalar<double>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<double> Configuration::GetDoubleList(std::string_view key) const {
   return detail::GetList<double>(pimpl_->ImmutableList(key), key);
 }
 
+void Configuration::GetDoubleListInto(std::string_view key,
+    double *data,
+    std::size_t size) const {
+  const toml::array &arr = pimpl_->ImmutableList(key);
+  if (arr.size() != size) {
+    std::string msg{"Cannot load list `"};
+    msg += key;
+    msg += "` with " + std::to_string(arr.size()) +
+           " elements into a buffer of size " + std::to_string(size) + '!';
+    throw ValueError{msg};
+  }
+  detail::CopyDoubleList(arr, detail::KeyPath{key}, data, 1);
+}
+
 void Configuration::SetDoubleList(std::string_view key,
     const std::vector<double> &values) {
-  detail::SetList<double>(pimpl_->config_root, key, values);
+  detail::SetList<double>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 point2d<double> Configuration::GetDoublePoint2D(std::string_view key) const {
-  return detail::GetPoint<point2d<double>>(pimpl_->config_root, key);
+  return detail::GetPoint<point2d<double>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 point3d<double> Configuration::GetDoublePoint3D(std::string_view key) const {
-  return detail::GetPoint<point3d<double>>(pimpl_->config_root, key);
+  return detail::GetPoint<point3d<double>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 std::vector<point2d<double>> Configuration::GetDoublePoints2D(
     std::string_view key) const {
-  return detail::GetPoints<point2d<double>>(pimpl_->config_root, key);
+  return detail::GetPoints<point2d<double>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 std::vector<point3d<double>> Configuration::GetDoublePoints3D(
     std::string_view key) const {
-  return detail::GetPoints<point3d<double>>(pimpl_->config_root, key);
+  return detail::GetPoints<point3d<double>>(
+      pimpl_->Root(), pimpl_->similar_keys, key);
 }
 
 //---------------------------------------------------------------------------
@@ -1579,22 +3101,30 @@ std::vector<point3d<double>> Configuration::GetDoublePoints3D(
 std::string Configuration::GetString(std::string_view key) const {
   using namespace std::string_view_literals;
   return detail::LookupScalar<std::string, std::string_view>(
-      pimpl_->config_root, key, /*allow_default=*/false, ""sv);
+      pimpl_->Root(),
+      pimpl_->similar_keys,
+      key,
+      /*allow_default=*/false,
+      ""sv);
 }
 
 std::string Configuration::GetStringOr(std::string_view key,
     std::string_view default_val) const {
   return detail::LookupScalar<std::string, std::string_view>(
-      pimpl_->config_root, key, /*allow_default=*/true, default_val);
+      pimpl_->Root(),
+      pimpl_->similar_keys,
+      key,
+      /*allow_default=*/true,
+      default_val);
 }
 
 std::optional<std::string> Configuration::GetOptionalString(
     std::string_view key) const {
-  return detail::LookupOptionalScalar<std::string>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<std::string>(pimpl_->Root(), key);
 }
 
 void Configuration::SetString(std::string_view key, std::string_view value) {
-  detail::SetScalar<std::string>(pimpl_->config_root, key, value);
+  detail::SetScalar<std::string>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<std::string> Configuration::GetStringList(
@@ -1604,32 +3134,35 @@ std::vector<std::string> Configuration::GetStringList(
 
 void Configuration::SetStringList(std::string_view key,
     const std::vector<std::string_view> &values) {
-  detail::SetList<std::string>(pimpl_->config_root, key, values);
+  detail::SetList<std::string>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 // Date
 
 date Configuration::GetDate(std::string_view key) const {
-  return detail::LookupScalar<date>(pimpl_->config_root,
+  return detail::LookupScalar<date>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 date Configuration::GetDateOr(std::string_view key,
     const date &default_val) const {
-  return detail::LookupScalar<date>(pimpl_->config_root,
+  return detail::LookupScalar<date>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
 }
 
 std::optional<date> Configuration::GetOptionalDate(std::string_view key) const {
-  return detail::LookupOptionalScalar<date>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<date>(pimpl_->Root(), key);
 }
 
 void Configuration::SetDate(std::string_view key, const date &value) {
-  detail::SetScalar<toml::date>(pimpl_->config_root, key, value);
+  detail::SetScalar<toml::date>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<date> Configuration::GetDateList(std::string_view key) const {
@@ -1638,32 +3171,35 @@ std::vector<date> Configuration::GetDateList(std::string_view key) const {
 
 void Configuration::SetDateList(std::string_view key,
     const std::vector<date> &values) {
-  detail::SetList<toml::date>(pimpl_->config_root, key, values);
+  detail::SetList<toml::date>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 // Time
 
 time Configuration::GetTime(std::string_view key) const {
-  return detail::LookupScalar<time>(pimpl_->config_root,
+  return detail::LookupScalar<time>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 time Configuration::GetTimeOr(std::string_view key,
     const time &default_val) const {
-  return detail::LookupScalar<time>(pimpl_->config_root,
+  return detail::LookupScalar<time>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
 }
 
 std::optional<time> Configuration::GetOptionalTime(std::string_view key) const {
-  return detail::LookupOptionalScalar<time>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<time>(pimpl_->Root(), key);
 }
 
 void Configuration::SetTime(std::string_view key, const time &value) {
-  detail::SetScalar<toml::time>(pimpl_->config_root, key, value);
+  detail::SetScalar<toml::time>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<time> Configuration::GetTimeList(std::string_view key) const {
@@ -1672,21 +3208,24 @@ std::vector<time> Configuration::GetTimeList(std::string_view key) const {
 
 void Configuration::SetTimeList(std::string_view key,
     const std::vector<time> &values) {
-  detail::SetList<toml::time>(pimpl_->config_root, key, values);
+  detail::SetList<toml::time>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 // Date-time
 
 date_time Configuration::GetDateTime(std::string_view key) const {
-  return detail::LookupScalar<date_time>(pimpl_->config_root,
+  return detail::LookupScalar<date_time>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/false);
 }
 
 date_time Configuration::GetDateTimeOr(std::string_view key,
     const date_time &default_val) const {
-  return detail::LookupScalar<date_time>(pimpl_->config_root,
+  return detail::LookupScalar<date_time>(pimpl_->Root(),
+      pimpl_->similar_keys,
       key,
       /*allow_default=*/true,
       default_val);
@@ -1694,11 +3233,11 @@ date_time Configuration::GetDateTimeOr(std::string_view key,
 
 std::optional<date_time> Configuration::GetOptionalDateTime(
     std::string_view key) const {
-  return detail::LookupOptionalScalar<date_time>(pimpl_->config_root, key);
+  return detail::LookupOptionalScalar<date_time>(pimpl_->Root(), key);
 }
 
 void Configuration::SetDateTime(std::string_view key, const date_time &value) {
-  detail::SetScalar<toml::date_time>(pimpl_->config_root, key, value);
+  detail::SetScalar<toml::date_time>(pimpl_->MutableRoot(key), key, value);
 }
 
 std::vector<date_time> Configuration::GetDateTimeList(
@@ -1708,120 +3247,109 @@ std::vector<date_time> Configuration::GetDateTimeList(
 
 void Configuration::SetDateTimeList(std::string_view key,
     const std::vector<date_time> &values) {
-  detail::SetList<toml::date_time>(pimpl_->config_root, key, values);
+  detail::SetList<toml::date_time>(pimpl_->MutableRoot(key), key, values);
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
 void Configuration::CreateList(std::string_view key) {
-  if (detail::ContainsKey(pimpl_->config_root, key)) {
+  if (detail::ContainsKey(pimpl_->Root(), key)) {
     std::string msg{"Cannot create an empty list because parameter `"};
     msg += key;
     msg += "` already exists!";
     throw KeyError{msg};
   }
 
-  detail::CreateList<bool, bool>(pimpl_->config_root, key, {});
+  detail::CreateList<bool, bool>(pimpl_->MutableRoot(key), key, {});
 }
 
 void Configuration::ClearList(std::string_view key) {
-  toml::array *arr = detail::GetExistingList(pimpl_->config_root, key);
+  toml::array *arr = detail::GetExistingList(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key);
   arr->clear();
+  pimpl_->BumpGeneration();
 }
 
 void Configuration::AppendList(std::string_view key) {
-  toml::array *arr = detail::GetExistingList(pimpl_->config_root, key);
+  toml::array *arr = detail::GetExistingList(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key);
   arr->push_back(toml::array{});
 }
 
 void Configuration::Append(std::string_view key, bool value) {
-  detail::AppendScalarListElement<bool>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<bool>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, int32_t value) {
-  detail::AppendScalarListElement<int64_t>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<int64_t>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, int64_t value) {
-  detail::AppendScalarListElement<int64_t>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<int64_t>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, double value) {
-  detail::AppendScalarListElement<double>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<double>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, std::string_view value) {
-  detail::AppendScalarListElement<std::string>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<std::string>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, const date &value) {
-  detail::AppendScalarListElement<toml::date>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<toml::date>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, const time &value) {
-  detail::AppendScalarListElement<toml::time>(pimpl_->config_root, key, value);
+  detail::AppendScalarListElement<toml::time>(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, const date_time &value) {
   detail::AppendScalarListElement<toml::date_time>(
-      pimpl_->config_root, key, value);
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key, value);
 }
 
 void Configuration::Append(std::string_view key, const Configuration &group) {
-  toml::array *arr = detail::GetExistingList(pimpl_->config_root, key);
-  arr->push_back(group.pimpl_->config_root);
+  toml::array *arr = detail::GetExistingList(
+      pimpl_->MutableRoot(key), pimpl_->similar_keys, key);
+  arr->push_back(group.pimpl_->Root());
 }
 
 //---------------------------------------------------------------------------
 // Group/"Sub-Configuration"
 
 Configuration Configuration::GetGroup(std::string_view key) const {
+  // The group shares the parameter tree, until either configuration is
+  // modified.
   const toml::table &tbl = pimpl_->ImmutableTable(key);
   Configuration cfg;
-  cfg.pimpl_->config_root = tbl;
+  cfg.pimpl_ = std::make_unique<Impl>(pimpl_->tree, &tbl, pimpl_->hashes);
   return cfg;
 }
 
 void Configuration::SetGroup(std::string_view key, const Configuration &group) {
-  if (key.empty()) {
-    throw KeyError{
-        "Cannot replace this configuration with a parameter group. Key cannot "
-        "be empty in `SetGroup`!"};
-  }
-
-  const auto path = detail::SplitTomlPath(key);
-  if (detail::ContainsKey(pimpl_->config_root, key)) {
-    const auto node = pimpl_->config_root.at_path(key);
-    if (!node.is_table()) {
-      std::string msg{"Cannot insert parameter group at `"};
-      msg += key;
-      msg += "`. Existing parameter is of type `";
-      msg += detail::TomlTypeName(node, key);
-      msg += "`!";
-      throw TypeError{msg};
-    }
+  detail::InsertGroup(pimpl_->MutableRoot(key), key, group.pimpl_->Root());
+  pimpl_->BumpGeneration();
+}
 
-    auto &ref = *node.as_table();
-    ref = group.pimpl_->config_root;
+void Configuration::SetGroup(std::string_view key, Configuration &&group) {
+  // If the group's parameters are not shared, we can move them instead.
+  Impl &other = *group.pimpl_;
+  if ((other.tree.use_count() == 1) && (other.root == other.tree.get())) {
+    detail::InsertGroup(pimpl_->MutableRoot(key), key, std::move(*other.tree));
+    other.hashes->Clear();
+    other.BumpGeneration();
   } else {
-    detail::EnsureContainerPathExists(pimpl_->config_root, path.first);
-    toml::table *parent =
-        path.first.empty() ? &pimpl_->config_root
-                           : pimpl_->config_root.at_path(path.first).as_table();
-    if (parent == nullptr) {
-      // LCOV_EXCL_START
-      WZK_CONFIG_LOOKUP_RAISE_PATH_CREATION_ERROR(key, path.first);
-      // LCOV_EXCL_STOP
-    }
-
-    auto result =
-        parent->insert_or_assign(path.second, group.pimpl_->config_root);
-    if (!detail::ContainsKey(pimpl_->config_root, key)) {
-      // LCOV_EXCL_START
-      WZK_CONFIG_LOOKUP_RAISE_ASSIGNMENT_ERROR(
-          key, result.second, path.first, path.second);
-      // LCOV_EXCL_STOP
-    }
+    detail::InsertGroup(pimpl_->MutableRoot(key), key, other.Root());
   }
+  pimpl_->BumpGeneration();
 }
 
 //---------------------------------------------------------------------------
@@ -1847,91 +3375,127 @@ Matrix<double> Configuration::GetMatrixDouble(std::string_view key) const {
   return detail::GetMatrix<double>(pimpl_->ImmutableList(key), key);
 }
 
+void Configuration::GetMatrixInto(std::string_view key,
+    Eigen::Ref<Matrix<double>> mat) const {
+  detail::GetMatrixInto(pimpl_->ImmutableList(key), key, mat);
+}
+
+void Configuration::SetMatrixValues(std::string_view key,
+    Eigen::Ref<const Matrix<int64_t>> mat) {
+  if (EnsureTypeIfExists(key, ConfigType::List)) {
+    toml::array &existing = *pimpl_->MutableRoot(key).at_path(key).as_array();
+    if (detail::OverwriteMatrix<int64_t>(existing, mat)) {
+      return;
+    }
+    existing = detail::MatrixToArray<int64_t>(mat);
+  } else {
+    detail::InsertArray(
+        pimpl_->MutableRoot(key), key, detail::MatrixToArray<int64_t>(mat));
+  }
+  pimpl_->BumpGeneration();
+}
+
+void Configuration::SetMatrixValues(std::string_view key,
+    Eigen::Ref<const Matrix<double>> mat) {
+  if (EnsureTypeIfExists(key, ConfigType::List)) {
+    toml::array &existing = *pimpl_->MutableRoot(key).at_path(key).as_array();
+    if (detail::OverwriteMatrix<double>(existing, mat)) {
+      return;
+    }
+    existing = detail::MatrixToArray<double>(mat);
+  } else {
+    detail::InsertArray(
+        pimpl_->MutableRoot(key), key, detail::MatrixToArray<double>(mat));
+  }
+  pimpl_->BumpGeneration();
+}
+
 //---------------------------------------------------------------------------
 // Convenience utilities
 
-bool Configuration::AdjustRelativePaths(std::string_view key,
+namespace detail {
+/// @brief Rewrites all string parameters below the given group within a
+///   single traversal.
+///
+/// Each string is first passed through the `replacer` (if not null). Then, if
+/// its name matches the `path_matcher` (if not null) and it holds a relative
+/// path, the `base_path` is prepended.
+/// @return True if any string has been changed.
+bool RewriteStrings(toml::table &tbl,
+    PlaceholderReplacer *replacer,
     std::string_view base_path,
-    const std::vector<std::string_view> &parameters) {
+    const KeyMatcher *path_matcher) {
   using namespace std::string_view_literals;
-  const KeyMatcher matcher{parameters};
-  auto to_replace = [matcher](std::string_view fqn) -> bool {
-    return matcher.Match(fqn);
-  };
+  bool rewritten{false};
+  // Buffer to format the parameter names, reused for all string parameters.
+  std::string fqn_buffer{};
+  auto func = [&](toml::node &node, const KeyPath &fqn) -> void {
+    if (!node.is_string()) {
+      return;
+    }
+
+    std::string &str = node.as_string()->get();
+    if ((replacer != nullptr) && replacer->Rewrite(str)) {
+      rewritten = true;
+    }
 
-  bool replaced{false};
-  bool *rep_ptr = &replaced;
-  auto func = [rep_ptr, to_replace, base_path](
-                  toml::node &node, std::string_view fqn) -> void {
-    if (node.is_string() && to_replace(fqn)) {
+    if ((path_matcher != nullptr) &&
+        path_matcher->Match(fqn.Format(fqn_buffer))) {
       // Check if the path is relative
-      const std::string param_str =
-          detail::ConvertTomlToConfigType<std::string>(node, fqn);
-      const bool is_file_url = strings::StartsWith(param_str, "file://");
+      const bool is_file_url = strings::StartsWith(str, "file://");
       // NOLINTNEXTLINE(*magic-numbers)
-      const std::string path = is_file_url ? param_str.substr(7) : param_str;
+      const std::string_view path = std::string_view{str}.substr(
+          is_file_url ? 7 : 0);
 
       if (!files::IsAbsolute(path)) {
-        auto &str = *node.as_string();
-        const std::string abspath = files::FullFile(base_path, path);
+        std::string abspath = files::FullFile(base_path, path);
         if (is_file_url) {
           str = "file://" + abspath;
         } else {
-          str = abspath;
+          str = std::move(abspath);
         }
-        *rep_ptr = true;
+        rewritten = true;
       }
     }
   };
-  detail::Traverse(pimpl_->MutableTable(key), ""sv, func);
-  return replaced;
+  Traverse(tbl, KeyPath{""sv}, func);
+  return rewritten;
+}
+}  // namespace detail
+
+bool Configuration::AdjustRelativePaths(std::string_view key,
+    std::string_view base_path,
+    const std::vector<std::string_view> &parameters) {
+  const KeyMatcher matcher{parameters};
+  return detail::RewriteStrings(
+      pimpl_->MutableTable(key), nullptr, base_path, &matcher);
 }
 
 bool Configuration::ReplaceStringPlaceholders(std::string_view key,
     const std::vector<std::pair<std::string_view, std::string_view>>
         &replacements) {
-  // Sanity check, search string can't be empty
-  for (const auto &rep : replacements) {
-    if (rep.first.empty()) {
-      throw ValueError{
-          "Search string within `ReplaceStrings()` must not be empty!"};
-    }
-  }
-
-  using namespace std::string_view_literals;
-  bool replaced{false};
-  bool *rep_ptr = &replaced;
-  auto func = [rep_ptr, replacements](
-                  toml::node &node, std::string_view fqn) -> void {
-    if (node.is_string()) {
-      std::string param_str =
-          detail::ConvertTomlToConfigType<std::string>(node, fqn);
-      bool matched{false};
-      for (const auto &rep : replacements) {
-        std::size_t pos{0};
-        while ((pos = param_str.find(rep.first, pos)) != std::string::npos) {
-          param_str.replace(pos, rep.first.length(), rep.second);
-          matched = true;
-        }
-      }
+  detail::PlaceholderReplacer replacer{replacements};
+  return detail::RewriteStrings(
+      pimpl_->MutableTable(key), &replacer, std::string_view{}, nullptr);
+}
 
-      if (matched) {
-        auto &str = *node.as_string();
-        str = param_str;
-        *rep_ptr = true;
-      }
-    }
-  };
-  detail::Traverse(pimpl_->MutableTable(key), ""sv, func);
-  return replaced;
+bool Configuration::RewriteStrings(std::string_view key,
+    const std::vector<std::pair<std::string_view, std::string_view>>
+        &replacements,
+    std::string_view base_path,
+    const std::vector<std::string_view> &path_parameters) {
+  detail::PlaceholderReplacer replacer{replacements};
+  const KeyMatcher matcher{path_parameters};
+  return detail::RewriteStrings(
+      pimpl_->MutableTable(key), &replacer, base_path, &matcher);
 }
 
 void Configuration::LoadNestedConfiguration(std::string_view key) {
-  if (!detail::ContainsKey(pimpl_->config_root, key)) {
-    throw detail::KeyErrorWithSimilarKeys(pimpl_->config_root, key);
+  if (!detail::ContainsKey(pimpl_->Root(), key)) {
+    throw pimpl_->MissingKey(key);
   }
 
-  const auto &node = pimpl_->config_root.at_path(key);
+  const auto &node = pimpl_->Root().at_path(key);
   if (!node.is_string()) {
     std::string msg{"Parameter `"};
     msg += key;
@@ -1951,9 +3515,9 @@ void Configuration::LoadNestedConfiguration(std::string_view key) {
 
   const auto path = detail::SplitTomlPath(key);
 
-  toml::table *parent = path.first.empty()
-                          ? &pimpl_->config_root
-                          : pimpl_->config_root.at_path(path.first).as_table();
+  toml::table &root = pimpl_->MutableRoot(key);
+  toml::table *parent =
+      path.first.empty() ? &root : root.at_path(path.first).as_table();
   if ((parent == nullptr) || (path.second[path.second.length() - 1] == ']')) {
     std::string msg{"The parent of parameter `"};
     msg += key;
@@ -1964,8 +3528,9 @@ void Configuration::LoadNestedConfiguration(std::string_view key) {
   }
 
   parent->erase(path.second);
+  pimpl_->BumpGeneration();
 
-  const auto result = parent->insert(path.second, loaded.pimpl_->config_root);
+  const auto result = parent->insert(path.second, loaded.pimpl_->Root());
 
   // LCOV_EXCL_START
   if (!result.second) {
@@ -1977,31 +3542,214 @@ void Configuration::LoadNestedConfiguration(std::string_view key) {
   // LCOV_EXCL_STOP
 }
 
+namespace detail {
+/// @brief A string parameter which refers to a nested configuration file.
+struct NestedInclude {
+  /// Fully qualified parameter name.
+  std::string key{};
+
+  /// Index into the list of (unique) files to be loaded.
+  std::size_t file_index{0};
+};
+
+/// @brief Collects all string parameters within the given container node
+///   which match the given patterns. Returns them in traversal order, i.e.
+///   sorted by their parameter names.
+// NOLINTNEXTLINE(misc-no-recursion)
+void CollectNestedIncludes(const toml::node &node,
+    const KeyPath &path,
+    const KeyMatcher &matcher,
+    std::string &buffer,
+    std::vector<std::pair<std::string, std::string>> &includes) {
+  if (const auto *tbl = node.as_table()) {
+    for (auto &&[key, value] : *tbl) {
+      const KeyPath fqn{path, key.str()};
+      if (value.is_table() || value.is_array()) {
+        CollectNestedIncludes(value, fqn, matcher, buffer, includes);
+      } else if (value.is_string() && matcher.Match(fqn.Format(buffer))) {
+        includes.emplace_back(buffer, std::string{*value.as_string()});
+      }
+    }
+  } else if (const auto *arr = node.as_array()) {
+    std::size_t index{0};
+    for (const auto &value : *arr) {
+      const KeyPath fqn{path, index};
+      if (value.is_table() || value.is_array()) {
+        CollectNestedIncludes(value, fqn, matcher, buffer, includes);
+      } else if (value.is_string() && matcher.Match(fqn.Format(buffer))) {
+        std::string msg{"The parent of parameter `"};
+        msg += buffer;
+        msg +=
+            "` to load a nested configuration must be the root or a table "
+            "node!";
+        throw TypeError{msg};
+      }
+      ++index;
+    }
+  }
+}
+}  // namespace detail
+
+struct NestedConfigurationCache::Impl {
+  std::mutex mutex{};
+  std::map<std::string, std::pair<detail::FileState, Configuration>>
+      entries{};
+
+  /// Loads the file, or returns the cached configuration if the file has
+  /// not been modified since it was parsed.
+  Configuration Load(const std::string &filename,
+      const std::string &canonical) {
+    if (canonical.empty()) {
+      // Cannot be resolved, thus `LoadFile` will raise the `ParseError`.
+      return LoadFile(filename);
+    }
+
+    // Query the state before parsing. If the file is modified while we
+    // parse it, the next lookup will thus detect the change.
+    const detail::FileState state = detail::FileState::Query(canonical);
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      const auto it = entries.find(canonical);
+      if ((it != entries.end()) && (it->second.first == state)) {
+        // Copies share the parameters, i.e. this is cheap.
+        return it->second.second;
+      }
+    }
+
+    Configuration cfg = LoadFile(filename);
+    std::lock_guard<std::mutex> lock{mutex};
+    entries.insert_or_assign(canonical, std::make_pair(state, cfg));
+    return cfg;
+  }
+};
+
+NestedConfigurationCache::NestedConfigurationCache()
+    : pimpl_{std::make_unique<Impl>()} {}
+
+NestedConfigurationCache::~NestedConfigurationCache() = default;
+
+NestedConfigurationCache::NestedConfigurationCache(
+    NestedConfigurationCache &&) noexcept = default;
+
+NestedConfigurationCache &NestedConfigurationCache::operator=(
+    NestedConfigurationCache &&) noexcept = default;
+
+std::size_t NestedConfigurationCache::Size() const {
+  std::lock_guard<std::mutex> lock{pimpl_->mutex};
+  return pimpl_->entries.size();
+}
+
+void NestedConfigurationCache::Clear() {
+  std::lock_guard<std::mutex> lock{pimpl_->mutex};
+  pimpl_->entries.clear();
+}
+
+bool Configuration::LoadNestedConfigurations(const KeyMatcher &keys) {
+  // A temporary cache still ensures that each file is parsed only once.
+  NestedConfigurationCache cache{};
+  return LoadNestedConfigurations(keys, cache);
+}
+
+bool Configuration::LoadNestedConfigurations(const KeyMatcher &keys,
+    NestedConfigurationCache &cache) {
+  using namespace std::string_view_literals;
+  // Collect all includes within a single (read-only) traversal.
+  std::vector<std::pair<std::string, std::string>> params{};
+  std::string fqn_buffer{};
+  detail::CollectNestedIncludes(pimpl_->Root(), detail::KeyPath{""sv}, keys,
+      fqn_buffer, params);
+  if (params.empty()) {
+    return false;
+  }
+
+  // Each file is only loaded once, even if it is included multiple times.
+  std::vector<detail::NestedInclude> includes{};
+  std::vector<std::pair<std::string, std::string>> files{};
+  std::map<std::string, std::size_t> file_indices{};
+  for (auto &param : params) {
+    std::string canonical = detail::CanonicalPath(param.second);
+    const std::string &lookup = canonical.empty() ? param.second : canonical;
+    const auto it = file_indices.find(lookup);
+    if (it != file_indices.end()) {
+      includes.push_back({std::move(param.first), it->second});
+    } else {
+      file_indices.emplace(lookup, files.size());
+      includes.push_back({std::move(param.first), files.size()});
+      files.emplace_back(std::move(param.second), std::move(canonical));
+    }
+  }
+
+  // Load the files concurrently. Errors are raised in the order of the
+  // parameter names, such that the reported error is deterministic, too.
+  std::vector<Configuration> loaded(files.size());
+  std::vector<std::exception_ptr> errors(files.size());
+  detail::ParallelFor(files.size(), [&](std::size_t idx) -> void {
+    try {
+      // Use the original name, as the file type is deduced from its
+      // extension.
+      loaded[idx] = cache.pimpl_->Load(files[idx].first, files[idx].second);
+    } catch (...) {
+      errors[idx] = std::current_exception();
+    }
+  });
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Replace the file name parameters by the loaded configurations.
+  toml::table &root = pimpl_->MutableRoot();
+  for (const auto &include : includes) {
+    const auto path = detail::SplitTomlPath(include.key);
+    toml::table *parent =
+        path.first.empty() ? &root : root.at_path(path.first).as_table();
+    parent->erase(path.second);
+    parent->insert(path.second, loaded[include.file_index].pimpl_->Root());
+  }
+  pimpl_->BumpGeneration();
+  return true;
+}
+
 //---------------------------------------------------------------------------
 // Serialization
 
 std::string Configuration::ToTOML() const {
   std::ostringstream repr;
-  repr << toml::toml_formatter{pimpl_->config_root};
+  WriteTOML(repr);
   return repr.str();
 }
 
 std::string Configuration::ToJSON() const {
   std::ostringstream repr;
-  repr << toml::json_formatter{
-      pimpl_->config_root, toml::json_formatter::default_flags};
+  WriteJSON(repr);
   return repr.str();
 }
 
 std::string Configuration::ToYAML() const {
   std::ostringstream repr;
-  repr << toml::yaml_formatter{
-      pimpl_->config_root, toml::yaml_formatter::default_flags};
+  WriteYAML(repr);
   return repr.str();
 }
 
 std::string Configuration::ToLibconfig() const {
-  return DumpLibconfigString(*this);
+  std::ostringstream repr;
+  WriteLibconfig(repr);
+  return repr.str();
+}
+
+void Configuration::WriteTOML(std::ostream &out) const {
+  out << toml::toml_formatter{pimpl_->Root()};
+}
+
+void Configuration::WriteJSON(std::ostream &out) const {
+  out << toml::json_formatter{
+      pimpl_->Root(), toml::json_formatter::default_flags};
+}
+
+void Configuration::WriteYAML(std::ostream &out) const {
+  out << toml::yaml_formatter{
+      pimpl_->Root(), toml::yaml_formatter::default_flags};
 }
 
 void Configuration::HandleNullValue(Configuration &cfg,
@@ -2064,6 +3812,16 @@ Configuration LoadFile(std::string_view filename) {
   throw ParseError{msg};
 }
 
+//---------------------------------------------------------------------------
+// Error messages
+void EnableKeySuggestions(bool enable) {
+  detail::KeySuggestionsFlag().store(enable, std::memory_order_relaxed);
+}
+
+bool AreKeySuggestionsEnabled() {
+  return detail::KeySuggestionsFlag().load(std::memory_order_relaxed);
+}
+
 #undef WZK_CONFIG_LOOKUP_RAISE_PATH_CREATION_ERROR
 #undef WZK_CONFIG_LOOKUP_RAISE_ASSIGNMENT_ERROR
 }  // namespace werkzeugkiste::config
@@ -0,0 +1,25 @@
+#ifndef WERKZEUGKISTE_CONFIG_CONFIGURATION_ACCESS_H
+#define WERKZEUGKISTE_CONFIG_CONFIGURATION_ACCESS_H
+
+// NOLINTBEGIN
+#define TOML_ENABLE_FORMATTERS 1
+#include <toml++/toml.h>
+// NOLINTEND
+
+#include <werkzeugkiste/config/configuration.h>
+
+/// Internal utilities which need direct access to the TOML table that backs a
+/// `Configuration`, e.g. the parsers and serializers. This header must not be
+/// installed, as it exposes the internally used TOML library.
+namespace werkzeugkiste::config::detail {
+/// @brief Grants library internals access to the underlying TOML table.
+struct ConfigurationAccess {
+  /// @brief Returns a configuration which takes ownership of the given table.
+  static Configuration FromTable(toml::table &&tbl);
+
+  /// @brief Returns the root table of the configuration.
+  static const toml::table &Root(const Configuration &cfg);
+};
+}  // namespace werkzeugkiste::config::detail
+
+#endif  // WERKZEUGKISTE_CONFIG_CONFIGURATION_ACCESS_H
@@ -0,0 +1,323 @@
+#ifndef WERKZEUGKISTE_CONFIG_CONTENT_HASH_H
+#define WERKZEUGKISTE_CONFIG_CONTENT_HASH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "configuration_access.h"
+
+/// Internal utilities to compute structural content hashes of parameter
+/// trees, see `Configuration::Hash`.
+namespace werkzeugkiste::config::detail {
+/// @brief Type tags of the hashed nodes. These must never change, as the
+///   hashes are meant to be stable across library versions.
+enum class HashTag : uint64_t {
+  Group = 1,
+  List = 2,
+  String = 3,
+  Integer = 4,
+  FloatingPoint = 5,
+  Boolean = 6,
+  Date = 7,
+  Time = 8,
+  DateTime = 9
+};
+
+/// @brief Seed of all hashes (the 64-bit golden ratio).
+constexpr uint64_t kHashSeed{0x9E3779B97F4A7C15ULL};
+
+/// @brief Scrambles all bits of the value (finalizer of SplitMix64).
+constexpr uint64_t MixHash(uint64_t value) {
+  value ^= value >> 30U;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27U;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31U;
+  return value;
+}
+
+/// @brief Combines the hash with the given value (order-dependent).
+constexpr uint64_t CombineHash(uint64_t hash, uint64_t value) {
+  return MixHash(hash ^ (value + kHashSeed + (hash << 6U) + (hash >> 2U)));
+}
+
+/// @brief Starts the hash of a node of the given type.
+constexpr uint64_t TagHash(HashTag tag, uint64_t value) {
+  return CombineHash(static_cast<uint64_t>(tag), value);
+}
+
+/// @brief Loads 8 bytes in little-endian order, *i.e.* independent of the
+///   platform's byte order.
+inline uint64_t LoadLittleEndian(const char *bytes, std::size_t num_bytes) {
+  uint64_t value{0};
+  for (std::size_t idx = num_bytes; idx > 0; --idx) {
+    value = (value << 8U) | static_cast<unsigned char>(bytes[idx - 1]);
+  }
+  return value;
+}
+
+/// @brief Returns the hash of the given string.
+inline uint64_t HashString(std::string_view str) {
+  uint64_t hash = MixHash(kHashSeed + str.length());
+  std::size_t pos = 0;
+  for (; pos + 8 <= str.length(); pos += 8) {
+    hash = CombineHash(hash, LoadLittleEndian(str.data() + pos, 8));
+  }
+  if (pos < str.length()) {
+    hash = CombineHash(
+        hash, LoadLittleEndian(str.data() + pos, str.length() - pos));
+  }
+  return hash;
+}
+
+/// @brief Returns the hash of a floating point value. As for the equality
+///   comparison, all NaNs are considered equal and so are 0 and -0.
+inline uint64_t HashDouble(double value) {
+  if (std::isnan(value)) {
+    value = std::numeric_limits<double>::quiet_NaN();
+  } else if (value == 0.0) {
+    value = 0.0;
+  }
+  uint64_t bits{0};
+  static_assert(sizeof(bits) == sizeof(value));
+  std::memcpy(&bits, &value, sizeof(bits));
+  return TagHash(HashTag::FloatingPoint, bits);
+}
+
+inline uint64_t HashDate(const toml::date &value) {
+  return TagHash(HashTag::Date,
+      (static_cast<uint64_t>(value.year) << 16U) |
+          (static_cast<uint64_t>(value.month) << 8U) |
+          static_cast<uint64_t>(value.day));
+}
+
+inline uint64_t HashTime(const toml::time &value) {
+  return TagHash(HashTag::Time,
+      (static_cast<uint64_t>(value.hour) << 48U) |
+          (static_cast<uint64_t>(value.minute) << 40U) |
+          (static_cast<uint64_t>(value.second) << 32U) |
+          static_cast<uint64_t>(value.nanosecond));
+}
+
+inline uint64_t HashDateTime(const toml::date_time &value) {
+  uint64_t hash = CombineHash(
+      static_cast<uint64_t>(HashTag::DateTime), HashDate(value.date));
+  hash = CombineHash(hash, HashTime(value.time));
+  // Local date times (without offset) differ from UTC ones.
+  const uint64_t offset =
+      value.offset.has_value()
+          ? (static_cast<uint64_t>(
+                 static_cast<int64_t>(value.offset->minutes)) +
+                1)
+          : 0;
+  return CombineHash(hash, offset);
+}
+
+/// @brief Memoized hashes of the groups of a single parameter tree.
+///
+/// A cache is shared by all configurations which share the same tree (see
+/// `Configuration::Impl`). Groups are identified by their address, thus,
+/// the hashes of all groups which may have been modified or destroyed must be
+/// invalidated. As the tree may only be modified while it is not shared, the
+/// invalidation doesn't need to be synchronized.
+class HashCache {
+ public:
+  /// @brief Returns the hash of the given node. The memoized hashes are
+  ///   reused and the missing ones will be added.
+  uint64_t Hash(const toml::node &node) const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return HashNode(node, hashes_);
+  }
+
+  /// @brief Same as `Hash(node)`, but the groups which are not yet memoized
+  ///   are hashed concurrently.
+  ///
+  /// The tree is split level by level into (at least `min_jobs`) groups,
+  /// see `SplitGroups`. These are hashed via `parallel_for(num_jobs, func)`,
+  /// which must invoke `func(idx)` for each job index. Afterwards, the
+  /// levels above are combined serially from the memoized hashes.
+  template <typename ParallelFor>
+  uint64_t Hash(const toml::node &node,
+      std::size_t min_jobs,
+      ParallelFor &&parallel_for) const {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    const std::vector<const toml::table *> jobs = SplitGroups(node, min_jobs);
+    if (jobs.size() > 1) {
+      // While the jobs run, the shared memo is only read.
+      std::vector<HashMap> memos(jobs.size());
+      parallel_for(jobs.size(), [&](std::size_t idx) -> void {
+        HashTable(*jobs[idx], memos[idx]);
+      });
+      for (const auto &memo : memos) {
+        hashes_.insert(memo.begin(), memo.end());
+      }
+    }
+    return HashNode(node, hashes_);
+  }
+
+  /// @brief Forgets all memoized hashes.
+  void Clear() { hashes_.clear(); }
+
+  /// @brief Forgets the memoized hashes of all groups which contain the
+  ///   given parameter, and of all groups below it.
+  void Invalidate(const toml::table &root, std::string_view key) {
+    if (hashes_.empty()) {
+      return;
+    }
+
+    hashes_.erase(&root);
+    for (std::size_t pos = 1; pos < key.length(); ++pos) {
+      if ((key[pos] == '.') || (key[pos] == '[')) {
+        const toml::node *parent = root.at_path(key.substr(0, pos)).node();
+        if ((parent != nullptr) && parent->is_table()) {
+          hashes_.erase(parent->as_table());
+        }
+      }
+    }
+
+    if (!key.empty()) {
+      const toml::node *node = root.at_path(key).node();
+      if (node != nullptr) {
+        InvalidateSubtree(*node);
+      }
+    }
+  }
+
+ private:
+  using HashMap = std::unordered_map<const toml::table *, uint64_t>;
+
+  /// @brief Maximum depth up to which `SplitGroups` descends.
+  static constexpr std::size_t kMaxSplitDepth{4};
+
+  mutable std::mutex mutex_{};
+  mutable HashMap hashes_{};
+
+  /// Collects the groups (which are not yet memoized) below the node, level
+  /// by level, until there are at least `min_jobs` groups or the maximum
+  /// depth is reached. A group without nested groups is not split further.
+  std::vector<const toml::table *> SplitGroups(const toml::node &node,
+      std::size_t min_jobs) const {
+    std::vector<const toml::table *> jobs{};
+    AddGroups(node, jobs);
+    std::vector<const toml::table *> next{};
+    for (std::size_t depth = 0;
+         (depth < kMaxSplitDepth) && (jobs.size() < min_jobs);
+         ++depth) {
+      next.clear();
+      bool split = false;
+      for (const toml::table *tbl : jobs) {
+        const std::size_t num_groups = next.size();
+        for (auto &&[key, value] : *tbl) {
+          AddGroups(value, next);
+        }
+        if (next.size() == num_groups) {
+          next.push_back(tbl);
+        } else {
+          split = true;
+        }
+      }
+      jobs.swap(next);
+      if (!split) {
+        break;
+      }
+    }
+    return jobs;
+  }
+
+  /// Adds the node (if it is a group), or the groups contained in the node
+  /// (if it is a list), unless they are already memoized.
+  // NOLINTNEXTLINE(misc-no-recursion)
+  void AddGroups(const toml::node &node,
+      std::vector<const toml::table *> &groups) const {
+    if (const toml::table *tbl = node.as_table()) {
+      if (hashes_.find(tbl) == hashes_.end()) {
+        groups.push_back(tbl);
+      }
+    } else if (const toml::array *arr = node.as_array()) {
+      for (const auto &value : *arr) {
+        AddGroups(value, groups);
+      }
+    }
+  }
+
+  // NOLINTNEXTLINE(misc-no-recursion)
+  void InvalidateSubtree(const toml::node &node) {
+    if (const toml::table *tbl = node.as_table()) {
+      hashes_.erase(tbl);
+      for (auto &&[key, value] : *tbl) {
+        InvalidateSubtree(value);
+      }
+    } else if (const toml::array *arr = node.as_array()) {
+      for (const auto &value : *arr) {
+        InvalidateSubtree(value);
+      }
+    }
+  }
+
+  /// Returns the hash of the node. Hashes of groups are looked up in the
+  /// shared memo, and newly computed ones are added to the given `memo`.
+  // NOLINTNEXTLINE(misc-no-recursion)
+  uint64_t HashNode(const toml::node &node, HashMap &memo) const {
+    switch (node.type()) {
+      case toml::node_type::table:
+        return HashTable(*node.as_table(), memo);
+      case toml::node_type::array: {
+        const toml::array &arr = *node.as_array();
+        uint64_t hash = TagHash(HashTag::List, arr.size());
+        for (const auto &value : arr) {
+          hash = CombineHash(hash, HashNode(value, memo));
+        }
+        return hash;
+      }
+      case toml::node_type::string:
+        return TagHash(HashTag::String,
+            HashString(node.as_string()->get()));
+      case toml::node_type::integer:
+        return TagHash(HashTag::Integer,
+            static_cast<uint64_t>(node.as_integer()->get()));
+      case toml::node_type::floating_point:
+        return HashDouble(node.as_floating_point()->get());
+      case toml::node_type::boolean:
+        return TagHash(HashTag::Boolean, node.as_boolean()->get() ? 1 : 0);
+      case toml::node_type::date:
+        return HashDate(node.as_date()->get());
+      case toml::node_type::time:
+        return HashTime(node.as_time()->get());
+      case toml::node_type::date_time:
+        return HashDateTime(node.as_date_time()->get());
+      default:
+        // LCOV_EXCL_START
+        return 0;
+        // LCOV_EXCL_STOP
+    }
+  }
+
+  /// The parameters of a group are combined by a commutative sum, i.e. the
+  /// hash does not depend on their order.
+  // NOLINTNEXTLINE(misc-no-recursion)
+  uint64_t HashTable(const toml::table &tbl, HashMap &memo) const {
+    const auto it = hashes_.find(&tbl);
+    if (it != hashes_.end()) {
+      return it->second;
+    }
+
+    uint64_t sum{0};
+    for (auto &&[key, value] : tbl) {
+      sum += MixHash(
+          CombineHash(HashString(key.str()), HashNode(value, memo)));
+    }
+    const uint64_t hash =
+        CombineHash(TagHash(HashTag::Group, tbl.size()), sum);
+    memo.emplace(&tbl, hash);
+    return hash;
+  }
+};
+}  // namespace werkzeugkiste::config::detail
+
+#endif  // WERKZEUGKISTE_CONFIG_CONTENT_HASH_H
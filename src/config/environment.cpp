@@ -0,0 +1,143 @@
+#include <werkzeugkiste/config/configuration.h>
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "configuration_access.h"
+
+#if defined(_WIN32)
+// NOLINTNEXTLINE(*-macro-usage)
+#define WZK_ENVIRON _environ
+#elif defined(__APPLE__)
+// Shared libraries on macOS cannot access `environ` directly.
+#include <crt_externs.h>
+// NOLINTNEXTLINE(*-macro-usage)
+#define WZK_ENVIRON (*_NSGetEnviron())
+#else
+extern char **environ;  // NOLINT
+// NOLINTNEXTLINE(*-macro-usage)
+#define WZK_ENVIRON environ
+#endif
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// @brief Separates the prefix and the group names of an environment variable.
+constexpr std::string_view kEnvironmentSeparator{"__"};
+
+/// @brief Parses the value of an environment variable as TOML value.
+///
+/// Returns the parsed configuration, which holds the single parameter
+/// `value`, or an empty configuration if the variable does not hold a valid
+/// TOML value - it should then be used as a string.
+Configuration ParseEnvironmentValue(std::string_view value) {
+  std::string toml_str{"value = "};
+  toml_str += value;
+  try {
+    Configuration cfg = LoadTOMLString(toml_str);
+    // A multi-line variable could define additional parameters.
+    if (cfg.Size() == 1) {
+      return cfg;
+    }
+  } catch (const ParseError &) {
+    // Not a valid TOML value, will be used as a string.
+  }
+  return Configuration{};
+}
+
+/// @brief Inserts the parameter for a single environment variable.
+/// @param root The configuration which is being built.
+/// @param variable Full name of the environment variable (for error
+///   messages).
+/// @param name Name of the environment variable without the prefix, *e.g.*
+///   `camera__fps`.
+/// @param value Value of the environment variable.
+void InsertEnvironmentVariable(toml::table &root,
+    std::string_view variable,
+    std::string_view name,
+    std::string_view value) {
+  std::vector<std::string_view> segments{};
+  std::size_t start = 0;
+  while (true) {
+    const std::size_t end = name.find(kEnvironmentSeparator, start);
+    segments.push_back(name.substr(start, end - start));
+    if (end == std::string_view::npos) {
+      break;
+    }
+    start = end + kEnvironmentSeparator.length();
+  }
+
+  auto conflict = [variable](std::string_view reason) -> ParseError {
+    std::string msg{"Cannot load environment variable `"};
+    msg += variable;
+    msg += "`, because ";
+    msg += reason;
+    msg += '!';
+    return ParseError{msg};
+  };
+
+  toml::table *tbl = &root;
+  for (std::size_t idx = 0; idx < segments.size(); ++idx) {
+    const std::string_view segment = segments[idx];
+    if (segment.empty()) {
+      throw conflict("its name contains an empty group/parameter name");
+    }
+
+    toml::node *node = tbl->get(segment);
+    if (idx + 1 < segments.size()) {
+      if (node == nullptr) {
+        auto result = tbl->insert(segment, toml::table{});
+        tbl = (*result.first).second.as_table();
+      } else if (node->is_table()) {
+        tbl = node->as_table();
+      } else {
+        throw conflict("a parent parameter is already defined");
+      }
+    } else {
+      if (node != nullptr) {
+        throw conflict("the parameter is already defined");
+      }
+
+      const Configuration parsed = ParseEnvironmentValue(value);
+      if (parsed.Empty()) {
+        tbl->insert(segment, std::string{value});
+      } else {
+        tbl->insert(
+            segment, *ConfigurationAccess::Root(parsed).get("value"));
+      }
+    }
+  }
+}
+}  // namespace detail
+
+Configuration LoadEnvironment(std::string_view prefix) {
+  std::string var_prefix{prefix};
+  var_prefix += detail::kEnvironmentSeparator;
+
+  toml::table root{};
+  for (char **env = WZK_ENVIRON; (env != nullptr) && (*env != nullptr);
+       ++env) {
+    const std::string_view entry{*env};
+    if ((entry.length() <= var_prefix.length()) ||
+        (entry.substr(0, var_prefix.length()) != var_prefix)) {
+      continue;
+    }
+
+    const std::size_t assign = entry.find('=');
+    if ((assign == std::string_view::npos) ||
+        (assign <= var_prefix.length())) {
+      continue;
+    }
+
+    detail::InsertEnvironmentVariable(root,
+        entry.substr(0, assign),
+        entry.substr(var_prefix.length(), assign - var_prefix.length()),
+        entry.substr(assign + 1));
+  }
+  return detail::ConfigurationAccess::FromTable(std::move(root));
+}
+}  // namespace werkzeugkiste::config
+
+#undef WZK_ENVIRON
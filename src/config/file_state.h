@@ -0,0 +1,71 @@
+#ifndef WERKZEUGKISTE_CONFIG_FILE_STATE_H
+#define WERKZEUGKISTE_CONFIG_FILE_STATE_H
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#ifndef _WIN32
+#include <climits>
+#endif  // _WIN32
+
+/// Internal file system utilities of the configuration module, used to detect
+/// modified (nested) configuration files.
+namespace werkzeugkiste::config::detail {
+/// @brief Modification state of a file.
+struct FileState {
+  bool exists{false};
+  int64_t size{0};
+  int64_t mtime_ns{0};
+
+  static FileState Query(const std::string &filename) {
+    FileState state{};
+    struct stat info {};
+    if (stat(filename.c_str(), &info) == 0) {
+      state.exists = true;
+      state.size = static_cast<int64_t>(info.st_size);
+#if defined(__APPLE__)
+      state.mtime_ns =
+          static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 +
+          info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+      state.mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+                       info.st_mtim.tv_nsec;
+#else
+      state.mtime_ns = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+    }
+    return state;
+  }
+
+  bool operator==(const FileState &other) const {
+    return (exists == other.exists) && (size == other.size) &&
+           (mtime_ns == other.mtime_ns);
+  }
+
+  bool operator!=(const FileState &other) const { return !(*this == other); }
+};
+
+/// @brief Returns the canonical (absolute, symlink-free) path of an existing
+///   file, or an empty string if it cannot be resolved.
+inline std::string CanonicalPath(const std::string &filename) {
+#ifdef _WIN32
+  char buffer[_MAX_PATH];
+  if (_fullpath(buffer, filename.c_str(), _MAX_PATH) == nullptr) {
+    return {};
+  }
+  return std::string{buffer};
+#else   // _WIN32
+  char buffer[PATH_MAX];
+  if (realpath(filename.c_str(), buffer) == nullptr) {
+    return {};
+  }
+  return std::string{buffer};
+#endif  // _WIN32
+}
+}  // namespace werkzeugkiste::config::detail
+
+#endif  // WERKZEUGKISTE_CONFIG_FILE_STATE_H
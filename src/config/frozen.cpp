@@ -0,0 +1,722 @@
+#include <werkzeugkiste/config/casts.h>
+#include <werkzeugkiste/config/frozen.h>
+#include <werkzeugkiste/strings/strings.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "configuration_access.h"
+
+namespace werkzeugkiste::config {
+/// @brief Flat representation of the parameter tree.
+struct FrozenConfiguration::Impl {
+  /// @brief Location of a string value within `strings`.
+  struct StringRef {
+    std::size_t offset;
+    std::size_t length;
+  };
+
+  using Value = std::variant<std::monostate,
+      bool,
+      int64_t,
+      double,
+      StringRef,
+      date,
+      time,
+      date_time>;
+
+  /// @brief A single parameter. The children of a list or group are stored
+  ///   contiguously, starting at `first_child`.
+  struct Node {
+    ConfigType type{ConfigType::Group};
+    std::size_t first_child{0};
+    std::size_t size{0};
+    Value value{};
+  };
+
+  /// Parameter nodes, the root group is the first element.
+  std::vector<Node> nodes{Node{}};
+
+  /// Concatenation of all string values.
+  std::string strings{};
+
+  /// Concatenation of all fully qualified parameter names.
+  std::string keys{};
+
+  /// Fully qualified names of all named parameters (views into `keys`),
+  /// sorted lexicographically, and the corresponding node index.
+  std::vector<std::pair<std::string_view, std::size_t>> index{};
+
+  /// @brief Returns the node index of the given parameter.
+  std::optional<std::size_t> Find(std::string_view key) const {
+    if (key.empty()) {
+      return 0;
+    }
+
+    const auto it = std::lower_bound(index.begin(),
+        index.end(),
+        key,
+        [](const std::pair<std::string_view, std::size_t> &entry,
+            std::string_view k) { return entry.first < k; });
+    if ((it != index.end()) && (it->first == key)) {
+      return it->second;
+    }
+
+    // List elements are not indexed, instead we look up the list and then
+    // select the element.
+    if (key.back() != ']') {
+      return std::nullopt;
+    }
+    const std::size_t bracket = key.rfind('[');
+    if ((bracket == std::string_view::npos) || (bracket == 0)) {
+      return std::nullopt;
+    }
+
+    const std::string_view digits =
+        key.substr(bracket + 1, key.length() - bracket - 2);
+    std::size_t element{};
+    const auto result =
+        std::from_chars(digits.data(), digits.data() + digits.size(), element);
+    if ((result.ec != std::errc{}) ||
+        (result.ptr != digits.data() + digits.size())) {
+      return std::nullopt;
+    }
+
+    const auto list = Find(key.substr(0, bracket));
+    if (!list.has_value() || (nodes[*list].type != ConfigType::List) ||
+        (element >= nodes[*list].size)) {
+      return std::nullopt;
+    }
+    return nodes[*list].first_child + element;
+  }
+
+  /// @brief Returns the node of the given parameter or raises a `KeyError`.
+  const Node &Lookup(std::string_view key) const {
+    const auto idx = Find(key);
+    if (!idx.has_value()) {
+      throw MissingKey(key);
+    }
+    return nodes[*idx];
+  }
+
+  /// Maximum edit distance (exclusive) of suggested keys, same as for the
+  /// `Configuration` lookups.
+  static constexpr std::size_t kMaxSuggestionDistance{3};
+
+  /// @brief Prepares a `KeyError` which suggests the most similar parameter
+  ///   names, unless disabled via `EnableKeySuggestions`.
+  ///
+  /// A snapshot is usually queried for existing keys, thus we simply
+  /// compare the key against all names instead of maintaining an index.
+  KeyError MissingKey(std::string_view key) const {
+    std::string msg{"Key `"};
+    msg += key;
+    msg += "` does not exist!";
+    if (!AreKeySuggestionsEnabled()) {
+      return KeyError{msg};
+    }
+
+    // Pairs of <edit distance, position in the index>.
+    std::vector<std::pair<std::size_t, std::size_t>> similar{};
+    for (std::size_t rank = 0; rank < index.size(); ++rank) {
+      const std::string_view cand = index[rank].first;
+      if (werkzeugkiste::strings::LengthDifference(key, cand) <
+          kMaxSuggestionDistance) {
+        const std::size_t distance =
+            werkzeugkiste::strings::LevenshteinDistance(key, cand);
+        if (distance < kMaxSuggestionDistance) {
+          similar.emplace_back(distance, rank);
+        }
+      }
+    }
+
+    if (!similar.empty()) {
+      std::sort(similar.begin(), similar.end());
+      msg += " Did you mean: `";
+      const std::size_t num_to_include =
+          std::min(similar.size(), static_cast<std::size_t>(3));
+      for (std::size_t idx = 0; idx < num_to_include; ++idx) {
+        msg += index[similar[idx].second].first;
+        if (idx < num_to_include - 1) {
+          msg += "`, `";
+        }
+      }
+      msg += "`?";
+    }
+    return KeyError{msg};
+  }
+
+  std::string_view String(const StringRef &ref) const {
+    return std::string_view{strings}.substr(ref.offset, ref.length);
+  }
+
+  /// @brief Converts a TOML tree into the flat representation.
+  class Flattener {
+   public:
+    explicit Flattener(Impl &impl) : impl_{impl} {}
+
+    void Run(const toml::table &root) {
+      AddGroup(0, root);
+
+      impl_.index.reserve(entries_.size());
+      for (const auto &entry : entries_) {
+        impl_.index.emplace_back(
+            std::string_view{impl_.keys}.substr(entry.offset, entry.length),
+            entry.node);
+      }
+      std::sort(impl_.index.begin(), impl_.index.end());
+    }
+
+   private:
+    struct Entry {
+      std::size_t offset;
+      std::size_t length;
+      std::size_t node;
+    };
+
+    Impl &impl_;
+    std::vector<Entry> entries_{};
+    std::string path_{};
+
+    /// Reserves a contiguous block for the children of the given container.
+    std::size_t AddChildren(std::size_t parent, std::size_t num_children) {
+      const std::size_t first = impl_.nodes.size();
+      impl_.nodes.resize(first + num_children);
+      impl_.nodes[parent].first_child = first;
+      impl_.nodes[parent].size = num_children;
+      return first;
+    }
+
+    void AddGroup(std::size_t parent, const toml::table &tbl) {
+      std::size_t idx = AddChildren(parent, tbl.size());
+      const std::size_t path_length = path_.length();
+      for (auto &&[key, value] : tbl) {
+        if (path_length > 0) {
+          path_ += '.';
+        }
+        path_ += key.str();
+        entries_.push_back(Entry{impl_.keys.length(), path_.length(), idx});
+        impl_.keys += path_;
+
+        AddNode(idx, value);
+        path_.resize(path_length);
+        ++idx;
+      }
+    }
+
+    void AddList(std::size_t parent, const toml::array &arr) {
+      std::size_t idx = AddChildren(parent, arr.size());
+      const std::size_t path_length = path_.length();
+      for (auto &&value : arr) {
+        path_ += '[';
+        path_ += std::to_string(idx - impl_.nodes[parent].first_child);
+        path_ += ']';
+
+        AddNode(idx, value);
+        path_.resize(path_length);
+        ++idx;
+      }
+    }
+
+    /// Sets the node at the given index. Note that `impl_.nodes` may be
+    /// resized, i.e. we must not hold references to its elements.
+    void AddNode(std::size_t idx, const toml::node &node) {
+      switch (node.type()) {
+        case toml::node_type::table:
+          impl_.nodes[idx].type = ConfigType::Group;
+          AddGroup(idx, *node.as_table());
+          break;
+
+        case toml::node_type::array:
+          impl_.nodes[idx].type = ConfigType::List;
+          AddList(idx, *node.as_array());
+          break;
+
+        case toml::node_type::boolean:
+          Set(idx, ConfigType::Boolean, node.as_boolean()->get());
+          break;
+
+        case toml::node_type::integer:
+          Set(idx, ConfigType::Integer, node.as_integer()->get());
+          break;
+
+        case toml::node_type::floating_point:
+          Set(idx, ConfigType::FloatingPoint, node.as_floating_point()->get());
+          break;
+
+        case toml::node_type::string: {
+          const std::string &str = node.as_string()->get();
+          Set(idx,
+              ConfigType::String,
+              StringRef{
+                  impl_.strings.length(), str.length()});
+          impl_.strings += str;
+          break;
+        }
+
+        case toml::node_type::date: {
+          const toml::date &d = node.as_date()->get();
+          Set(idx, ConfigType::Date, date{d.year, d.month, d.day});
+          break;
+        }
+
+        case toml::node_type::time: {
+          const toml::time &t = node.as_time()->get();
+          Set(idx,
+              ConfigType::Time,
+              time{t.hour, t.minute, t.second, t.nanosecond});
+          break;
+        }
+
+        case toml::node_type::date_time: {
+          const toml::date_time &dt = node.as_date_time()->get();
+          date_time value{date{dt.date.year, dt.date.month, dt.date.day},
+              time{dt.time.hour,
+                  dt.time.minute,
+                  dt.time.second,
+                  dt.time.nanosecond}};
+          if (dt.offset.has_value()) {
+            value.offset = time_offset{dt.offset.value().minutes};
+          }
+          Set(idx, ConfigType::DateTime, value);
+          break;
+        }
+
+        // LCOV_EXCL_START
+        default: {
+          std::string msg{"TOML node type is not supported for parameter `"};
+          msg += path_;
+          msg +=
+              "`! Please report at "
+              "https://github.com/snototter/werkzeugkiste/issues";
+          throw std::logic_error{msg};
+        }
+          // LCOV_EXCL_STOP
+      }
+    }
+
+    template <typename Tp>
+    void Set(std::size_t idx, ConfigType type, Tp &&value) {
+      impl_.nodes[idx].type = type;
+      impl_.nodes[idx].value = std::forward<Tp>(value);
+    }
+  };
+
+  /// @brief Converts a frozen value to the requested type, following the
+  ///   rules of the `Configuration` getters.
+  /// @param key_fn Callable which returns the fully qualified parameter name
+  ///   (only invoked to create an error message).
+  template <typename Tp, typename KeyFn>
+  Tp ConvertValue(const Node &node, const KeyFn &key_fn) const {
+    if constexpr (std::is_same_v<Tp, bool>) {
+      if (const auto *val = std::get_if<bool>(&node.value)) {
+        return *val;
+      }
+    } else if constexpr (std::is_arithmetic_v<Tp>) {
+      try {
+        if (const auto *val = std::get_if<int64_t>(&node.value)) {
+          return checked_numcast<Tp, int64_t>(*val);
+        }
+        if (const auto *val = std::get_if<double>(&node.value)) {
+          return checked_numcast<Tp, double>(*val);
+        }
+      } catch (const std::domain_error &e) {
+        std::string msg{"Cannot convert numeric parameter `"};
+        msg += key_fn();
+        msg += "` to `";
+        msg += TypeName<Tp>();
+        msg += "`. ";
+        msg += e.what();
+        throw TypeError{msg};
+      }
+    } else if constexpr (std::is_same_v<Tp, std::string>) {
+      if (const auto *val = std::get_if<StringRef>(&node.value)) {
+        return std::string{String(*val)};
+      }
+    } else {
+      if (const auto *val = std::get_if<Tp>(&node.value)) {
+        return *val;
+      }
+    }
+
+    std::string msg{"Cannot query `"};
+    msg += ConfigTypeToString(node.type);
+    msg += "` parameter `";
+    msg += key_fn();
+    msg += "` as `";
+    msg += TypeName<Tp>();
+    msg += "`!";
+    throw TypeError{msg};
+  }
+
+  /// @brief Typed getter, raises a `KeyError` if the parameter is missing.
+  template <typename Tp>
+  Tp GetScalar(std::string_view key) const {
+    return ConvertValue<Tp>(Lookup(key), [key]() { return std::string{key}; });
+  }
+
+  /// @brief Typed getter, returns the default if the parameter is missing.
+  template <typename Tp>
+  Tp GetScalarOr(std::string_view key, Tp default_val) const {
+    const auto idx = Find(key);
+    if (!idx.has_value()) {
+      return default_val;
+    }
+    return ConvertValue<Tp>(nodes[*idx], [key]() { return std::string{key}; });
+  }
+
+  /// @brief Typed getter, returns `std::nullopt` if the parameter is
+  ///   missing.
+  template <typename Tp>
+  std::optional<Tp> GetOptional(std::string_view key) const {
+    const auto idx = Find(key);
+    if (!idx.has_value()) {
+      return std::nullopt;
+    }
+    return ConvertValue<Tp>(nodes[*idx], [key]() { return std::string{key}; });
+  }
+
+  /// @brief Returns all elements of a list as the given type.
+  template <typename Tp>
+  std::vector<Tp> GetList(std::string_view key) const {
+    const Node &list = Lookup(key);
+    if (list.type != ConfigType::List) {
+      std::string msg{"Cannot look up element `"};
+      msg += key;
+      msg += "` as a list, because it is of type `";
+      msg += ConfigTypeToString(list.type);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+
+    std::vector<Tp> values{};
+    values.reserve(list.size);
+    for (std::size_t idx = 0; idx < list.size; ++idx) {
+      values.push_back(
+          ConvertValue<Tp>(nodes[list.first_child + idx], [key, idx]() {
+            std::string fqn{key};
+            fqn += '[';
+            fqn += std::to_string(idx);
+            fqn += ']';
+            return fqn;
+          }));
+    }
+    return values;
+  }
+
+  /// @brief Copies the group named `key` into a separate snapshot.
+  std::shared_ptr<const Impl> ExtractGroup(std::string_view key) const {
+    const Node &group = Lookup(key);
+    if (group.type != ConfigType::Group) {
+      std::string msg{"Cannot lookup parameter `"};
+      msg += key;
+      msg += "` as group, because it is a `";
+      msg += ConfigTypeToString(group.type);
+      msg += "`!";
+      throw TypeError{msg};
+    }
+
+    // The flattener adds all descendants of a node before any other node,
+    // i.e. they are stored contiguously after its first child.
+    const std::size_t first = group.first_child;
+    std::size_t last = first + group.size;
+    for (std::size_t idx = first; idx < last; ++idx) {
+      const Node &node = nodes[idx];
+      if ((node.type == ConfigType::Group) ||
+          (node.type == ConfigType::List)) {
+        last = std::max(last, node.first_child + node.size);
+      }
+    }
+
+    auto sub = std::make_shared<Impl>();
+    sub->nodes.reserve(last - first + 1);
+    sub->nodes[0].first_child = 1;
+    sub->nodes[0].size = group.size;
+    for (std::size_t idx = first; idx < last; ++idx) {
+      Node node = nodes[idx];
+      if ((node.type == ConfigType::Group) ||
+          (node.type == ConfigType::List)) {
+        node.first_child = node.first_child - first + 1;
+      } else if (auto *ref = std::get_if<StringRef>(&node.value)) {
+        const std::string_view str = String(*ref);
+        *ref = StringRef{sub->strings.length(), str.length()};
+        sub->strings += str;
+      }
+      sub->nodes.push_back(node);
+    }
+
+    // The index entries of the group's parameters share its name as prefix,
+    // thus they are adjacent and remain sorted without this prefix.
+    std::string prefix{key};
+    if (!prefix.empty()) {
+      prefix += '.';
+    }
+    auto it = std::lower_bound(index.begin(),
+        index.end(),
+        std::string_view{prefix},
+        [](const std::pair<std::string_view, std::size_t> &entry,
+            std::string_view k) { return entry.first < k; });
+    // Pairs of <offset of the name in `keys`, node index>.
+    std::vector<std::pair<std::size_t, std::size_t>> entries{};
+    for (; (it != index.end()) &&
+           (it->first.substr(0, prefix.length()) == prefix);
+         ++it) {
+      entries.emplace_back(sub->keys.length(), it->second - first + 1);
+      sub->keys += it->first.substr(prefix.length());
+    }
+
+    // Views into `keys` can only be created once it is complete.
+    sub->index.reserve(entries.size());
+    for (std::size_t idx = 0; idx < entries.size(); ++idx) {
+      const std::size_t offset = entries[idx].first;
+      const std::size_t end = (idx + 1 < entries.size())
+                                  ? entries[idx + 1].first
+                                  : sub->keys.length();
+      sub->index.emplace_back(
+          std::string_view{sub->keys}.substr(offset, end - offset),
+          entries[idx].second);
+    }
+    return sub;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// FrozenConfiguration
+
+FrozenConfiguration Configuration::Freeze() const {
+  using Impl = FrozenConfiguration::Impl;
+  auto impl = std::make_shared<Impl>();
+  Impl::Flattener{*impl}.Run(detail::ConfigurationAccess::Root(*this));
+  return FrozenConfiguration{std::move(impl)};
+}
+
+FrozenConfiguration::FrozenConfiguration()
+    : pimpl_{std::make_shared<const Impl>()} {}
+
+FrozenConfiguration::FrozenConfiguration(std::shared_ptr<const Impl> data)
+    : pimpl_{std::move(data)} {}
+
+bool FrozenConfiguration::Empty() const { return pimpl_->nodes[0].size == 0; }
+
+bool FrozenConfiguration::Contains(std::string_view key) const {
+  return pimpl_->Find(key).has_value();
+}
+
+std::size_t FrozenConfiguration::Size(std::string_view key) const {
+  const Impl::Node &node = pimpl_->Lookup(key);
+  if ((node.type != ConfigType::List) && (node.type != ConfigType::Group)) {
+    std::string msg{"To query its size, the parameter `"};
+    msg += key;
+    msg += "` must be a list or a group, but it is of type `";
+    msg += ConfigTypeToString(node.type);
+    msg += "`!";
+    throw TypeError{msg};
+  }
+  return node.size;
+}
+
+ConfigType FrozenConfiguration::Type(std::string_view key) const {
+  return pimpl_->Lookup(key).type;
+}
+
+std::vector<std::string> FrozenConfiguration::ListParameterNames() const {
+  std::vector<std::string> names{};
+  names.reserve(pimpl_->index.size());
+  for (const auto &entry : pimpl_->index) {
+    names.emplace_back(entry.first);
+  }
+  return names;
+}
+
+bool FrozenConfiguration::GetBool(std::string_view key) const {
+  return pimpl_->GetScalar<bool>(key);
+}
+
+bool FrozenConfiguration::GetBoolOr(std::string_view key,
+    bool default_val) const {
+  return pimpl_->GetScalarOr<bool>(key, default_val);
+}
+
+std::optional<bool> FrozenConfiguration::GetOptionalBool(
+    std::string_view key) const {
+  return pimpl_->GetOptional<bool>(key);
+}
+
+std::vector<bool> FrozenConfiguration::GetBoolList(std::string_view key) const {
+  return pimpl_->GetList<bool>(key);
+}
+
+int32_t FrozenConfiguration::GetInt32(std::string_view key) const {
+  return pimpl_->GetScalar<int32_t>(key);
+}
+
+int32_t FrozenConfiguration::GetInt32Or(std::string_view key,
+    int32_t default_val) const {
+  return pimpl_->GetScalarOr<int32_t>(key, default_val);
+}
+
+std::optional<int32_t> FrozenConfiguration::GetOptionalInt32(
+    std::string_view key) const {
+  return pimpl_->GetOptional<int32_t>(key);
+}
+
+std::vector<int32_t> FrozenConfiguration::GetInt32List(
+    std::string_view key) const {
+  return pimpl_->GetList<int32_t>(key);
+}
+
+int64_t FrozenConfiguration::GetInt64(std::string_view key) const {
+  return pimpl_->GetScalar<int64_t>(key);
+}
+
+int64_t FrozenConfiguration::GetInt64Or(std::string_view key,
+    int64_t default_val) const {
+  return pimpl_->GetScalarOr<int64_t>(key, default_val);
+}
+
+std::optional<int64_t> FrozenConfiguration::GetOptionalInt64(
+    std::string_view key) const {
+  return pimpl_->GetOptional<int64_t>(key);
+}
+
+std::vector<int64_t> FrozenConfiguration::GetInt64List(
+    std::string_view key) const {
+  return pimpl_->GetList<int64_t>(key);
+}
+
+double FrozenConfiguration::GetDouble(std::string_view key) const {
+  return pimpl_->GetScalar<double>(key);
+}
+
+double FrozenConfiguration::GetDoubleOr(std::string_view key,
+    double default_val) const {
+  return pimpl_->GetScalarOr<double>(key, default_val);
+}
+
+std::optional<double> FrozenConfiguration::GetOptionalDouble(
+    std::string_view key) const {
+  return pimpl_->GetOptional<double>(key);
+}
+
+std::vector<double> FrozenConfiguration::GetDoubleList(
+    std::string_view key) const {
+  return pimpl_->GetList<double>(key);
+}
+
+std::string FrozenConfiguration::GetString(std::string_view key) const {
+  return pimpl_->GetScalar<std::string>(key);
+}
+
+std::string FrozenConfiguration::GetStringOr(std::string_view key,
+    std::string_view default_val) const {
+  return pimpl_->GetScalarOr<std::string>(key, std::string{default_val});
+}
+
+std::optional<std::string> FrozenConfiguration::GetOptionalString(
+    std::string_view key) const {
+  return pimpl_->GetOptional<std::string>(key);
+}
+
+std::vector<std::string> FrozenConfiguration::GetStringList(
+    std::string_view key) const {
+  return pimpl_->GetList<std::string>(key);
+}
+
+date FrozenConfiguration::GetDate(std::string_view key) const {
+  return pimpl_->GetScalar<date>(key);
+}
+
+date FrozenConfiguration::GetDateOr(std::string_view key,
+    const date &default_val) const {
+  return pimpl_->GetScalarOr<date>(key, default_val);
+}
+
+std::optional<date> FrozenConfiguration::GetOptionalDate(
+    std::string_view key) const {
+  return pimpl_->GetOptional<date>(key);
+}
+
+std::vector<date> FrozenConfiguration::GetDateList(
+    std::string_view key) const {
+  return pimpl_->GetList<date>(key);
+}
+
+time FrozenConfiguration::GetTime(std::string_view key) const {
+  return pimpl_->GetScalar<time>(key);
+}
+
+time FrozenConfiguration::GetTimeOr(std::string_view key,
+    const time &default_val) const {
+  return pimpl_->GetScalarOr<time>(key, default_val);
+}
+
+std::optional<time> FrozenConfiguration::GetOptionalTime(
+    std::string_view key) const {
+  return pimpl_->GetOptional<time>(key);
+}
+
+std::vector<time> FrozenConfiguration::GetTimeList(
+    std::string_view key) const {
+  return pimpl_->GetList<time>(key);
+}
+
+date_time FrozenConfiguration::GetDateTime(std::string_view key) const {
+  return pimpl_->GetScalar<date_time>(key);
+}
+
+date_time FrozenConfiguration::GetDateTimeOr(std::string_view key,
+    const date_time &default_val) const {
+  return pimpl_->GetScalarOr<date_time>(key, default_val);
+}
+
+std::optional<date_time> FrozenConfiguration::GetOptionalDateTime(
+    std::string_view key) const {
+  return pimpl_->GetOptional<date_time>(key);
+}
+
+std::vector<date_time> FrozenConfiguration::GetDateTimeList(
+    std::string_view key) const {
+  return pimpl_->GetList<date_time>(key);
+}
+
+FrozenConfiguration FrozenConfiguration::GetGroup(
+    std::string_view key) const {
+  if (key.empty()) {
+    return *this;
+  }
+  return FrozenConfiguration{pimpl_->ExtractGroup(key)};
+}
+
+//-----------------------------------------------------------------------------
+// AtomicFrozenConfiguration
+
+AtomicFrozenConfiguration::AtomicFrozenConfiguration()
+    : AtomicFrozenConfiguration{FrozenConfiguration{}} {}
+
+AtomicFrozenConfiguration::AtomicFrozenConfiguration(
+    const FrozenConfiguration &cfg)
+    : data_{cfg.pimpl_} {}
+
+FrozenConfiguration AtomicFrozenConfiguration::Load() const {
+  return FrozenConfiguration{std::atomic_load(&data_)};
+}
+
+void AtomicFrozenConfiguration::Store(const FrozenConfiguration &cfg) {
+  std::atomic_store(&data_, cfg.pimpl_);
+}
+
+FrozenConfiguration AtomicFrozenConfiguration::Exchange(
+    const FrozenConfiguration &cfg) {
+  return FrozenConfiguration{std::atomic_exchange(&data_, cfg.pimpl_)};
+}
+}  // namespace werkzeugkiste::config
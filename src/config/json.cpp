@@ -2,9 +2,10 @@
 #include <werkzeugkiste/files/fileio.h>
 #include <werkzeugkiste/strings/strings.h>
 
-#include <fstream>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <utility>
 
 // NOLINTBEGIN(*-macro-usage, readability-identifier-naming)
 
@@ -16,210 +17,141 @@
 using json = nlohmann::json;
 // NOLINTEND(*-macro-usage, readability-identifier-naming)
 
+#include "tree_builder.h"
+
 namespace werkzeugkiste::config {
 namespace detail {
-// Forward declaration
-Configuration FromJSONObject(const json &object, NullValuePolicy none_policy);
-
-void AppendListItems(const json &list,
-    Configuration &cfg,
-    std::string_view fqn,
-    NullValuePolicy none_policy);
-
-// LCOV_EXCL_START
-/// @brief Throws a std::logic_error with a hint to report an error.
-/// @param prefix Error message prefix.
-/// @param fqn Fully qualified name of the parameter that caused the error. If
-///   provided, " for parameter `fqn`!" will be appended to the error message.
-/// @throws std::logic_error
-inline void ThrowImplementationError(std::string_view prefix,
-    std::string_view fqn) {
-  std::string msg{prefix};
-  if (!fqn.empty()) {
-    msg += " for parameter `";
-    msg += fqn;
-    msg += "`!";
+/// @brief SAX event handler which builds the configuration while parsing,
+///   i.e. without creating an intermediate JSON document.
+///
+/// Because a `Configuration` must consist of key/value pairs, a top-level
+/// JSON array will be loaded into the key `list`.
+class JSONBuilder : public nlohmann::json_sax<json> {
+ public:
+  explicit JSONBuilder(NullValuePolicy none_policy)
+      : none_policy_{none_policy} {}
+
+  bool null() override {
+    EnsureContainer();
+    builder_.Null(none_policy_);
+    return true;
   }
-  msg +=
-      " Please report at "
-      "https://github.com/snototter/werkzeugkiste/issues";
-  throw std::logic_error{msg};
-}
-// LCOV_EXCL_STOP
-
-/// @brief Appends or sets a configuration value from a scalar json value.
-/// @tparam Tp Type of the scalar value.
-/// @param object The JSON value.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name.
-/// @param append If true, fqn is assumed to be a list and the value will be
-///   appended. Otherwise, the value will be set, i.e. "cfg[fqn] = value";
-template <typename Tp>
-void HandleBuiltinScalar(const json &object,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  if (append) {
-    cfg.Append(fqn, object.get<Tp>());
-  } else {
-    cfg.Set(fqn, object.get<Tp>());
-  }
-}
 
-/// @brief Appends or sets a configuration value from a parsed json value.
-/// @param value Value to be added to the configuration.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name.
-/// @param append If true, fqn is assumed to be a list and the value will be
-///   appended. Otherwise, the value will be set, i.e. "cfg[fqn] = value";
-// NOLINTNEXTLINE(misc-no-recursion)
-void HandleValue(const json &value,
-    Configuration &cfg,
-    std::string_view fqn,
-    NullValuePolicy none_policy,
-    bool append) {
-  switch (value.type()) {
-    case json::value_t::null:
-      Configuration::HandleNullValue(cfg, fqn, none_policy, append);
-      break;
-
-    case json::value_t::boolean:
-      HandleBuiltinScalar<bool>(value, cfg, fqn, append);
-      break;
-
-    case json::value_t::number_integer:
-    case json::value_t::number_unsigned:
-      // https://json.nlohmann.me/api/basic_json/number_integer_t/
-      HandleBuiltinScalar<int64_t>(value, cfg, fqn, append);
-      break;
-
-    case json::value_t::number_float:
-      // https://json.nlohmann.me/api/basic_json/number_float_t/
-      HandleBuiltinScalar<double>(value, cfg, fqn, append);
-      break;
-
-    case json::value_t::string:
-      HandleBuiltinScalar<std::string>(value, cfg, fqn, append);
-      break;
-
-    case json::value_t::array: {
-      if (append) {
-        const std::size_t lst_sz = cfg.Size(fqn);
-        const std::string elem_key =
-            Configuration::KeyForListElement(fqn, lst_sz);
-        cfg.AppendList(fqn);
-        AppendListItems(value, cfg, elem_key, none_policy);
-      } else {
-        cfg.CreateList(fqn);
-        AppendListItems(value, cfg, fqn, none_policy);
-      }
-      break;
-    }
-
-    case json::value_t::object: {
-      if (append) {
-        cfg.Append(fqn, FromJSONObject(value, none_policy));
-      } else {
-        cfg.Set(fqn, FromJSONObject(value, none_policy));
-      }
-      break;
-    }
+  bool boolean(bool val) override {
+    EnsureContainer();
+    builder_.Scalar(val);
+    return true;
+  }
 
-    // LCOV_EXCL_START
-    case json::value_t::binary: {
-      std::string msg{
-          "Binary JSON values are not supported, check parameter `"};
-      msg += fqn;
-      msg += "`!";
-      throw ValueError{msg};
-    }
+  bool number_integer(number_integer_t val) override {
+    // https://json.nlohmann.me/api/basic_json/number_integer_t/
+    EnsureContainer();
+    builder_.Scalar(static_cast<int64_t>(val));
+    return true;
+  }
 
-    case json::value_t::discarded:
-      break;
-      // LCOV_EXCL_STOP
+  bool number_unsigned(number_unsigned_t val) override {
+    EnsureContainer();
+    builder_.Scalar(static_cast<int64_t>(val));
+    return true;
   }
-}
 
-/// @brief Appends all child nodes of the given JSON list to the configuration.
-/// @param list The JSON list.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name. This must be a list already
-///   existing in the configuration.
-/// @param none_policy How to deal with null/none values.
-// NOLINTNEXTLINE(misc-no-recursion)
-void AppendListItems(const json &list,
-    Configuration &cfg,
-    std::string_view fqn,
-    NullValuePolicy none_policy) {
-  // LCOV_EXCL_START
-  // The following failures should never happen, unless we messed
-  //  up the internal logic.
-  if (!list.is_array()) {
-    ThrowImplementationError(
-        "Internal JSON util `AppendListItems` called with non-list/array node",
-        fqn);
+  bool number_float(number_float_t val, const string_t & /*str*/) override {
+    // https://json.nlohmann.me/api/basic_json/number_float_t/
+    EnsureContainer();
+    builder_.Scalar(static_cast<double>(val));
+    return true;
   }
-  if (!cfg.Contains(fqn)) {
-    ThrowImplementationError(
-        "Internal JSON util `AppendListItems` requires that list already "
-        "exists",
-        fqn);
+
+  bool string(string_t &val) override {
+    EnsureContainer();
+    builder_.Scalar(std::move(val));
+    return true;
   }
-  // LCOV_EXCL_STOP
 
-  for (const json &elem : list) {
-    HandleValue(elem, cfg, fqn, none_policy, /*append=*/true);
+  bool binary(binary_t & /*val*/) override {
+    std::string msg{"Binary JSON values are not supported, check parameter `"};
+    msg += builder_.CurrentPath();
+    msg += "`!";
+    throw ValueError{msg};
   }
-}
 
-/// @brief Parses a JSON object (dictionary) into a Configuration.
-/// @param object The JSON object.
-/// @param none_policy How to deal with null/none values.
-// NOLINTNEXTLINE(misc-no-recursion)
-Configuration FromJSONObject(const json &object, NullValuePolicy none_policy) {
-  Configuration grp{};
-  for (json::const_iterator it = object.begin(); it != object.end(); ++it) {
-    HandleValue(it.value(), grp, it.key(), none_policy, /*append=*/false);
+  bool start_object(std::size_t /*elements*/) override {
+    // The top-level object is the configuration root.
+    if (depth_ > 0) {
+      builder_.BeginGroup();
+    }
+    ++depth_;
+    return true;
   }
-  return grp;
-}
 
-}  // namespace detail
+  bool key(string_t &val) override {
+    builder_.Key(val);
+    return true;
+  }
 
-Configuration LoadJSONString(std::string_view json_string,
-    NullValuePolicy none_policy) {
-  try {
-    const json &object = json::parse(json_string);
-    if (object.is_object()) {
-      return detail::FromJSONObject(object, none_policy);
+  bool end_object() override {
+    --depth_;
+    if (depth_ > 0) {
+      builder_.End();
     }
+    return true;
+  }
 
-    if (object.is_array()) {
-      Configuration cfg{};
-      const std::string_view key{"list"};
-      cfg.CreateList(key);
-      detail::AppendListItems(object, cfg, key, none_policy);
-      return cfg;
+  bool start_array(std::size_t /*elements*/) override {
+    if (depth_ == 0) {
+      builder_.Key("list");
     }
+    ++depth_;
+    builder_.BeginList();
+    return true;
+  }
+
+  bool end_array() override {
+    --depth_;
+    builder_.End();
+    return true;
+  }
 
-    // LCOV_EXCL_START
-    // This branch should be unreachable.
-    throw std::logic_error{
-        "Internal util `FromJSONRoot` invoked with neither JSON object nor "
-        "array! Please "
-        "report at https://github.com/snototter/werkzeugkiste/issues"};
-    // LCOV_EXCL_STOP
-  } catch (const json::parse_error &e) {
+  bool parse_error(std::size_t /*position*/,
+      const std::string & /*last_token*/,
+      const nlohmann::detail::exception &ex) override {
     std::string msg{"Parsing JSON input failed! "};
-    msg += e.what();
+    msg += ex.what();
     throw ParseError{msg};
   }
+
+  Configuration Release() { return builder_.Release(); }
+
+ private:
+  TreeBuilder builder_{};
+  NullValuePolicy none_policy_{NullValuePolicy::Skip};
+  std::size_t depth_{0};
+
+  /// Raises a `ParseError` if a scalar occurs outside of an object/array.
+  void EnsureContainer() const {
+    if (depth_ == 0) {
+      throw ParseError{
+          "Parsing JSON input failed! The top-level value must be either an "
+          "object or an array."};
+    }
+  }
+};
+}  // namespace detail
+
+Configuration LoadJSONString(std::string_view json_string,
+    NullValuePolicy none_policy) {
+  detail::JSONBuilder builder{none_policy};
+  json::sax_parse(json_string, &builder);
+  return builder.Release();
 }
 
 Configuration LoadJSONFile(std::string_view filename,
     NullValuePolicy none_policy) {
   try {
-    return LoadJSONString(files::CatAsciiFile(filename), none_policy);
+    // Parse directly from the mapped file content to avoid copying it.
+    const files::MappedFile file{filename};
+    return LoadJSONString(file.View(), none_policy);
   } catch (const werkzeugkiste::files::IOError &e) {
     throw ParseError(e.what());
   }
@@ -1,66 +1,148 @@
 #include <werkzeugkiste/config/keymatcher.h>
 
 #include <algorithm>
-#include <optional>
-#include <regex>
+#include <cstdint>
+#include <limits>
 #include <utility>  // pair, swap
 #include <vector>
 
 namespace werkzeugkiste::config {
+/// @brief Glob matcher which compiles all registered patterns into a single
+///   trie.
+///
+/// The only special character of a pattern is the wildcard '*', which matches
+/// any (possibly empty) sequence of characters. All other characters, including
+/// '.', '[' and ']', must match exactly. A query is matched against all
+/// patterns at once by simulating the trie as a nondeterministic automaton,
+/// i.e. in a single pass over the query.
 struct KeyMatcher::Impl {
  public:
+  Impl() : nodes_(1) {}
+
   void RegisterKey(std::string_view key) {
-    patterns_.emplace_back(std::string(key), BuildRegex(key));
+    std::size_t state = 0;
+    for (const char c : key) {
+      if (c == '*') {
+        // Consecutive wildcards are equivalent to a single one.
+        if (nodes_[state].is_wildcard) {
+          continue;
+        }
+        if (nodes_[state].wildcard == kNoState) {
+          nodes_[state].wildcard = NewState(/*is_wildcard=*/true);
+        }
+        state = nodes_[state].wildcard;
+      } else {
+        const std::size_t next = Child(state, c);
+        if (next != kNoState) {
+          state = next;
+        } else {
+          const std::size_t child = NewState(/*is_wildcard=*/false);
+          nodes_[state].children.emplace_back(c, child);
+          state = child;
+        }
+      }
+    }
+    nodes_[state].is_accepting = true;
+    ++num_patterns_;
   }
 
   bool Match(std::string_view query) const {
-    constexpr auto re_flags = std::regex_constants::match_default;
+    if (num_patterns_ == 0) {
+      return false;
+    }
 
-    for (const auto &pattern : patterns_) {
-      if (pattern.first == query) {
-        return true;
+    // The active states must be deduplicated (multiple wildcards could lead to
+    // the same state). The buffers are reused to avoid allocations.
+    thread_local Scratch scratch{};
+    if (scratch.marks.size() < nodes_.size()) {
+      scratch.marks.resize(nodes_.size(), 0);
+    }
+    scratch.current.clear();
+
+    ++scratch.stamp;
+    Activate(0, scratch, scratch.current);
+    for (const char c : query) {
+      ++scratch.stamp;
+      scratch.next.clear();
+      for (const std::size_t state : scratch.current) {
+        const Node &node = nodes_[state];
+        if (node.is_wildcard) {
+          Activate(state, scratch, scratch.next);
+        }
+        const std::size_t child = Child(state, c);
+        if (child != kNoState) {
+          Activate(child, scratch, scratch.next);
+        }
       }
 
-      if (pattern.second.has_value() &&
-          std::regex_match(
-              query.begin(), query.end(), pattern.second.value(), re_flags)) {
-        return true;
+      if (scratch.next.empty()) {
+        return false;
       }
+      std::swap(scratch.current, scratch.next);
     }
-    return false;
+
+    return std::any_of(scratch.current.begin(),
+        scratch.current.end(),
+        [this](std::size_t state) { return nodes_[state].is_accepting; });
   }
 
-  bool Empty() const { return patterns_.empty(); }
+  bool Empty() const { return num_patterns_ == 0; }
 
  private:
-  std::vector<std::pair<std::string, std::optional<std::regex>>> patterns_{};
-
-  static bool IsRegex(std::string_view key) {
-    const auto *it = std::find_if_not(key.begin(), key.end(), [](char c) {
-      return ((isalnum(c) != 0) || (c == '.') || (c == '_') || (c == '-'));
-    });
-    return it != key.end();
+  static constexpr std::size_t kNoState =
+      std::numeric_limits<std::size_t>::max();
+
+  /// @brief A state of the trie.
+  struct Node {
+    /// Transitions upon a literal character.
+    std::vector<std::pair<char, std::size_t>> children{};
+
+    /// Transition upon a wildcard (an epsilon transition during matching).
+    std::size_t wildcard{kNoState};
+
+    /// A wildcard state consumes any character.
+    bool is_wildcard{false};
+
+    /// Set if a pattern ends at this state.
+    bool is_accepting{false};
+  };
+
+  /// @brief Reusable buffers for `Match`.
+  struct Scratch {
+    std::vector<std::size_t> current{};
+    std::vector<std::size_t> next{};
+    std::vector<uint64_t> marks{};
+    uint64_t stamp{0};
+  };
+
+  std::vector<Node> nodes_;
+  std::size_t num_patterns_{0};
+
+  std::size_t NewState(bool is_wildcard) {
+    nodes_.emplace_back();
+    nodes_.back().is_wildcard = is_wildcard;
+    return nodes_.size() - 1;
   }
 
-  static std::optional<std::regex> BuildRegex(std::string_view key) {
-    if (!IsRegex(key)) {
-      return std::nullopt;
-    }
-
-    std::string re{"^"};
-    for (const char c : key) {
-      if (c == '*') {
-        re += ".*";
-      } else if ((c == '.') || (c == '[') || (c == ']')) {
-        re += '\\';
-        re += c;
-      } else {
-        re += c;
+  std::size_t Child(std::size_t state, char c) const {
+    for (const auto &[label, child] : nodes_[state].children) {
+      if (label == c) {
+        return child;
       }
     }
-    re += '$';
+    return kNoState;
+  }
 
-    return std::make_optional<std::regex>(re);
+  /// @brief Adds the state (and the state reachable via its wildcard
+  ///   transition) to the active states, unless already active.
+  void Activate(std::size_t state,
+      Scratch &scratch,
+      std::vector<std::size_t> &active) const {
+    while ((state != kNoState) && (scratch.marks[state] != scratch.stamp)) {
+      scratch.marks[state] = scratch.stamp;
+      active.push_back(state);
+      state = nodes_[state].wildcard;
+    }
   }
 };
 
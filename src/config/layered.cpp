@@ -0,0 +1,329 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/layered.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "configuration_access.h"
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// @brief Returns true if the layer holds a scalar or list at any parent of
+///   the given key, *e.g.* at `camera` or `camera.roi` for the key
+///   `camera.roi[0]`. Such a parameter hides the key in all lower layers.
+bool HidesKey(const Configuration &layer, std::string_view key) {
+  for (std::size_t pos = 1; pos < key.length(); ++pos) {
+    if ((key[pos] == '.') || (key[pos] == '[')) {
+      const std::string_view parent = key.substr(0, pos);
+      if (layer.Contains(parent) &&
+          (layer.Type(parent) != ConfigType::Group)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// @brief Recursively merges `src` into `dst`, *i.e.* groups are merged and
+///   all other parameters of `src` replace the corresponding ones of `dst`.
+// NOLINTNEXTLINE(misc-no-recursion)
+void MergeTables(toml::table &dst, const toml::table &src) {
+  for (auto &&[key, value] : src) {
+    toml::node *existing = dst.get(key.str());
+    if ((existing != nullptr) && existing->is_table() && value.is_table()) {
+      MergeTables(*existing->as_table(), *value.as_table());
+    } else {
+      dst.insert_or_assign(key.str(), value);
+    }
+  }
+}
+/// @brief Signature of the typed `Configuration` getters.
+template <typename Tp>
+using Getter = Tp (Configuration::*)(std::string_view) const;
+
+/// @brief Returns the value of the topmost layer which provides the key, or
+///   `std::nullopt` if no layer provides it.
+///
+/// Each layer is queried once via `TryGet`. If the parameter of the providing
+/// layer has a different type, the layer's `getter` is invoked to raise the
+/// corresponding `TypeError`.
+template <typename Tp>
+std::optional<Tp> LookupLayered(const std::vector<Configuration> &layers,
+    std::string_view key,
+    Getter<Tp> getter) {
+  for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
+    LookupResult<Tp> result = it->TryGet<Tp>(key);
+    if (result.HasValue()) {
+      return std::move(result).Value();
+    }
+
+    if (result.Error() != LookupError::KeyNotFound) {
+      return ((*it).*getter)(key);
+    }
+
+    if (HidesKey(*it, key)) {
+      return std::nullopt;
+    }
+  }
+  return std::nullopt;
+}
+
+/// @brief Returns the `KeyError` for a parameter which no layer provides.
+KeyError MissingLayeredKey(std::string_view key, std::size_t num_layers) {
+  std::string msg{"Key `"};
+  msg += key;
+  msg += "` does not exist in any of the ";
+  msg += std::to_string(num_layers);
+  msg += " layers!";
+  return KeyError{msg};
+}
+
+/// @brief Returns the value of the topmost layer which provides the key or
+///   raises a `KeyError`.
+template <typename Tp>
+Tp GetLayered(const std::vector<Configuration> &layers,
+    std::string_view key,
+    Getter<Tp> getter) {
+  std::optional<Tp> value = LookupLayered<Tp>(layers, key, getter);
+  if (!value.has_value()) {
+    throw MissingLayeredKey(key, layers.size());
+  }
+  return std::move(value).value();
+}
+}  // namespace detail
+
+void LayeredConfiguration::PushLayer(const Configuration &layer) {
+  layers_.push_back(layer);
+}
+
+bool LayeredConfiguration::Empty() const {
+  for (const auto &layer : layers_) {
+    if (!layer.Empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const Configuration *LayeredConfiguration::Find(std::string_view key) const {
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    if (it->Contains(key)) {
+      return &(*it);
+    }
+
+    if (detail::HidesKey(*it, key)) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+const Configuration &LayeredConfiguration::Layer(std::string_view key) const {
+  const Configuration *layer = Find(key);
+  if (layer == nullptr) {
+    throw detail::MissingLayeredKey(key, layers_.size());
+  }
+  return *layer;
+}
+
+bool LayeredConfiguration::Contains(std::string_view key) const {
+  return Find(key) != nullptr;
+}
+
+ConfigType LayeredConfiguration::Type(std::string_view key) const {
+  return Layer(key).Type(key);
+}
+
+Configuration LayeredConfiguration::Flatten() const {
+  if (layers_.empty()) {
+    return Configuration{};
+  }
+
+  if (layers_.size() == 1) {
+    return layers_.front();
+  }
+
+  toml::table merged{detail::ConfigurationAccess::Root(layers_.front())};
+  for (std::size_t idx = 1; idx < layers_.size(); ++idx) {
+    detail::MergeTables(
+        merged, detail::ConfigurationAccess::Root(layers_[idx]));
+  }
+  return detail::ConfigurationAccess::FromTable(std::move(merged));
+}
+
+Configuration LayeredConfiguration::GetGroup(std::string_view key) const {
+  // Visit the layers bottom-up, until the topmost layer which replaces the
+  // group (or a parent of it) by a scalar or list.
+  std::size_t first = layers_.size();
+  while (first > 0) {
+    const Configuration &layer = layers_[first - 1];
+    const bool contains = layer.Contains(key);
+    if ((contains && (layer.Type(key) != ConfigType::Group)) ||
+        (!contains && detail::HidesKey(layer, key))) {
+      break;
+    }
+    --first;
+  }
+
+  const Configuration &top = Layer(key);
+  if (top.Type(key) != ConfigType::Group) {
+    // Raises the corresponding TypeError
+    return top.GetGroup(key);
+  }
+
+  toml::table merged{};
+  for (std::size_t idx = first; idx < layers_.size(); ++idx) {
+    if (layers_[idx].Contains(key)) {
+      const Configuration group = layers_[idx].GetGroup(key);
+      detail::MergeTables(merged, detail::ConfigurationAccess::Root(group));
+    }
+  }
+  return detail::ConfigurationAccess::FromTable(std::move(merged));
+}
+
+//---------------------------------------------------------------------------
+// Typed getters
+
+bool LayeredConfiguration::GetBool(std::string_view key) const {
+  return detail::GetLayered<bool>(layers_, key, &Configuration::GetBool);
+}
+
+bool LayeredConfiguration::GetBoolOr(std::string_view key,
+    bool default_val) const {
+  return detail::LookupLayered<bool>(layers_, key, &Configuration::GetBool)
+      .value_or(default_val);
+}
+
+std::optional<bool> LayeredConfiguration::GetOptionalBool(
+    std::string_view key) const {
+  return detail::LookupLayered<bool>(layers_, key, &Configuration::GetBool);
+}
+
+std::vector<bool> LayeredConfiguration::GetBoolList(
+    std::string_view key) const {
+  return detail::GetLayered<std::vector<bool>>(
+      layers_, key, &Configuration::GetBoolList);
+}
+
+int32_t LayeredConfiguration::GetInt32(std::string_view key) const {
+  return detail::GetLayered<int32_t>(layers_, key, &Configuration::GetInt32);
+}
+
+int32_t LayeredConfiguration::GetInt32Or(std::string_view key,
+    int32_t default_val) const {
+  return detail::LookupLayered<int32_t>(layers_, key, &Configuration::GetInt32)
+      .value_or(default_val);
+}
+
+std::optional<int32_t> LayeredConfiguration::GetOptionalInt32(
+    std::string_view key) const {
+  return detail::LookupLayered<int32_t>(layers_, key, &Configuration::GetInt32);
+}
+
+std::vector<int32_t> LayeredConfiguration::GetInt32List(
+    std::string_view key) const {
+  return detail::GetLayered<std::vector<int32_t>>(
+      layers_, key, &Configuration::GetInt32List);
+}
+
+int64_t LayeredConfiguration::GetInt64(std::string_view key) const {
+  return detail::GetLayered<int64_t>(layers_, key, &Configuration::GetInt64);
+}
+
+int64_t LayeredConfiguration::GetInt64Or(std::string_view key,
+    int64_t default_val) const {
+  return detail::LookupLayered<int64_t>(layers_, key, &Configuration::GetInt64)
+      .value_or(default_val);
+}
+
+std::optional<int64_t> LayeredConfiguration::GetOptionalInt64(
+    std::string_view key) const {
+  return detail::LookupLayered<int64_t>(layers_, key, &Configuration::GetInt64);
+}
+
+std::vector<int64_t> LayeredConfiguration::GetInt64List(
+    std::string_view key) const {
+  return detail::GetLayered<std::vector<int64_t>>(
+      layers_, key, &Configuration::GetInt64List);
+}
+
+double LayeredConfiguration::GetDouble(std::string_view key) const {
+  return detail::GetLayered<double>(layers_, key, &Configuration::GetDouble);
+}
+
+double LayeredConfiguration::GetDoubleOr(std::string_view key,
+    double default_val) const {
+  return detail::LookupLayered<double>(layers_, key, &Configuration::GetDouble)
+      .value_or(default_val);
+}
+
+std::optional<double> LayeredConfiguration::GetOptionalDouble(
+    std::string_view key) const {
+  return detail::LookupLayered<double>(layers_, key, &Configuration::GetDouble);
+}
+
+std::vector<double> LayeredConfiguration::GetDoubleList(
+    std::string_view key) const {
+  return detail::GetLayered<std::vector<double>>(
+      layers_, key, &Configuration::GetDoubleList);
+}
+
+std::string LayeredConfiguration::GetString(std::string_view key) const {
+  return detail::GetLayered<std::string>(
+      layers_, key, &Configuration::GetString);
+}
+
+std::string LayeredConfiguration::GetStringOr(std::string_view key,
+    std::string_view default_val) const {
+  return detail::LookupLayered<std::string>(
+      layers_, key, &Configuration::GetString)
+      .value_or(std::string{default_val});
+}
+
+std::optional<std::string> LayeredConfiguration::GetOptionalString(
+    std::string_view key) const {
+  return detail::LookupLayered<std::string>(
+      layers_, key, &Configuration::GetString);
+}
+
+std::vector<std::string> LayeredConfiguration::GetStringList(
+    std::string_view key) const {
+  return detail::GetLayered<std::vector<std::string>>(
+      layers_, key, &Configuration::GetStringList);
+}
+
+date LayeredConfiguration::GetDate(std::string_view key) const {
+  return detail::GetLayered<date>(layers_, key, &Configuration::GetDate);
+}
+
+date LayeredConfiguration::GetDateOr(std::string_view key,
+    const date &default_val) const {
+  return detail::LookupLayered<date>(layers_, key, &Configuration::GetDate)
+      .value_or(default_val);
+}
+
+time LayeredConfiguration::GetTime(std::string_view key) const {
+  return detail::GetLayered<time>(layers_, key, &Configuration::GetTime);
+}
+
+time LayeredConfiguration::GetTimeOr(std::string_view key,
+    const time &default_val) const {
+  return detail::LookupLayered<time>(layers_, key, &Configuration::GetTime)
+      .value_or(default_val);
+}
+
+date_time LayeredConfiguration::GetDateTime(std::string_view key) const {
+  return detail::GetLayered<date_time>(
+      layers_, key, &Configuration::GetDateTime);
+}
+
+date_time LayeredConfiguration::GetDateTimeOr(std::string_view key,
+    const date_time &default_val) const {
+  return detail::LookupLayered<date_time>(
+      layers_, key, &Configuration::GetDateTime)
+      .value_or(default_val);
+}
+}  // namespace werkzeugkiste::config
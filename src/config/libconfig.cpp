@@ -2,13 +2,16 @@
 #include <werkzeugkiste/files/fileio.h>
 #include <werkzeugkiste/strings/strings.h>
 
+#include <array>
+#include <charconv>
 #include <cstdint>
-#include <iomanip>
 #include <limits>
-#include <sstream>
+#include <ostream>
 #include <string_view>
 #include <type_traits>
 
+#include "configuration_access.h"
+
 #ifdef WERKZEUGKISTE_WITH_LIBCONFIG
 #if __has_include(<libconfig.hh>)
 #include <libconfig.hh>
@@ -268,103 +271,117 @@ Configuration LoadLibconfigFile(std::string_view /*filename*/) {
 #endif  // WERKZEUGKISTE_WITH_LIBCONFIG
 
 /// @brief Custom formatter
+///
+/// Walks the underlying TOML tree once and writes each node directly to the
+/// output stream, i.e. without looking up parameters by their fully
+/// qualified name or copying subtrees.
 namespace detail::formatter {
 // Forward declaration.
-void PrintGroup(const Configuration &cfg,
+void PrintGroup(const toml::table &tbl,
     std::ostream &out,
     std::size_t indent,
     bool include_brackets);
 
-/// @brief Returns a libconfig-compatible string representation.
-std::string EscapeString(std::string_view str) {
-  const auto pos = str.find_first_of('\"');
-  std::string quoted{'"'};
-  if (pos == std::string_view::npos) {
-    quoted += str;
-  } else {
-    quoted += strings::Replace(str, "\"", "\\\"");
+/// @brief Prints a libconfig-compatible (quoted) string.
+void PrintString(std::ostream &out, std::string_view str) {
+  out << '"';
+  std::size_t pos = str.find('"');
+  while (pos != std::string_view::npos) {
+    out << str.substr(0, pos) << "\\\"";
+    str.remove_prefix(pos + 1);
+    pos = str.find('"');
   }
-  quoted += '"';
-  return quoted;
+  out << str << '"';
 }
 
-/// @brief Returns a string representation of the floating point value.
+/// @brief Prints the floating point value.
 ///
 /// To ensure that the floating point value will be correctly parsed as a
 /// libconfig floating point again, it must be either in scientific notation
 /// or contain a fractional part.
-std::string FloatingPointString(double val) {
-  std::string str{std::to_string(val)};
+void PrintFloatingPoint(std::ostream &out, double val) {
+  const std::string str{std::to_string(val)};
+  out << str;
   if (strings::IsInteger(str)) {
-    str += ".0";
+    out << ".0";
   }
-  return str;
 }
 
-/// @brief Returns a string representation of the integral value.
+/// @brief Prints the integral value.
 ///
 /// Although the trailing 'L' for 64-bit numbers is optional since v1.5 of
 /// libconfig, we experienced conversion issues (failed test cases), i.e.
 /// values were still converted to 32-bit. Thus, we explicilty append the
 /// type suffix, if the value exceeds the 32-bit range.
-std::string IntegerString(int64_t val) {
-  std::string str{std::to_string(val)};
+void PrintInteger(std::ostream &out, int64_t val) {
+  // Independent of the stream's format flags and locale.
+  std::array<char, 24> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), val);
+  out.write(buffer.data(), result.ptr - buffer.data());
   using Limits = std::numeric_limits<int32_t>;
   if ((val < static_cast<int64_t>(Limits::min())) ||
       (val > static_cast<int64_t>(Limits::max()))) {
-    str += 'L';
+    out << 'L';
   }
-  return str;
 }
 
 /// @brief Prints the libconfig-compatible string representation of the scalar
-///   parameter to the given output stream.
-/// @param cfg The werkzeugkiste configuration.
+///   node to the given output stream.
+/// @param node The scalar TOML node.
 /// @param out The output stream.
-/// @param key Fully qualified parameter name.
-void PrintScalar(const Configuration &cfg,
-    std::ostream &out,
-    std::string_view key) {
-  switch (cfg.Type(key)) {
-    case ConfigType::Boolean:
-      out << std::boolalpha << cfg.GetBool(key);
+void PrintScalar(const toml::node &node, std::ostream &out) {
+  switch (node.type()) {
+    case toml::node_type::boolean:
+      out << (node.as_boolean()->get() ? "true" : "false");
       break;
 
-    case ConfigType::Integer:
-      out << IntegerString(cfg.GetInt64(key));
+    case toml::node_type::integer:
+      PrintInteger(out, node.as_integer()->get());
       break;
 
-    case ConfigType::FloatingPoint:
-      out << FloatingPointString(cfg.GetDouble(key));
+    case toml::node_type::floating_point:
+      PrintFloatingPoint(out, node.as_floating_point()->get());
       break;
 
-    case ConfigType::String:
-      out << EscapeString(cfg.GetString(key));
+    case toml::node_type::string:
+      PrintString(out, node.as_string()->get());
       break;
 
-    case ConfigType::Date:
-      out << EscapeString(cfg.GetDate(key).ToString());
+    // Libconfig doesn't support date/time types, thus we store them as
+    // strings.
+    case toml::node_type::date: {
+      const toml::date &d = node.as_date()->get();
+      PrintString(out, date{d.year, d.month, d.day}.ToString());
       break;
+    }
 
-    case ConfigType::Time:
-      out << EscapeString(cfg.GetTime(key).ToString());
+    case toml::node_type::time: {
+      const toml::time &t = node.as_time()->get();
+      PrintString(
+          out, time{t.hour, t.minute, t.second, t.nanosecond}.ToString());
       break;
+    }
 
-    case ConfigType::DateTime:
-      out << EscapeString(cfg.GetDateTime(key).ToString());
+    case toml::node_type::date_time: {
+      const toml::date_time &dt = node.as_date_time()->get();
+      date_time tmp{};
+      tmp.date = date{dt.date.year, dt.date.month, dt.date.day};
+      tmp.time = time{
+          dt.time.hour, dt.time.minute, dt.time.second, dt.time.nanosecond};
+      if (dt.offset.has_value()) {
+        tmp.offset = time_offset{dt.offset.value().minutes};
+      }
+      PrintString(out, tmp.ToString());
       break;
+    }
 
     // LCOV_EXCL_START
-    default: {
+    default:
       // This branch should be unreachable.
-      std::string msg{
-          "`ConfigType` not handled in `PrintScalar` for parameter `"};
-      msg += key;
-      msg +=
-          "`! Please report at"
-          "https://github.com/snototter/werkzeugkiste/issues";
-      throw std::logic_error{msg};
-    }
+      throw std::logic_error{
+          "TOML node type not handled in `PrintScalar`! Please report at "
+          "https://github.com/snototter/werkzeugkiste/issues"};
       // LCOV_EXCL_STOP
   }
 }
@@ -378,19 +395,30 @@ void PrintIndent(std::ostream &out, std::size_t indentation_level) {
   }
 }
 
+/// @brief Returns true if all elements are scalars of the same type, i.e.
+///   the list can be represented as a libconfig array.
+bool IsHomogeneousScalarList(const toml::array &arr) {
+  for (const auto &value : arr) {
+    if (!value.is_value() || (value.type() != arr[0].type())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Prints the libconfig-compatible string representation of the
+///   given node to the output stream.
+void PrintNode(const toml::node &node, std::ostream &out, std::size_t indent);
+
 /// @brief Prints a libconfig-compatible string representation of the given
-///   list parameter to the output stream.
-/// @param cfg The werkzeugkiste configuration.
+///   list to the output stream.
+/// @param arr The TOML array.
 /// @param out The output stream.
-/// @param key Fully qualified parameter name of the list.
 /// @param indent Indentation level.
 // NOLINTNEXTLINE(misc-no-recursion)
-void PrintList(const Configuration &cfg,
-    std::ostream &out,
-    std::string_view key,
-    std::size_t indent) {
-  const bool is_homogeneous = cfg.IsHomogeneousScalarList(key);
-  const std::size_t size = cfg.Size(key);
+void PrintList(const toml::array &arr, std::ostream &out, std::size_t indent) {
+  const bool is_homogeneous = IsHomogeneousScalarList(arr);
+  const std::size_t size = arr.size();
   const bool include_newline = !is_homogeneous && (size > 0);
   if (is_homogeneous) {
     out << '[';
@@ -404,28 +432,11 @@ void PrintList(const Configuration &cfg,
 
   ++indent;
   for (std::size_t idx = 0; idx < size; ++idx) {
-    const std::string elem_key = Configuration::KeyForListElement(key, idx);
-
     if (include_newline) {
       PrintIndent(out, indent);
     }
 
-    switch (cfg.Type(elem_key)) {
-      case ConfigType::Group:
-        PrintGroup(cfg.GetGroup(elem_key),
-            out,
-            indent,
-            /*include_brackets=*/true);
-        break;
-
-      case ConfigType::List:
-        PrintList(cfg, out, elem_key, indent);
-        break;
-
-      default:
-        PrintScalar(cfg, out, elem_key);
-        break;
-    }
+    PrintNode(arr[idx], out, indent);
 
     if (idx < (size - 1)) {
       out << ',' << (include_newline ? '\n' : ' ');
@@ -446,21 +457,17 @@ void PrintList(const Configuration &cfg,
 
 /// @brief Prints a libconfig-compatible string representation of the given
 ///   parameter group/table to the output stream.
-/// @param cfg The werkzeugkiste configuration.
+/// @param tbl The TOML table.
 /// @param out The output stream.
-/// @param key Fully qualified parameter name of the group/table.
 /// @param indent Indentation level.
 /// @param include_brackets If set to true, the enclosing curly brackets will
 ///   also be printed.
 // NOLINTNEXTLINE(misc-no-recursion)
-void PrintGroup(const Configuration &cfg,
+void PrintGroup(const toml::table &tbl,
     std::ostream &out,
     std::size_t indent,
     bool include_brackets) {
-  const std::vector<std::string> keys = cfg.ListParameterNames(
-      /*include_array_entries=*/false, /*recursive=*/false);
-
-  const bool include_newline = !cfg.Empty();
+  const bool include_newline = !tbl.empty();
   if (include_brackets) {
     out << '{';
     if (include_newline) {
@@ -469,26 +476,10 @@ void PrintGroup(const Configuration &cfg,
     }
   }
 
-  for (std::size_t idx = 0; idx < keys.size(); ++idx) {
-    const auto &key = keys[idx];
-
+  for (const auto &[key, value] : tbl) {
     PrintIndent(out, indent);
-    out << key << " = ";
-
-    switch (cfg.Type(key)) {
-      case ConfigType::Group:
-        PrintGroup(cfg.GetGroup(key), out, indent, /*include_brackets=*/true);
-        break;
-
-      case ConfigType::List:
-        PrintList(cfg, out, key, indent);
-        break;
-
-      default:
-        PrintScalar(cfg, out, key);
-        break;
-    }
-
+    out << key.str() << " = ";
+    PrintNode(value, out, indent);
     out << ";\n";
   }
 
@@ -500,11 +491,27 @@ void PrintGroup(const Configuration &cfg,
     out << '}';
   }
 }
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void PrintNode(const toml::node &node, std::ostream &out, std::size_t indent) {
+  if (const toml::table *tbl = node.as_table()) {
+    PrintGroup(*tbl, out, indent, /*include_brackets=*/true);
+  } else if (const toml::array *arr = node.as_array()) {
+    PrintList(*arr, out, indent);
+  } else {
+    PrintScalar(node, out);
+  }
+}
 }  // namespace detail::formatter
 
+void Configuration::WriteLibconfig(std::ostream &out) const {
+  detail::formatter::PrintGroup(detail::ConfigurationAccess::Root(*this),
+      out,
+      0,
+      /*include_brackets=*/false);
+}
+
 std::string DumpLibconfigString(const Configuration &cfg) {
-  std::ostringstream str;
-  detail::formatter::PrintGroup(cfg, str, 0, /*include_brackets=*/false);
-  return str.str();
+  return cfg.ToLibconfig();
 }
 }  // namespace werkzeugkiste::config
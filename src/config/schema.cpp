@@ -0,0 +1,548 @@
+#include <werkzeugkiste/config/schema.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "configuration_access.h"
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// @brief Returns the configuration type of the given TOML node.
+inline ConfigType SchemaNodeType(const toml::node &node) {
+  switch (node.type()) {
+    case toml::node_type::boolean:
+      return ConfigType::Boolean;
+    case toml::node_type::integer:
+      return ConfigType::Integer;
+    case toml::node_type::floating_point:
+      return ConfigType::FloatingPoint;
+    case toml::node_type::string:
+      return ConfigType::String;
+    case toml::node_type::date:
+      return ConfigType::Date;
+    case toml::node_type::time:
+      return ConfigType::Time;
+    case toml::node_type::date_time:
+      return ConfigType::DateTime;
+    case toml::node_type::array:
+      return ConfigType::List;
+    default:
+      return ConfigType::Group;
+  }
+}
+
+/// @brief Returns true if a node of type `actual` can be queried as
+///   `expected`, i.e. integers also satisfy floating point rules.
+inline bool SchemaTypeMatches(ConfigType expected, ConfigType actual) {
+  return (expected == actual) || ((expected == ConfigType::FloatingPoint) &&
+                                     (actual == ConfigType::Integer));
+}
+
+/// @brief Returns the numeric value of the node, if it is a number.
+inline std::optional<double> SchemaNumber(const toml::node &node) {
+  if (node.type() == toml::node_type::integer) {
+    return static_cast<double>(node.as_integer()->get());
+  }
+  if (node.type() == toml::node_type::floating_point) {
+    return node.as_floating_point()->get();
+  }
+  return std::nullopt;
+}
+
+/// @brief Parses the string representation of a `ConfigType`.
+inline ConfigType SchemaParseType(const std::string &str,
+    std::string_view rule_key) {
+  for (ConfigType ct : {ConfigType::Boolean,
+           ConfigType::Integer,
+           ConfigType::FloatingPoint,
+           ConfigType::String,
+           ConfigType::Date,
+           ConfigType::Time,
+           ConfigType::DateTime,
+           ConfigType::List,
+           ConfigType::Group}) {
+    if (ConfigTypeToString(ct) == str) {
+      return ct;
+    }
+  }
+  std::string msg{"Schema rule for `"};
+  msg += rule_key;
+  msg += "` has an invalid type `";
+  msg += str;
+  msg += "`!";
+  throw ParseError{msg};
+}
+}  // namespace detail
+
+/// @brief The compiled rules.
+///
+/// The rules are stored in a trie which mirrors the parameter hierarchy,
+/// i.e. each plan node corresponds to a key prefix and lists the rules which
+/// must be checked at this parameter. Validation walks the configuration
+/// and the plan simultaneously.
+struct Schema::Impl {
+  /// @brief Constraints of a single parameter.
+  struct Rule {
+    std::string key{};
+    std::optional<ConfigType> type{};
+    bool required{false};
+    std::optional<double> min{};
+    std::optional<double> max{};
+    std::optional<int64_t> min_length{};
+    std::optional<int64_t> max_length{};
+    std::optional<ConfigType> element_type{};
+    std::optional<std::pair<int64_t, int64_t>> shape{};
+  };
+
+  /// @brief Node of the traversal plan.
+  struct PlanNode {
+    /// Child nodes of named parameters, sorted by name.
+    std::vector<std::pair<std::string, std::size_t>> named{};
+
+    /// Child nodes of explicitly indexed list elements, e.g. `arr[3]`.
+    std::vector<std::pair<std::size_t, std::size_t>> indexed{};
+
+    /// Child node which applies to all list elements, i.e. `arr[*]`.
+    std::optional<std::size_t> all{};
+
+    /// Indices of the rules which apply to this node.
+    std::vector<std::size_t> rules{};
+
+    /// True if a required rule exists in this subtree (excluding `[*]`).
+    bool has_required{false};
+  };
+
+  /// @brief A segment of a rule key, i.e. a name or a list index.
+  struct Segment {
+    enum class Kind { Name, Index, All };
+    Kind kind{Kind::Name};
+    std::string_view name{};
+    std::size_t index{0};
+  };
+
+  std::vector<Rule> rules{};
+  std::vector<PlanNode> plan{PlanNode{}};
+
+  /// @brief Splits a rule key, e.g. `a.b[3][*].c`, into its segments.
+  static std::vector<Segment> SplitKey(std::string_view key) {
+    const auto invalid = [key]() -> ParseError {
+      std::string msg{"Schema rule has an invalid key `"};
+      msg += key;
+      msg += "`!";
+      return ParseError{msg};
+    };
+
+    std::vector<Segment> segments{};
+    std::size_t pos = 0;
+    bool expect_name = true;
+    while (pos < key.length()) {
+      if (key[pos] == '[') {
+        const std::size_t end = key.find(']', pos);
+        if (segments.empty() || (end == std::string_view::npos) ||
+            (end == pos + 1)) {
+          throw invalid();
+        }
+        const std::string_view token = key.substr(pos + 1, end - pos - 1);
+        Segment segment{};
+        if (token == "*") {
+          segment.kind = Segment::Kind::All;
+        } else {
+          if (!std::all_of(token.begin(), token.end(), [](char c) {
+                return (c >= '0') && (c <= '9');
+              })) {
+            throw invalid();
+          }
+          segment.kind = Segment::Kind::Index;
+          segment.index = std::stoul(std::string{token});
+        }
+        segments.push_back(segment);
+        pos = end + 1;
+        expect_name = false;
+      } else {
+        if (!expect_name) {
+          if (key[pos] != '.') {
+            throw invalid();
+          }
+          ++pos;
+        }
+        const std::size_t end = key.find_first_of(".[", pos);
+        const std::size_t len =
+            ((end == std::string_view::npos) ? key.length() : end) - pos;
+        if (len == 0) {
+          throw invalid();
+        }
+        segments.push_back(Segment{Segment::Kind::Name, key.substr(pos, len)});
+        pos += len;
+        expect_name = false;
+      }
+    }
+    if (segments.empty()) {
+      throw invalid();
+    }
+    return segments;
+  }
+
+  /// @brief Returns the index of the child plan node, inserting it if needed.
+  std::size_t Child(std::size_t parent, const Segment &segment) {
+    const std::size_t next = plan.size();
+    switch (segment.kind) {
+      case Segment::Kind::Name: {
+        auto &named = plan[parent].named;
+        auto it = std::lower_bound(named.begin(),
+            named.end(),
+            segment.name,
+            [](const auto &child, std::string_view name) -> bool {
+              return child.first < name;
+            });
+        if ((it != named.end()) && (it->first == segment.name)) {
+          return it->second;
+        }
+        named.insert(it, {std::string{segment.name}, next});
+        break;
+      }
+
+      case Segment::Kind::Index: {
+        auto &indexed = plan[parent].indexed;
+        auto it = std::lower_bound(indexed.begin(),
+            indexed.end(),
+            segment.index,
+            [](const auto &child, std::size_t index) -> bool {
+              return child.first < index;
+            });
+        if ((it != indexed.end()) && (it->first == segment.index)) {
+          return it->second;
+        }
+        indexed.insert(it, {segment.index, next});
+        break;
+      }
+
+      case Segment::Kind::All:
+        if (plan[parent].all.has_value()) {
+          return *plan[parent].all;
+        }
+        plan[parent].all = next;
+        break;
+    }
+    plan.emplace_back();
+    return next;
+  }
+
+  /// @brief Adds the rule to the traversal plan.
+  void Compile(Rule &&rule) {
+    const std::vector<Segment> segments = SplitKey(rule.key);
+    std::vector<std::size_t> path{0};
+    for (const Segment &segment : segments) {
+      path.push_back(Child(path.back(), segment));
+    }
+    plan[path.back()].rules.push_back(rules.size());
+
+    // Marks the path as leading to a required rule, such that missing
+    // parameters are visited. Above a `[*]`, however, a missing list simply
+    // has no elements to check.
+    if (rule.required) {
+      for (std::size_t depth = segments.size(); depth > 0; --depth) {
+        plan[path[depth]].has_required = true;
+        if (segments[depth - 1].kind == Segment::Kind::All) {
+          break;
+        }
+      }
+    }
+    rules.push_back(std::move(rule));
+  }
+
+  /// @brief Parses a single rule of the schema description.
+  static Rule ParseRule(const Configuration &desc, std::string_view name) {
+    Rule rule{};
+    try {
+      rule.key = desc.GetString("key");
+    } catch (const std::exception &e) {
+      std::string msg{"Schema rule `"};
+      msg += name;
+      msg += "` requires a string `key`: ";
+      msg += e.what();
+      throw ParseError{msg};
+    }
+
+    try {
+      for (const auto &field : desc.ListParameterNames(
+               /*include_array_entries=*/false, /*recursive=*/false)) {
+        if (field == "key") {
+          continue;
+        }
+        if (field == "type") {
+          rule.type = detail::SchemaParseType(desc.GetString(field), rule.key);
+        } else if (field == "required") {
+          rule.required = desc.GetBool(field);
+        } else if (field == "min") {
+          rule.min = desc.GetDouble(field);
+        } else if (field == "max") {
+          rule.max = desc.GetDouble(field);
+        } else if (field == "min_length") {
+          rule.min_length = desc.GetInt64(field);
+        } else if (field == "max_length") {
+          rule.max_length = desc.GetInt64(field);
+        } else if (field == "element_type") {
+          rule.element_type =
+              detail::SchemaParseType(desc.GetString(field), rule.key);
+        } else if (field == "shape") {
+          const std::vector<int64_t> shape = desc.GetInt64List(field);
+          if (shape.size() != 2) {
+            throw ParseError{"`shape` must specify [rows, columns]!"};
+          }
+          rule.shape = std::make_pair(shape[0], shape[1]);
+        } else {
+          std::string msg{"Unknown constraint `"};
+          msg += field;
+          msg += "`!";
+          throw ParseError{msg};
+        }
+      }
+    } catch (const std::exception &e) {
+      std::string msg{"Invalid schema rule for `"};
+      msg += rule.key;
+      msg += "`: ";
+      msg += e.what();
+      throw ParseError{msg};
+    }
+    return rule;
+  }
+
+  /// @brief Stateful walk over a configuration.
+  class Checker {
+   public:
+    Checker(const Impl &impl, std::vector<SchemaViolation> &violations)
+        : impl_{impl}, violations_{violations} {}
+
+    void Walk(std::size_t plan_idx, const toml::node *node) {
+      const PlanNode &plan = impl_.plan[plan_idx];
+      for (std::size_t rule_idx : plan.rules) {
+        Check(impl_.rules[rule_idx], node);
+      }
+
+      const toml::table *tbl = (node != nullptr) ? node->as_table() : nullptr;
+      const toml::array *arr = (node != nullptr) ? node->as_array() : nullptr;
+      const std::size_t path_length = path_.length();
+
+      for (const auto &[name, child_idx] : plan.named) {
+        const toml::node *child = (tbl != nullptr) ? tbl->get(name) : nullptr;
+        if ((child == nullptr) && !impl_.plan[child_idx].has_required) {
+          continue;
+        }
+        if (path_length > 0) {
+          path_ += '.';
+        }
+        path_ += name;
+        Walk(child_idx, child);
+        path_.resize(path_length);
+      }
+
+      for (const auto &[index, child_idx] : plan.indexed) {
+        const toml::node *child = (arr != nullptr) ? arr->get(index) : nullptr;
+        if ((child == nullptr) && !impl_.plan[child_idx].has_required) {
+          continue;
+        }
+        AppendIndex(index);
+        Walk(child_idx, child);
+        path_.resize(path_length);
+      }
+
+      if (plan.all.has_value() && (arr != nullptr)) {
+        for (std::size_t index = 0; index < arr->size(); ++index) {
+          AppendIndex(index);
+          Walk(*plan.all, arr->get(index));
+          path_.resize(path_length);
+        }
+      }
+    }
+
+   private:
+    const Impl &impl_;
+    std::vector<SchemaViolation> &violations_;
+    std::string path_{};
+
+    void AppendIndex(std::size_t index) {
+      path_ += '[';
+      path_ += std::to_string(index);
+      path_ += ']';
+    }
+
+    template <typename... Args>
+    void Report(const Args &...args) {
+      std::ostringstream msg{};
+      msg << "Parameter `" << path_ << "` ";
+      (msg << ... << args);
+      violations_.push_back(SchemaViolation{path_, msg.str()});
+    }
+
+    void Check(const Rule &rule, const toml::node *node) {
+      if (node == nullptr) {
+        if (rule.required) {
+          Report("is required, but does not exist!");
+        }
+        return;
+      }
+
+      const ConfigType actual = detail::SchemaNodeType(*node);
+      if (rule.type.has_value() &&
+          !detail::SchemaTypeMatches(*rule.type, actual)) {
+        Report("must be `", *rule.type, "`, but is `", actual, "`!");
+        return;
+      }
+
+      if (rule.min.has_value() || rule.max.has_value()) {
+        CheckRange(rule, *node, actual);
+      }
+
+      if (rule.min_length.has_value() || rule.max_length.has_value() ||
+          rule.element_type.has_value() || rule.shape.has_value()) {
+        const toml::array *arr = node->as_array();
+        if (arr == nullptr) {
+          Report("must be `list`, but is `", actual, "`!");
+          return;
+        }
+        CheckList(rule, *arr);
+      }
+    }
+
+    void CheckRange(const Rule &rule, const toml::node &node,
+        ConfigType actual) {
+      const std::optional<double> value = detail::SchemaNumber(node);
+      if (!value.has_value()) {
+        Report("must be numeric, but is `", actual, "`!");
+      } else if (rule.min.has_value() && (*value < *rule.min)) {
+        Report("is ", *value, ", which is less than the minimum ", *rule.min,
+            "!");
+      } else if (rule.max.has_value() && (*value > *rule.max)) {
+        Report("is ", *value, ", which exceeds the maximum ", *rule.max, "!");
+      }
+    }
+
+    void CheckList(const Rule &rule, const toml::array &arr) {
+      const auto length = static_cast<int64_t>(arr.size());
+      if (rule.min_length.has_value() && (length < *rule.min_length)) {
+        Report("has ", length, " elements, but requires at least ",
+            *rule.min_length, "!");
+      }
+      if (rule.max_length.has_value() && (length > *rule.max_length)) {
+        Report("has ", length, " elements, but allows at most ",
+            *rule.max_length, "!");
+      }
+
+      if (rule.element_type.has_value()) {
+        for (std::size_t idx = 0; idx < arr.size(); ++idx) {
+          const ConfigType actual = detail::SchemaNodeType(*arr.get(idx));
+          if (!detail::SchemaTypeMatches(*rule.element_type, actual)) {
+            Report("must only contain `", *rule.element_type,
+                "` elements, but element [", idx, "] is `", actual, "`!");
+            break;
+          }
+        }
+      }
+
+      if (rule.shape.has_value()) {
+        CheckShape(*rule.shape, arr);
+      }
+    }
+
+    void CheckShape(const std::pair<int64_t, int64_t> &shape,
+        const toml::array &arr) {
+      const auto rows = static_cast<int64_t>(arr.size());
+      int64_t cols = -1;
+      bool valid = (shape.first < 0) || (rows == shape.first);
+      for (std::size_t row = 0; valid && (row < arr.size()); ++row) {
+        const toml::array *elements = arr.get(row)->as_array();
+        if (elements == nullptr) {
+          valid = false;
+          break;
+        }
+        const auto row_length = static_cast<int64_t>(elements->size());
+        if (((cols >= 0) && (row_length != cols)) ||
+            ((shape.second >= 0) && (row_length != shape.second))) {
+          valid = false;
+          break;
+        }
+        cols = row_length;
+        for (const auto &value : *elements) {
+          if (!detail::SchemaNumber(value).has_value()) {
+            valid = false;
+            break;
+          }
+        }
+      }
+
+      if (!valid) {
+        const auto dim = [](int64_t d) -> std::string {
+          return (d < 0) ? std::string{"N"} : std::to_string(d);
+        };
+        Report("must be a numeric ", dim(shape.first), "x", dim(shape.second),
+            " matrix!");
+      }
+    }
+  };
+};
+
+Schema::Schema() : pimpl_{std::make_shared<const Impl>()} {}
+
+Schema::Schema(std::shared_ptr<const Impl> impl) : pimpl_{std::move(impl)} {}
+
+Schema Schema::FromConfiguration(const Configuration &description) {
+  auto impl = std::make_shared<Impl>();
+  if (!description.Contains("parameters")) {
+    return Schema{std::move(impl)};
+  }
+
+  if (description.Type("parameters") != ConfigType::List) {
+    throw ParseError{"Schema description requires a list of `parameters`!"};
+  }
+
+  const std::size_t num_rules = description.Size("parameters");
+  impl->rules.reserve(num_rules);
+  for (std::size_t idx = 0; idx < num_rules; ++idx) {
+    const std::string name =
+        Configuration::KeyForListElement("parameters", idx);
+    if (description.Type(name) != ConfigType::Group) {
+      std::string msg{"Schema rule `"};
+      msg += name;
+      msg += "` must be a group!";
+      throw ParseError{msg};
+    }
+    impl->Compile(Impl::ParseRule(description.GetGroup(name), name));
+  }
+  return Schema{std::move(impl)};
+}
+
+Schema Schema::LoadFile(std::string_view filename) {
+  return FromConfiguration(config::LoadFile(filename));
+}
+
+std::size_t Schema::NumRules() const { return pimpl_->rules.size(); }
+
+std::vector<SchemaViolation> Schema::Check(const Configuration &cfg) const {
+  std::vector<SchemaViolation> violations{};
+  Impl::Checker checker{*pimpl_, violations};
+  checker.Walk(0, &detail::ConfigurationAccess::Root(cfg));
+  return violations;
+}
+
+void Schema::Validate(const Configuration &cfg) const {
+  const std::vector<SchemaViolation> violations = Check(cfg);
+  if (violations.empty()) {
+    return;
+  }
+
+  std::string msg{"Configuration violates the schema:\n"};
+  for (const auto &violation : violations) {
+    msg += violation.message;
+    msg += '\n';
+  }
+  msg.pop_back();
+  throw ValueError{msg};
+}
+}  // namespace werkzeugkiste::config
@@ -0,0 +1,301 @@
+#ifndef WERKZEUGKISTE_CONFIG_STRING_REWRITER_H
+#define WERKZEUGKISTE_CONFIG_STRING_REWRITER_H
+
+#include <werkzeugkiste/config/types.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace werkzeugkiste::config::detail {
+/// @brief Replaces a set of search strings within a single scan of the input.
+///
+/// The search strings are compiled into an Aho-Corasick automaton. Rewriting
+/// a string first collects the matches in one pass over the input and then
+/// writes the output into a fresh buffer. Thus, the runtime is linear in the
+/// length of the input (plus the number of matches), independent of the number
+/// of search strings.
+///
+/// Matches do not overlap: the leftmost match wins and, if multiple search
+/// strings start at the same position, the longest one. The replacement texts
+/// are not searched again. If a search string occurs multiple times, its
+/// first replacement is used.
+class PlaceholderReplacer {
+ public:
+  /// @brief Compiles the automaton.
+  ///
+  /// Raises a `ValueError` if any search string is empty.
+  explicit PlaceholderReplacer(
+      const std::vector<std::pair<std::string_view, std::string_view>>
+          &replacements) {
+    classes_.fill(0);
+    starts_.fill(false);
+    for (const auto &rep : replacements) {
+      if (rep.first.empty()) {
+        throw ValueError{
+            "Search string within `ReplaceStrings()` must not be empty!"};
+      }
+      for (const char chr : rep.first) {
+        auto &cls = classes_[static_cast<unsigned char>(chr)];
+        if (cls == 0) {
+          cls = ++num_classes_;
+        }
+      }
+
+      auto &is_start = starts_[static_cast<unsigned char>(rep.first.front())];
+      if (!is_start) {
+        is_start = true;
+        single_start_ = (num_starts_ == 0) ? rep.first.front() : '\0';
+        ++num_starts_;
+      }
+    }
+    // Class 0 holds all characters which do not occur in any search string.
+    ++num_classes_;
+
+    AddState(0);
+    for (const auto &rep : replacements) {
+      Insert(rep.first, rep.second);
+    }
+    Link();
+  }
+
+  /// @brief Returns true if there are no search strings.
+  bool Empty() const { return needles_.empty(); }
+
+  /// @brief Replaces all matches within `str`.
+  /// @return True if any search string occurred in `str`.
+  bool Rewrite(std::string &str) {
+    if (Empty() || !FindMatches(str)) {
+      return false;
+    }
+
+    // Sort by start position, longer matches first. The matches have been
+    // found in the order of their end positions, thus they are already sorted
+    // unless some of them overlap.
+    const auto cmp = [this](const Match &lhs, const Match &rhs) {
+      return (lhs.start < rhs.start) ||
+             ((lhs.start == rhs.start) &&
+                 (Needle(lhs).length() > Needle(rhs).length()));
+    };
+    if (!std::is_sorted(matches_.begin(), matches_.end(), cmp)) {
+      std::sort(matches_.begin(), matches_.end(), cmp);
+    }
+
+    // Select the non-overlapping matches and compute the output length.
+    std::size_t selected = 0;
+    std::size_t length = str.length();
+    std::size_t pos = 0;
+    for (const Match &match : matches_) {
+      if (match.start >= pos) {
+        matches_[selected++] = match;
+        pos = match.start + Needle(match).length();
+        length = length + Replacement(match).length() - Needle(match).length();
+      }
+    }
+    matches_.resize(selected);
+
+    std::string rewritten(length, '\0');
+    char *out = rewritten.data();
+    pos = 0;
+    for (const Match &match : matches_) {
+      const std::string &replacement = Replacement(match);
+      std::memcpy(out, str.data() + pos, match.start - pos);
+      out += match.start - pos;
+      std::memcpy(out, replacement.data(), replacement.length());
+      out += replacement.length();
+      pos = match.start + Needle(match).length();
+    }
+    std::memcpy(out, str.data() + pos, str.length() - pos);
+    str = std::move(rewritten);
+    return true;
+  }
+
+ private:
+  /// A search string found at the given position.
+  struct Match {
+    std::size_t start;
+    uint32_t needle;
+  };
+
+  /// Maps each (unsigned) character to its equivalence class.
+  std::array<uint32_t, 256> classes_{};
+
+  /// Number of character equivalence classes.
+  uint32_t num_classes_{0};
+
+  /// Flags the first characters of the search strings.
+  std::array<bool, 256> starts_{};
+
+  /// Number of distinct first characters.
+  std::size_t num_starts_{0};
+
+  /// The first character of all search strings, if there is only one.
+  char single_start_{'\0'};
+
+  /// Transition table, `num_classes_` entries per state. Once the automaton
+  /// is compiled, each entry holds the offset of the next state's entries
+  /// (*i.e.* `state * num_classes_`), combined with the `kReportFlag`.
+  std::vector<uint32_t> transitions_{};
+
+  /// Length of the prefix which each state represents.
+  std::vector<uint32_t> depth_{};
+
+  /// Index of the search string which ends at each state, or -1.
+  std::vector<int32_t> output_{};
+
+  /// Next shorter suffix state which ends a search string (0 if none).
+  std::vector<uint32_t> dictionary_link_{};
+
+  std::vector<std::string> needles_{};
+  std::vector<std::string> replacements_{};
+
+  /// Matches within the currently rewritten string. Reused between strings.
+  std::vector<Match> matches_{};
+
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  /// Marks transitions into states at which at least one search string ends.
+  static constexpr uint32_t kReportFlag = 1U << 31U;
+
+  const std::string &Needle(const Match &match) const {
+    return needles_[match.needle];
+  }
+
+  const std::string &Replacement(const Match &match) const {
+    return replacements_[match.needle];
+  }
+
+  uint32_t AddState(uint32_t depth) {
+    transitions_.resize(transitions_.size() + num_classes_, kNone);
+    depth_.push_back(depth);
+    output_.push_back(-1);
+    dictionary_link_.push_back(0);
+    return static_cast<uint32_t>(depth_.size() - 1);
+  }
+
+  uint32_t &Transition(uint32_t state, char chr) {
+    const auto cls = classes_[static_cast<unsigned char>(chr)];
+    return transitions_[state * num_classes_ + cls];
+  }
+
+  void Insert(std::string_view needle, std::string_view replacement) {
+    uint32_t state = 0;
+    for (const char chr : needle) {
+      uint32_t next = Transition(state, chr);
+      if (next == kNone) {
+        next = AddState(depth_[state] + 1);
+        Transition(state, chr) = next;
+      }
+      state = next;
+    }
+
+    if (output_[state] < 0) {
+      output_[state] = static_cast<int32_t>(needles_.size());
+      needles_.emplace_back(needle);
+      replacements_.emplace_back(replacement);
+    }
+  }
+
+  /// Computes the failure links (breadth first) and turns the trie into a
+  /// deterministic automaton, i.e. afterwards, each state has a transition
+  /// for each character class.
+  void Link() {
+    std::vector<uint32_t> failure(depth_.size(), 0);
+    std::deque<uint32_t> queue{};
+    for (uint32_t cls = 0; cls < num_classes_; ++cls) {
+      uint32_t &next = transitions_[cls];
+      if (next == kNone) {
+        next = 0;
+      } else {
+        queue.push_back(next);
+      }
+    }
+
+    while (!queue.empty()) {
+      const uint32_t state = queue.front();
+      queue.pop_front();
+      const uint32_t fail = failure[state];
+      dictionary_link_[state] =
+          (output_[fail] >= 0) ? fail : dictionary_link_[fail];
+
+      for (uint32_t cls = 0; cls < num_classes_; ++cls) {
+        uint32_t &next = transitions_[state * num_classes_ + cls];
+        const uint32_t fallback = transitions_[fail * num_classes_ + cls];
+        if (next == kNone) {
+          next = fallback;
+        } else {
+          failure[next] = fallback;
+          queue.push_back(next);
+        }
+      }
+    }
+
+    if (depth_.size() * num_classes_ >= kReportFlag) {
+      throw ValueError{"Too many search strings within `ReplaceStrings()`!"};
+    }
+    for (uint32_t &next : transitions_) {
+      const bool report = (output_[next] >= 0) || (dictionary_link_[next] != 0);
+      next = (next * num_classes_) | (report ? kReportFlag : 0U);
+    }
+  }
+
+  /// Returns the position of the next character (at or after `pos`) which
+  /// starts a search string.
+  std::size_t SkipToStart(std::string_view str, std::size_t pos) const {
+    if (num_starts_ == 1) {
+      const void *found = std::memchr(
+          str.data() + pos, single_start_, str.length() - pos);
+      return (found == nullptr)
+                 ? str.length()
+                 : static_cast<std::size_t>(
+                       static_cast<const char *>(found) - str.data());
+    }
+
+    while ((pos < str.length()) &&
+           !starts_[static_cast<unsigned char>(str[pos])]) {
+      ++pos;
+    }
+    return pos;
+  }
+
+  /// Scans `str` once and collects all matches.
+  /// @return True if there is at least one match.
+  bool FindMatches(std::string_view str) {
+    matches_.clear();
+    uint32_t offset = 0;
+    for (std::size_t pos = 0; pos < str.length(); ++pos) {
+      if (offset == 0) {
+        // No search string is partially matched, so we can skip all
+        // characters which cannot start a match.
+        pos = SkipToStart(str, pos);
+        if (pos == str.length()) {
+          break;
+        }
+      }
+
+      const uint32_t next =
+          transitions_[offset + classes_[static_cast<unsigned char>(str[pos])]];
+      offset = next & ~kReportFlag;
+      if ((next & kReportFlag) != 0) {
+        const uint32_t state = offset / num_classes_;
+        uint32_t match =
+            (output_[state] >= 0) ? state : dictionary_link_[state];
+        while (match != 0) {
+          matches_.push_back(Match{pos + 1 - depth_[match],
+              static_cast<uint32_t>(output_[match])});
+          match = dictionary_link_[match];
+        }
+      }
+    }
+    return !matches_.empty();
+  }
+};
+}  // namespace werkzeugkiste::config::detail
+
+#endif  // WERKZEUGKISTE_CONFIG_STRING_REWRITER_H
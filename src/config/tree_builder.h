@@ -0,0 +1,252 @@
+#ifndef WERKZEUGKISTE_CONFIG_TREE_BUILDER_H
+#define WERKZEUGKISTE_CONFIG_TREE_BUILDER_H
+
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/keymatcher.h>
+#include <werkzeugkiste/config/types.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "configuration_access.h"
+
+namespace werkzeugkiste::config::detail {
+/// @brief Builds the TOML tree of a configuration from a stream of parser
+///   events.
+///
+/// Each value is inserted directly into its parent container, i.e. the
+/// fully qualified parameter name is never resolved from the root. This is
+/// used by the event-based (SAX-style) parsers.
+///
+/// Keys of group members follow the same rules as `Configuration::Set`: they
+/// must be bare or dotted keys, where a dotted key creates the intermediate
+/// groups. If a key occurs multiple times, the last value wins - unless both
+/// values are groups, which will then be merged.
+class TreeBuilder {
+ public:
+  TreeBuilder() { stack_.push_back(Frame{&root_, {}, 0}); }
+
+  /// @brief Sets the key of the next value. Must be called before each value
+  ///   that is added to a group.
+  ///
+  /// Raises a `KeyError` if the key is neither a bare nor a dotted key.
+  void Key(std::string_view key) {
+    if (!IsValidKey(key, /*allow_dots=*/true) || (key.front() == '.') ||
+        (key.back() == '.') || (key.find("..") != std::string_view::npos)) {
+      std::string msg{
+          "Expected a bare key/path (alphanumeric, '-', '_', '.'), but got `"};
+      msg += key;
+      msg += "`!";
+      throw KeyError{msg};
+    }
+    pending_key_.assign(key);
+  }
+
+  /// @brief Adds a scalar to the current group/list.
+  /// @return The inserted node.
+  template <typename Tp>
+  toml::node &Scalar(Tp &&value) {
+    using T = std::remove_cv_t<std::remove_reference_t<Tp>>;
+    if constexpr (std::is_same_v<T, date>) {
+      return Insert(toml::date{value.year, value.month, value.day});
+    } else if constexpr (std::is_same_v<T, time>) {
+      return Insert(ToTomlTime(value));
+    } else if constexpr (std::is_same_v<T, date_time>) {
+      const toml::date dt{value.date.year, value.date.month, value.date.day};
+      if (value.IsLocal()) {
+        return Insert(toml::date_time{dt, ToTomlTime(value.time)});
+      }
+      toml::time_offset offset{};
+      offset.minutes = static_cast<int16_t>(value.offset.value().minutes);
+      return Insert(toml::date_time{dt, ToTomlTime(value.time), offset});
+    } else {
+      return Insert(std::forward<Tp>(value));
+    }
+  }
+
+  /// @brief Adds a deep copy of the given node to the current group/list,
+  ///   e.g. to resolve references (aliases) within the input.
+  /// @return The inserted node.
+  toml::node &Copy(const toml::node &node) { return Insert(node); }
+
+  /// @brief Starts a nested group, i.e. subsequent values will be added to
+  ///   this group until the matching `End` call.
+  void BeginGroup() {
+    toml::node *node = nullptr;
+    if (IsList()) {
+      node = &Insert(toml::table{});
+    } else {
+      const auto [parent, name] = ResolvePendingKey();
+      // Groups are merged, all other existing values will be replaced.
+      node = parent->get(name);
+      if ((node == nullptr) || !node->is_table()) {
+        node = &parent->insert_or_assign(name, toml::table{}).first->second;
+      }
+    }
+    Push(node);
+  }
+
+  /// @brief Starts a nested list, i.e. subsequent values will be appended to
+  ///   this list until the matching `End` call.
+  void BeginList() { Push(&Insert(toml::array{})); }
+
+  /// @brief Ends the current group/list.
+  /// @return The completed group/list.
+  toml::node &End() {
+    // LCOV_EXCL_START
+    if (stack_.size() < 2) {
+      throw std::logic_error{
+          "Cannot end the root group in `TreeBuilder`! Please report at "
+          "https://github.com/snototter/werkzeugkiste/issues"};
+    }
+    // LCOV_EXCL_STOP
+    toml::node *container = stack_.back().container;
+    stack_.pop_back();
+    return *container;
+  }
+
+  /// @brief Applies the `NullValuePolicy` to a null/none value at the current
+  ///   position (see `Configuration::HandleNullValue`).
+  void Null(NullValuePolicy policy) {
+    switch (policy) {
+      case NullValuePolicy::Skip:
+        break;
+
+      case NullValuePolicy::NullString:
+        Scalar(std::string{"null"});
+        break;
+
+      case NullValuePolicy::EmptyList:
+        BeginList();
+        End();
+        break;
+
+      case NullValuePolicy::Fail: {
+        std::string msg{"Null/None value occured while parsing parameter `"};
+        msg += CurrentPath();
+        msg += "`!";
+        throw ParseError{msg};
+      }
+    }
+  }
+
+  /// @brief Returns true if values will be appended to a list.
+  bool IsList() const { return stack_.back().container->is_array(); }
+
+  /// @brief Returns the fully qualified parameter name of the next value.
+  std::string CurrentPath() const {
+    std::string path{};
+    for (std::size_t idx = 1; idx < stack_.size(); ++idx) {
+      AppendSegment(path, *stack_[idx - 1].container, stack_[idx]);
+    }
+
+    const Frame next{nullptr, pending_key_, ChildIndex()};
+    AppendSegment(path, *stack_.back().container, next);
+    return path;
+  }
+
+  /// @brief Returns the configuration. Must be called after all groups and
+  ///   lists have been closed.
+  Configuration Release() {
+    stack_.resize(1);
+    return ConfigurationAccess::FromTable(std::move(root_));
+  }
+
+ private:
+  /// @brief A container which is currently being filled.
+  struct Frame {
+    /// Either a toml::table or a toml::array.
+    toml::node *container;
+
+    /// Key of this container within its parent group.
+    std::string key;
+
+    /// Index of this container within its parent list.
+    std::size_t index;
+  };
+
+  /// The root group.
+  toml::table root_{};
+
+  /// The containers from the root to the current group/list.
+  std::vector<Frame> stack_{};
+
+  /// Key of the next value (if added to a group).
+  std::string pending_key_{};
+
+  static toml::time ToTomlTime(const time &value) {
+    return toml::time{value.hour, value.minute, value.second, value.nanosecond};
+  }
+
+  std::size_t ChildIndex() const {
+    const toml::array *arr = stack_.back().container->as_array();
+    return (arr != nullptr) ? arr->size() : 0;
+  }
+
+  static void AppendSegment(std::string &path,
+      const toml::node &parent,
+      const Frame &frame) {
+    if (parent.is_array()) {
+      path += '[';
+      path += std::to_string(frame.index);
+      path += ']';
+    } else {
+      if (!path.empty()) {
+        path += '.';
+      }
+      path += frame.key;
+    }
+  }
+
+  void Push(toml::node *container) {
+    stack_.push_back(Frame{container, IsList() ? std::string{} : pending_key_,
+        IsList() ? ChildIndex() - 1 : 0});
+  }
+
+  /// @brief Creates the intermediate groups of a dotted key.
+  /// @return The parent group and the name of the value within this group.
+  std::pair<toml::table *, std::string_view> ResolvePendingKey() {
+    toml::table *tbl = stack_.back().container->as_table();
+    std::string_view name{pending_key_};
+    std::size_t pos = name.find('.');
+    while (pos != std::string_view::npos) {
+      const std::string_view ancestor = name.substr(0, pos);
+      toml::node *node = tbl->get(ancestor);
+      if (node == nullptr) {
+        node = &tbl->insert(ancestor, toml::table{}).first->second;
+      } else if (!node->is_table()) {
+        std::string msg{"Cannot create parameter `"};
+        msg += CurrentPath();
+        msg += "`, because its parent `";
+        msg += ancestor;
+        msg += "` is not a group!";
+        throw KeyError{msg};
+      }
+      tbl = node->as_table();
+      name.remove_prefix(pos + 1);
+      pos = name.find('.');
+    }
+    return {tbl, name};
+  }
+
+  /// @brief Inserts the value into the current container.
+  template <typename Tp>
+  toml::node &Insert(Tp &&value) {
+    toml::array *arr = stack_.back().container->as_array();
+    if (arr != nullptr) {
+      arr->push_back(std::forward<Tp>(value));
+      return arr->back();
+    }
+
+    const auto [parent, name] = ResolvePendingKey();
+    return parent->insert_or_assign(name, std::forward<Tp>(value))
+        .first->second;
+  }
+};
+}  // namespace werkzeugkiste::config::detail
+
+#endif  // WERKZEUGKISTE_CONFIG_TREE_BUILDER_H
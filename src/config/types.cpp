@@ -112,6 +112,32 @@ std::ostream &operator<<(std::ostream &os, const ConfigType &ct) {
   return os;
 }
 
+std::string LookupErrorToString(const LookupError &error) {
+  switch (error) {
+    case LookupError::KeyNotFound:
+      return "key_not_found";
+
+    case LookupError::TypeMismatch:
+      return "type_mismatch";
+
+    case LookupError::NotRepresentable:
+      return "not_representable";
+  }
+
+  // LCOV_EXCL_START
+  std::ostringstream msg;
+  msg << "LookupError (" << static_cast<int>(error)
+      << ") is not handled within `LookupErrorToString`. Please file an issue "
+         "at https://github.com/snototter/werkzeugkiste/issues";
+  throw std::logic_error(msg.str());
+  // LCOV_EXCL_STOP
+}
+
+std::ostream &operator<<(std::ostream &os, const LookupError &error) {
+  os << LookupErrorToString(error);
+  return os;
+}
+
 //-----------------------------------------------------------------------------
 // Number parsing for date & time types
 template <typename T>
@@ -0,0 +1,418 @@
+#include <werkzeugkiste/config/watcher.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<sys/inotify.h>)
+#define WZK_CONFIG_HAS_INOTIFY
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif  // __linux__
+
+#include "file_state.h"
+
+namespace werkzeugkiste::config {
+namespace detail {
+/// @brief Splits a path into its directory (or "." if there is none) and the
+///   file name.
+inline std::pair<std::string, std::string> SplitDirectory(
+    const std::string &path) {
+  const std::size_t pos = path.find_last_of("/\\");
+  if (pos == std::string::npos) {
+    return {".", path};
+  }
+  return {(pos == 0) ? path.substr(0, 1) : path.substr(0, pos),
+      path.substr(pos + 1)};
+}
+}  // namespace detail
+
+struct ConfigurationWatcher::Impl {
+  using Clock = std::chrono::steady_clock;
+
+  const std::string filename;
+  const WatcherOptions options;
+
+  /// Must only be accessed via the atomic `std::shared_ptr` functions.
+  std::shared_ptr<const Configuration> current{};
+  std::atomic<uint64_t> version{0};
+
+  /// Guards the members below.
+  mutable std::mutex mutex{};
+  std::vector<std::string> files{};
+  std::string last_error{};
+  Callback callback{};
+
+  std::atomic<bool> stop{false};
+  std::condition_variable stop_cv{};
+  std::atomic<bool> polling{true};
+  std::thread thread{};
+
+#ifdef WZK_CONFIG_HAS_INOTIFY
+  /// Self-pipe to wake up the (inotify) watcher thread on shutdown.
+  int wakeup_fds[2]{-1, -1};
+#endif  // WZK_CONFIG_HAS_INOTIFY
+
+  Impl(std::string_view fname, WatcherOptions opts)
+      : filename{fname}, options{std::move(opts)} {}
+
+  /// Loads the configuration and its nested configurations. Returns the
+  /// configuration and the list of loaded files.
+  std::pair<Configuration, std::vector<std::string>> Load() const {
+    std::vector<std::string> loaded_files{filename};
+    Configuration cfg = LoadFile(filename);
+    for (const auto &key : options.nested_keys) {
+      if (cfg.Contains(key) && (cfg.Type(key) == ConfigType::String)) {
+        loaded_files.push_back(cfg.GetString(key));
+      }
+      cfg.LoadNestedConfiguration(key);
+    }
+    return {std::move(cfg), std::move(loaded_files)};
+  }
+
+  /// Replaces the current snapshot. The version is only increased after
+  /// the callback returned, thus, whoever observes the new version also
+  /// observes the callback's effects.
+  void Publish(Configuration &&cfg,
+      const Callback &notify = {},
+      const ConfigurationDiff *diff = nullptr) {
+    const std::shared_ptr<const Configuration> snapshot =
+        std::make_shared<Configuration>(std::move(cfg));
+    std::atomic_store(&current, snapshot);
+    if (notify && (diff != nullptr)) {
+      // Exceptions must not escape the watcher thread.
+      try {
+        notify(*snapshot, *diff);
+      } catch (const std::exception &e) {
+        std::lock_guard<std::mutex> lock{mutex};
+        last_error = e.what();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{mutex};
+        last_error = "Unknown exception raised by the reload callback.";
+      }
+    }
+    ++version;
+  }
+
+  /// Reloads the configuration (on the watcher thread). Returns true if the
+  /// watched files changed.
+  bool Reload() {
+    std::pair<Configuration, std::vector<std::string>> loaded{};
+    try {
+      loaded = Load();
+    } catch (const std::exception &e) {
+      std::lock_guard<std::mutex> lock{mutex};
+      last_error = e.what();
+      return false;
+    }
+
+    const auto previous = std::atomic_load(&current);
+    const ConfigurationDiff diff = previous->Diff(loaded.first);
+
+    Callback notify{};
+    bool files_changed{false};
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      last_error.clear();
+      files_changed = (files != loaded.second);
+      files = std::move(loaded.second);
+      if (!diff.Empty()) {
+        notify = callback;
+      }
+    }
+
+    if (!diff.Empty()) {
+      Publish(std::move(loaded.first), notify, &diff);
+    }
+    return files_changed;
+  }
+
+  std::vector<std::string> Files() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return files;
+  }
+
+  void Start() {
+    auto loaded = Load();
+    files = std::move(loaded.second);
+    Publish(std::move(loaded.first));
+
+#ifdef WZK_CONFIG_HAS_INOTIFY
+    if (!options.force_polling) {
+      const int notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (notify_fd >= 0) {
+        if (pipe2(wakeup_fds, O_NONBLOCK | O_CLOEXEC) == 0) {
+          polling = false;
+          // Watches must be set up before returning, otherwise we could miss
+          // modifications.
+          WatchList watches = AddWatches(notify_fd, files);
+          thread = std::thread{[this, notify_fd, watches]() mutable {
+            RunNotify(notify_fd, std::move(watches));
+          }};
+          return;
+        }
+        // LCOV_EXCL_START
+        close(notify_fd);
+        // LCOV_EXCL_STOP
+      }
+    }
+#endif  // WZK_CONFIG_HAS_INOTIFY
+
+    std::vector<detail::FileState> states{};
+    for (const auto &fname : files) {
+      states.push_back(detail::FileState::Query(fname));
+    }
+    thread = std::thread{[this, states]() mutable {
+      RunPolling(std::move(states));
+    }};
+  }
+
+  void Stop() {
+    stop = true;
+    {
+      // Ensure that the polling thread is either waiting or will see the
+      // stop flag.
+      std::lock_guard<std::mutex> lock{mutex};
+    }
+    stop_cv.notify_all();
+#ifdef WZK_CONFIG_HAS_INOTIFY
+    if (wakeup_fds[1] >= 0) {
+      const char byte{0};
+      [[maybe_unused]] const auto written = write(wakeup_fds[1], &byte, 1);
+    }
+#endif  // WZK_CONFIG_HAS_INOTIFY
+    if (thread.joinable()) {
+      thread.join();
+    }
+#ifdef WZK_CONFIG_HAS_INOTIFY
+    for (int &fd : wakeup_fds) {
+      if (fd >= 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+#endif  // WZK_CONFIG_HAS_INOTIFY
+  }
+
+  void RunPolling(std::vector<detail::FileState> states) {
+    auto watched = Files();
+
+    bool pending{false};
+    Clock::time_point last_change{};
+    while (!stop) {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        const auto interval =
+            pending ? std::min(options.poll_interval, options.debounce)
+                    : options.poll_interval;
+        stop_cv.wait_for(lock, interval, [this]() { return stop.load(); });
+      }
+      if (stop) {
+        break;
+      }
+
+      for (std::size_t idx = 0; idx < watched.size(); ++idx) {
+        const auto state = detail::FileState::Query(watched[idx]);
+        if (state != states[idx]) {
+          states[idx] = state;
+          pending = true;
+          last_change = Clock::now();
+        }
+      }
+
+      if (pending && ((Clock::now() - last_change) >= options.debounce)) {
+        pending = false;
+        if (Reload()) {
+          watched = Files();
+          states.clear();
+          for (const auto &fname : watched) {
+            states.push_back(detail::FileState::Query(fname));
+          }
+        }
+      }
+    }
+  }
+
+#ifdef WZK_CONFIG_HAS_INOTIFY
+  /// Watched file names per inotify watch descriptor (i.e. directory).
+  using WatchList = std::vector<std::pair<int, std::vector<std::string>>>;
+
+  /// Watches the directories of the given files, because editors often
+  /// replace a file instead of modifying it.
+  static WatchList AddWatches(int notify_fd,
+      const std::vector<std::string> &watched) {
+    WatchList watches{};
+    for (const auto &fname : watched) {
+      const auto split = detail::SplitDirectory(fname);
+      const int wd = inotify_add_watch(notify_fd, split.first.c_str(),
+          IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+      if (wd < 0) {
+        continue;
+      }
+
+      auto it = std::find_if(watches.begin(), watches.end(),
+          [wd](const auto &entry) { return entry.first == wd; });
+      if (it == watches.end()) {
+        watches.emplace_back(wd, std::vector<std::string>{});
+        it = watches.end() - 1;
+      }
+      it->second.push_back(split.second);
+    }
+    return watches;
+  }
+
+  static void RemoveWatches(int notify_fd, const WatchList &watches) {
+    for (const auto &entry : watches) {
+      inotify_rm_watch(notify_fd, entry.first);
+    }
+  }
+
+  /// Result of reading the pending inotify events.
+  struct Events {
+    /// True if any event refers to a watched file, or if events were lost.
+    bool relevant{false};
+
+    /// True if a watch was removed (e.g. because its directory has been
+    /// deleted or moved) and the watches must be set up again.
+    bool rewatch{false};
+  };
+
+  /// Reads all pending events of the watched directories.
+  static Events ReadEvents(int notify_fd, const WatchList &watches) {
+    Events events{};
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+      const ssize_t length = read(notify_fd, buffer, sizeof(buffer));
+      if (length <= 0) {
+        return events;
+      }
+
+      for (ssize_t offset = 0; offset < length;) {
+        const auto *event =
+            reinterpret_cast<const struct inotify_event *>(buffer + offset);
+        offset += static_cast<ssize_t>(sizeof(struct inotify_event)) +
+                  static_cast<ssize_t>(event->len);
+        if ((event->mask & IN_Q_OVERFLOW) != 0) {
+          // The kernel's event queue overflowed, so we might have missed a
+          // modification of a watched file.
+          events.relevant = true;
+          continue;
+        }
+        if ((event->mask & IN_IGNORED) != 0) {
+          // Removing our own (outdated) watches also yields IN_IGNORED, thus
+          // only the currently active ones are considered.
+          if (std::any_of(watches.begin(), watches.end(),
+                  [event](const auto &entry) {
+                    return entry.first == event->wd;
+                  })) {
+            events.relevant = true;
+            events.rewatch = true;
+          }
+          continue;
+        }
+        if (event->len == 0) {
+          continue;
+        }
+
+        const std::string_view name{event->name};
+        for (const auto &entry : watches) {
+          if (entry.first != event->wd) {
+            continue;
+          }
+          for (const auto &watched_name : entry.second) {
+            events.relevant |= (watched_name == name);
+          }
+        }
+      }
+    }
+  }
+
+  void RunNotify(int notify_fd, WatchList watches) {
+    bool rewatch{false};
+    bool pending{false};
+    Clock::time_point last_change{};
+    std::array<struct pollfd, 2> fds{};
+    fds[0].fd = notify_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = wakeup_fds[0];
+    fds[1].events = POLLIN;
+    while (!stop) {
+      int timeout_ms{-1};
+      if (pending) {
+        const auto remaining = options.debounce - (Clock::now() - last_change);
+        timeout_ms = std::max(0,
+            static_cast<int>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    remaining)
+                    .count()));
+      }
+
+      const int ready = poll(fds.data(), fds.size(), timeout_ms);
+      if (stop) {
+        break;
+      }
+
+      if ((ready > 0) && ((fds[0].revents & POLLIN) != 0)) {
+        const Events events = ReadEvents(notify_fd, watches);
+        rewatch |= events.rewatch;
+        if (events.relevant) {
+          pending = true;
+          last_change = Clock::now();
+        }
+      }
+
+      if (pending && ((Clock::now() - last_change) >= options.debounce)) {
+        pending = false;
+        if (Reload() || rewatch) {
+          rewatch = false;
+          RemoveWatches(notify_fd, watches);
+          watches = AddWatches(notify_fd, Files());
+        }
+      }
+    }
+    close(notify_fd);
+  }
+#endif  // WZK_CONFIG_HAS_INOTIFY
+};
+
+ConfigurationWatcher::ConfigurationWatcher(std::string_view filename,
+    WatcherOptions options)
+    : pimpl_{std::make_unique<Impl>(filename, std::move(options))} {
+  pimpl_->Start();
+}
+
+ConfigurationWatcher::~ConfigurationWatcher() { pimpl_->Stop(); }
+
+std::shared_ptr<const Configuration> ConfigurationWatcher::Current() const {
+  return std::atomic_load(&pimpl_->current);
+}
+
+uint64_t ConfigurationWatcher::Version() const { return pimpl_->version; }
+
+std::string ConfigurationWatcher::LastError() const {
+  std::lock_guard<std::mutex> lock{pimpl_->mutex};
+  return pimpl_->last_error;
+}
+
+std::vector<std::string> ConfigurationWatcher::WatchedFiles() const {
+  return pimpl_->Files();
+}
+
+bool ConfigurationWatcher::IsPolling() const { return pimpl_->polling; }
+
+void ConfigurationWatcher::OnReload(Callback callback) {
+  std::lock_guard<std::mutex> lock{pimpl_->mutex};
+  pimpl_->callback = std::move(callback);
+}
+}  // namespace werkzeugkiste::config
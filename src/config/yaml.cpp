@@ -3,78 +3,24 @@
 #include <werkzeugkiste/strings/strings.h>
 
 // NOLINTBEGIN
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/yaml.h>
 // NOLINTEND
 
-#include <fstream>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <streambuf>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
-// NOLINTBEGIN(readability-identifier-naming, misc-no-recursion)
-namespace YAML {
-/// @brief YAML converter to load a YAML node as a date.
-template <>
-struct convert<werkzeugkiste::config::date> {
-  static bool decode(const Node &node, werkzeugkiste::config::date &rhs) {
-    if (!node.IsScalar()) {
-      return false;
-    }
-
-    try {
-      rhs = werkzeugkiste::config::date(node.as<std::string>());
-      return true;
-    } catch (const werkzeugkiste::config::ParseError &) {
-      return false;
-    }
-  }
-};
-
-/// @brief YAML converter to load a YAML node as a time.
-template <>
-struct convert<werkzeugkiste::config::time> {
-  static bool decode(const Node &node, werkzeugkiste::config::time &rhs) {
-    if (!node.IsScalar()) {
-      return false;
-    }
-
-    try {
-      rhs = werkzeugkiste::config::time(node.as<std::string>());
-      return true;
-    } catch (const werkzeugkiste::config::ParseError &) {
-      return false;
-    }
-  }
-};
-
-/// @brief YAML converter to load a YAML node as a date-time.
-template <>
-struct convert<werkzeugkiste::config::date_time> {
-  static bool decode(const Node &node, werkzeugkiste::config::date_time &rhs) {
-    if (!node.IsScalar()) {
-      return false;
-    }
-
-    try {
-      rhs = werkzeugkiste::config::date_time(node.as<std::string>());
-      return true;
-    } catch (const werkzeugkiste::config::ParseError &) {
-      return false;
-    }
-  }
-};
-}  // namespace YAML
-// NOLINTEND(readability-identifier-naming, misc-no-recursion)
+#include "tree_builder.h"
 
 namespace werkzeugkiste::config {
 namespace detail {
-// Forward declaration
-Configuration FromYAMLNode(const YAML::Node &node, NullValuePolicy none_policy);
-
-void AppendListItems(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view key,
-    NullValuePolicy none_policy);
-
 // LCOV_EXCL_START
 /// @brief Throws a std::logic_error with a hint to report an error.
 /// @param prefix Error message prefix.
@@ -96,359 +42,394 @@ inline void ThrowImplementationError(std::string_view prefix,
 }
 // LCOV_EXCL_STOP
 
-/// @brief Appends or sets a configuration value from a decoded scalar value.
-/// @tparam Tp Type of the scalar value.
-/// @param value The decoded value.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name.
-/// @param append If true, fqn is assumed to be a list and the value will be
-///   `Append`ed. Otherwise, the value will be `Set`.
-template <typename Tp>
-void AppendOrSet(Tp value,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  if (append) {
-    cfg.Append(fqn, value);
-  } else {
-    cfg.Set(fqn, value);
-  }
-}
-
-/// @brief Returns true if the scalar node is tagged, i.e. has a
-/// non-s
-inline bool ScalarHasTag(const YAML::Node &node) {
-  if (!node.IsScalar()) {
-    // LCOV_EXCL_START
-    // This should never happen.
-    return false;
-    // LCOV_EXCL_STOP
-  }
-  const std::string &tag = node.Tag();
+/// @brief Returns true if the scalar is tagged, i.e. has a non-specific tag.
+inline bool ScalarHasTag(const std::string &tag) {
   return (!tag.empty() && (tag != "?"));
 }
 
+/// @brief Tries to parse the scalar as one of our date/time types.
 template <typename Tp>
-std::optional<Tp> DecodeUntaggedScalarNode(const YAML::Node &node) {
-  if (!node.IsScalar()) {
-    // LCOV_EXCL_START
-    // This should never happen.
+std::optional<Tp> DecodeDateTimeScalar(const std::string &value) {
+  try {
+    return Tp{value};
+  } catch (const ParseError &) {
     return std::nullopt;
-    // LCOV_EXCL_STOP
-  }
-
-  // Use YAML::convert to avoid YAML::BadConversion being thrown.
-  Tp typed;
-  if (YAML::convert<Tp>::decode(node, typed)) {
-    return typed;
   }
-
-  return std::nullopt;
 }
 
-void DecodeDateOrDateTime(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  // A YAML date can be either a date or a date-time.
-  date val_date{};
-  date_time val_dt{};
-  if (YAML::convert<date>::decode(node, val_date)) {
-    AppendOrSet(val_date, cfg, fqn, append);
-  } else if (YAML::convert<date_time>::decode(node, val_dt)) {
-    AppendOrSet(val_dt, cfg, fqn, append);
-  } else {
-    std::string msg{
-        "Failed to parse date from YAML node `" + node.Scalar() + "`!"};
-    throw ParseError{msg};
-  }
-}
+/// @brief Event handler which builds the configuration while parsing, i.e.
+///   without creating an intermediate YAML document.
+///
+/// Because a `Configuration` must consist of key/value pairs, a top-level
+/// YAML sequence will be loaded into the key `list`. Anchored nodes are
+/// copied whenever they are referenced by an alias.
+class YAMLBuilder : public YAML::EventHandler {
+ public:
+  explicit YAMLBuilder(NullValuePolicy none_policy)
+      : none_policy_{none_policy} {}
+
+  void OnDocumentStart(const YAML::Mark & /*mark*/) override {}
+
+  void OnDocumentEnd() override {}
+
+  void OnNull(const YAML::Mark & /*mark*/, YAML::anchor_t anchor) override {
+    if (anchor != YAML::NullAnchor) {
+      Anchor &anchored = anchors_[anchor];
+      anchored = Anchor{};
+      anchored.is_null = true;
+      // Same as `YAML::Node::as<std::string>()` for a null node.
+      anchored.text = "null";
+    }
 
-void DecodeTime(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  // A YAML time can be either a time or a date-time.
-  time val_time{};
-  date_time val_dt{};
-  if (YAML::convert<time>::decode(node, val_time)) {
-    AppendOrSet(val_time, cfg, fqn, append);
-  } else if (YAML::convert<date_time>::decode(node, val_dt)) {
-    AppendOrSet(val_dt, cfg, fqn, append);
-  } else {
-    std::string msg{
-        "Failed to parse time from YAML node `" + node.Scalar() + "`!"};
-    throw ParseError{msg};
+    if (IsKey()) {
+      SetKey("null");
+      return;
+    }
+
+    EnsureContainer();
+    builder_.Null(none_policy_);
+    ValueDone();
   }
-}
 
-/// @brief Simplified node handling if the node is tagged.
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
-void HandleTaggedScalar(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  if (!ScalarHasTag(node)) {
+  void OnAlias(const YAML::Mark & /*mark*/, YAML::anchor_t anchor) override {
+    if (!IsKey()) {
+      EnsureContainer();
+    }
+    const auto it = anchors_.find(anchor);
     // LCOV_EXCL_START
-    // This should never happen.
-    ThrowImplementationError(
-        "HandleTaggedScalar called with untagged node", fqn);
+    // The parser already rejects undefined aliases.
+    if (it == anchors_.end()) {
+      ThrowImplementationError(
+          "YAML alias references an unknown anchor", builder_.CurrentPath());
+    }
     // LCOV_EXCL_STOP
+
+    const Anchor &anchored = it->second;
+    if (IsKey()) {
+      if (!anchored.text.has_value()) {
+        throw ParseError{"Only scalars are supported as YAML map keys!"};
+      }
+      SetKey(*anchored.text);
+      return;
+    }
+
+    if (anchored.is_null) {
+      builder_.Null(none_policy_);
+    } else if (anchored.node != nullptr) {
+      builder_.Copy(*anchored.node);
+    } else {
+      // An anchored key is decoded like any other scalar value.
+      DecodeScalar(anchored.tag, *anchored.text);
+    }
+    ValueDone();
   }
 
-  // TODO document supported tags
-  // !!str "some string"
-  // !!bool !!int !!float !!date !!timestamp
-  // non-standard local tags: !date !time
-  // https://yaml.org/type/timestamp.html
-
-  const std::string &tag = node.Tag();
-  const std::string &value = node.Scalar();
-  if ((tag == "tag:yaml.org,2002:str") || (tag == "!")) {
-    // If a node has the "!" (non-specific) tag, it is either a map, sequence
-    // or string. Since we already checked for it being a scalar, "!" must
-    // indicate it is a string according to the specification:
-    // https://yaml.org/spec/1.2.2/
-    AppendOrSet(value, cfg, fqn, append);
-  } else if (tag == "tag:yaml.org,2002:bool") {
-    AppendOrSet(node.as<bool>(), cfg, fqn, append);
-  } else if (tag == "tag:yaml.org,2002:int") {
-    const int64_t val = std::stol(value);
-    AppendOrSet(val, cfg, fqn, append);
-  } else if (tag == "tag:yaml.org,2002:float") {
-    AppendOrSet(std::stod(value), cfg, fqn, append);
-  } else if ((tag == "tag:yaml.org,2002:date") ||
-             (tag == "tag:yaml.org,2002:timestamp") || (tag == "!date")) {
-    DecodeDateOrDateTime(node, cfg, fqn, append);
-  } else if ((tag == "tag:yaml.org,2002:time") || (tag == "!time")) {
-    DecodeTime(node, cfg, fqn, append);
-  } else {
-    std::string msg{"YAML tag `" + tag + "` for parameter `"};
-    msg += fqn;
-    msg += "` is not supported!";
-    throw ParseError{msg};
+  void OnScalar(const YAML::Mark & /*mark*/,
+      const std::string &tag,
+      YAML::anchor_t anchor,
+      const std::string &value) override {
+    if (IsKey()) {
+      RememberKeyAnchor(anchor, tag, value);
+      SetKey(value);
+      return;
+    }
+
+    EnsureContainer();
+    RememberAnchor(anchor, DecodeScalar(tag, value), &value);
+    ValueDone();
   }
-}
 
-/// @brief Tries to decode the scalar node into a value of type Tp. Upon
-///   success, the value is set or appended to the configuration.
-/// @tparam Tp Type to decode the node into.
-/// @param node The YAML node which holds the scalar.
-/// @param cfg The configuration.
-/// @param fqn The fully qualified parameter name.
-/// @param append If true, the value is `Append`ed (assuming that `fqn` is an
-///   existing list). Otherwise, the value is `Set`.
-/// @return true if the node was decoded successfully, false otherwise.
-template <typename Tp>
-bool HandleUntaggedScalar(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  const auto val = DecodeUntaggedScalarNode<Tp>(node);
-  if (!val.has_value()) {
-    return false;
+  void OnSequenceStart(const YAML::Mark & /*mark*/,
+      const std::string & /*tag*/,
+      YAML::anchor_t anchor,
+      YAML::EmitterStyle::value /*style*/) override {
+    if (IsKey()) {
+      throw ParseError{"Only scalars are supported as YAML map keys!"};
+    }
+
+    if (frames_.empty()) {
+      builder_.Key("list");
+    }
+    builder_.BeginList();
+    frames_.push_back(Frame{anchor, /*is_map=*/false, /*expects_key=*/false});
   }
 
-  if (append) {
-    cfg.Append(fqn, val.value());
-  } else {
-    cfg.Set(fqn, val.value());
+  void OnSequenceEnd() override { EndContainer(); }
+
+  void OnMapStart(const YAML::Mark & /*mark*/,
+      const std::string & /*tag*/,
+      YAML::anchor_t anchor,
+      YAML::EmitterStyle::value /*style*/) override {
+    if (IsKey()) {
+      throw ParseError{"Only scalars are supported as YAML map keys!"};
+    }
+
+    // The top-level map is the configuration root.
+    if (!frames_.empty()) {
+      builder_.BeginGroup();
+    }
+    frames_.push_back(Frame{anchor, /*is_map=*/true, /*expects_key=*/true});
   }
-  return true;
-}
 
-/// @brief Sets or appends the scalar value to the configuration.
-/// @param node The YAML node which holds the scalar.
-/// @param cfg The configuration.
-/// @param fqn The fully qualified parameter name.
-/// @param append If true, the value is appended (assuming that key is an
-///   existing list). Otherwise, the value is Set<T> according to the
-///   deduced type.
-void HandleScalarNode(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    bool append) {
-  if (ScalarHasTag(node)) {
-    HandleTaggedScalar(node, cfg, fqn, append);
-    return;
+  void OnMapEnd() override { EndContainer(); }
+
+  Configuration Release() {
+    if (!has_root_) {
+      throw ParseError{
+          "Could not parse YAML, because root node is neither a map nor a "
+          "sequence!"};
+    }
+    return builder_.Release();
   }
 
-  // Node is not tagged, so we try to decode it into the supported types.
-  if (HandleUntaggedScalar<bool>(node, cfg, fqn, append)) {
-    return;
+ private:
+  /// @brief A map/sequence which is currently being parsed.
+  struct Frame {
+    YAML::anchor_t anchor;
+    bool is_map;
+    bool expects_key;
+  };
+
+  TreeBuilder builder_{};
+  NullValuePolicy none_policy_{NullValuePolicy::Skip};
+  std::vector<Frame> frames_{};
+  bool has_root_{false};
+
+  /// @brief A node which can be referenced by an alias.
+  struct Anchor {
+    /// Copy of the anchored node in `anchored_nodes_`. Is nullptr for null
+    /// values and for keys, which are decoded from `text` if referenced as
+    /// a value.
+    const toml::node *node{nullptr};
+
+    /// Raw text of an anchored scalar (or key), which is used if the anchor
+    /// is referenced as a map key. Not set for maps and sequences.
+    std::optional<std::string> text{};
+
+    /// Tag of an anchored key.
+    std::string tag{};
+
+    /// True if the anchor denotes a null value.
+    bool is_null{false};
+  };
+
+  /// Copies of all anchored nodes.
+  toml::array anchored_nodes_{};
+
+  std::unordered_map<YAML::anchor_t, Anchor> anchors_{};
+
+  /// Reusable node to decode untagged scalars via `YAML::convert`.
+  YAML::Node scalar_{YAML::NodeType::Scalar};
+
+  bool IsKey() const { return !frames_.empty() && frames_.back().expects_key; }
+
+  void SetKey(const std::string &key) {
+    builder_.Key(key);
+    frames_.back().expects_key = false;
   }
 
-  if (HandleUntaggedScalar<int64_t>(node, cfg, fqn, append)) {
-    return;
+  void ValueDone() {
+    if (frames_.back().is_map) {
+      frames_.back().expects_key = true;
+    }
   }
 
-  if (HandleUntaggedScalar<double>(node, cfg, fqn, append)) {
-    return;
+  /// Raises a `ParseError` if a scalar occurs outside of a map/sequence.
+  void EnsureContainer() const {
+    if (frames_.empty()) {
+      throw ParseError{
+          "Could not parse YAML, because root node is neither a map nor a "
+          "sequence!"};
+    }
   }
 
-  if (HandleUntaggedScalar<date>(node, cfg, fqn, append)) {
-    return;
+  void EndContainer() {
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+    if (frames_.empty()) {
+      has_root_ = true;
+      if (!frame.is_map) {
+        builder_.End();
+      }
+      return;
+    }
+
+    RememberAnchor(frame.anchor, builder_.End());
+    ValueDone();
   }
 
-  if (HandleUntaggedScalar<time>(node, cfg, fqn, append)) {
-    return;
+  /// Remembers an anchored value. For scalars, `text` is the raw scalar.
+  void RememberAnchor(YAML::anchor_t anchor,
+      const toml::node &node,
+      const std::string *text = nullptr) {
+    if (anchor != YAML::NullAnchor) {
+      // Array elements are heap-allocated, i.e. the pointer remains valid.
+      anchored_nodes_.push_back(node);
+      Anchor &anchored = anchors_[anchor];
+      anchored = Anchor{};
+      anchored.node = &anchored_nodes_.back();
+      if (text != nullptr) {
+        anchored.text = *text;
+      }
+    }
   }
 
-  // TODO test date types - YAML date examples used a more lenient format; need
-  // to check in detail
-  if (HandleUntaggedScalar<date_time>(node, cfg, fqn, append)) {
-    return;
+  void RememberKeyAnchor(YAML::anchor_t anchor,
+      const std::string &tag,
+      const std::string &text) {
+    if (anchor != YAML::NullAnchor) {
+      Anchor &anchored = anchors_[anchor];
+      anchored = Anchor{};
+      anchored.text = text;
+      anchored.tag = tag;
+    }
   }
 
-  // Any scalar can be represented as a string, thus ensure to check it last!
-  if (HandleUntaggedScalar<std::string>(node, cfg, fqn, append)) {
-    return;
+  /// Inserts the scalar, either as tagged or by deducing its type.
+  toml::node &DecodeScalar(const std::string &tag, const std::string &value) {
+    return ScalarHasTag(tag) ? HandleTaggedScalar(tag, value)
+                             : HandleUntaggedScalar(value);
   }
 
-  // LCOV_EXCL_START
-  // This should never happen (any scalar should be convertible to a string).
-  ThrowImplementationError("Could not decode the YAML scalar", fqn);
-  // LCOV_EXCL_STOP
-}
+  /// @brief Simplified scalar handling if the scalar is tagged.
+  // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  toml::node &HandleTaggedScalar(const std::string &tag,
+      const std::string &value) {
+    // TODO document supported tags
+    // !!str "some string"
+    // !!bool !!int !!float !!date !!timestamp
+    // non-standard local tags: !date !time
+    // https://yaml.org/type/timestamp.html
+    if ((tag == "tag:yaml.org,2002:str") || (tag == "!")) {
+      // If a node has the "!" (non-specific) tag, it is either a map,
+      // sequence or string. Since we already know it is a scalar, "!" must
+      // indicate it is a string according to the specification:
+      // https://yaml.org/spec/1.2.2/
+      return builder_.Scalar(value);
+    }
 
-/// @brief Appends or sets a configuration value from a parsed YAML node.
-/// @param node Value to be added to the configuration.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name.
-/// @param append If true, fqn is assumed to be a list and the value will be
-///   appended. Otherwise, the value will be set, i.e. "cfg[fqn] = value";
-// NOLINTNEXTLINE(misc-no-recursion)
-void HandleNode(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    NullValuePolicy none_policy,
-    bool append) {
-  switch (node.Type()) {
-    case YAML::NodeType::Null:
-      Configuration::HandleNullValue(cfg, fqn, none_policy, append);
-      break;
-
-    case YAML::NodeType::Scalar:
-      HandleScalarNode(node, cfg, fqn, append);
-      break;
-
-    case YAML::NodeType::Sequence: {
-      if (append) {
-        const std::size_t lst_size = cfg.Size(fqn);
-        const std::string elem_key =
-            Configuration::KeyForListElement(fqn, lst_size);
-        cfg.AppendList(fqn);
-        AppendListItems(node, cfg, elem_key, none_policy);
-      } else {
-        cfg.CreateList(fqn);
-        AppendListItems(node, cfg, fqn, none_policy);
-      }
-      break;
+    if (tag == "tag:yaml.org,2002:bool") {
+      scalar_ = value;
+      return builder_.Scalar(scalar_.as<bool>());
+    }
+
+    if (tag == "tag:yaml.org,2002:int") {
+      const int64_t val = std::stol(value);
+      return builder_.Scalar(val);
     }
 
-    case YAML::NodeType::Map: {
-      if (append) {
-        cfg.Append(fqn, FromYAMLNode(node, none_policy));
-      } else {
-        cfg.Set(fqn, FromYAMLNode(node, none_policy));
+    if (tag == "tag:yaml.org,2002:float") {
+      return builder_.Scalar(std::stod(value));
+    }
+
+    if ((tag == "tag:yaml.org,2002:date") ||
+        (tag == "tag:yaml.org,2002:timestamp") || (tag == "!date")) {
+      // A YAML date can be either a date or a date-time.
+      if (const auto val = DecodeDateTimeScalar<date>(value)) {
+        return builder_.Scalar(val.value());
       }
-      break;
+      if (const auto val = DecodeDateTimeScalar<date_time>(value)) {
+        return builder_.Scalar(val.value());
+      }
+      throw ParseError{"Failed to parse date from YAML node `" + value + "`!"};
     }
 
-    // LCOV_EXCL_START
-    case YAML::NodeType::Undefined: {
-      std::string msg{"Undefined YAML node type for parameter `"};
-      msg += fqn;
-      msg += "`!";
-      throw TypeError{msg};
+    if ((tag == "tag:yaml.org,2002:time") || (tag == "!time")) {
+      // A YAML time can be either a time or a date-time.
+      if (const auto val = DecodeDateTimeScalar<time>(value)) {
+        return builder_.Scalar(val.value());
+      }
+      if (const auto val = DecodeDateTimeScalar<date_time>(value)) {
+        return builder_.Scalar(val.value());
+      }
+      throw ParseError{"Failed to parse time from YAML node `" + value + "`!"};
     }
-      // LCOV_EXCL_STOP
-  }
-}
 
-/// @brief Appends all child nodes of the given YAML list to the configuration.
-/// @param node The YAML list.
-/// @param cfg Configuration to be modified.
-/// @param fqn Fully qualified parameter name. This must be a list already
-///   existing in the configuration.
-/// @param none_policy How to deal with null/none values.
-// NOLINTNEXTLINE(misc-no-recursion)
-void AppendListItems(const YAML::Node &node,
-    Configuration &cfg,
-    std::string_view fqn,
-    NullValuePolicy none_policy) {
-  // LCOV_EXCL_START
-  // The following failures should never happen, unless we messed
-  //  up the internal logic.
-  if (!node.IsSequence()) {
-    ThrowImplementationError(
-        "Internal util `AppendListItem` called without sequence node", fqn);
-  }
-  if (!cfg.Contains(fqn)) {
-    ThrowImplementationError(
-        "Internal util `AppendListItem` called without existing list", fqn);
+    std::string msg{"YAML tag `" + tag + "` for parameter `"};
+    msg += builder_.CurrentPath();
+    msg += "` is not supported!";
+    throw ParseError{msg};
   }
-  // LCOV_EXCL_STOP
 
-  for (const auto &item : node) {
-    HandleNode(item, cfg, fqn, none_policy, /*append=*/true);
-  }
-}
+  /// @brief Deduces the type of an untagged scalar.
+  toml::node &HandleUntaggedScalar(const std::string &value) {
+    // Use YAML::convert to avoid YAML::BadConversion being thrown.
+    scalar_ = value;
+    bool flag{};
+    if (YAML::convert<bool>::decode(scalar_, flag)) {
+      return builder_.Scalar(flag);
+    }
 
-/// @brief Parses a YAML map into a Configuration.
-/// @param node The YAML map.
-/// @param none_policy How to deal with null/none values.
-// NOLINTNEXTLINE(misc-no-recursion)
-Configuration FromYAMLNode(const YAML::Node &node,
-    NullValuePolicy none_policy) {
-  if (!node.IsMap()) {
-    // LCOV_EXCL_START
-    // This should never happen.
-    ThrowImplementationError(
-        "Internal util `FromYAMLNode` called without map!", "");
-    // LCOV_EXCL_STOP
-  }
+    int64_t integer{};
+    if (YAML::convert<int64_t>::decode(scalar_, integer)) {
+      return builder_.Scalar(integer);
+    }
 
-  Configuration cfg{};
-  for (YAML::const_iterator it = node.begin(); it != node.end(); ++it) {
-    const std::string key = it->first.as<std::string>();
-    HandleNode(it->second, cfg, key, none_policy, /*append=*/false);
-  }
-  return cfg;
-}
-}  // namespace detail
+    double flt{};
+    if (YAML::convert<double>::decode(scalar_, flt)) {
+      return builder_.Scalar(flt);
+    }
 
-Configuration LoadYAMLString(const std::string &yaml_string,
-    NullValuePolicy none_policy) {
-  try {
-    YAML::Node node = YAML::Load(yaml_string);
-    if (node.IsMap()) {
-      auto cfg = detail::FromYAMLNode(node, none_policy);
-      return cfg;
+    if (const auto val = DecodeDateTimeScalar<date>(value)) {
+      return builder_.Scalar(val.value());
     }
 
-    if (node.IsSequence()) {
-      Configuration cfg{};
-      const std::string_view key{"list"};
-      cfg.CreateList(key);
-      detail::AppendListItems(node, cfg, key, none_policy);
-      return cfg;
+    if (const auto val = DecodeDateTimeScalar<time>(value)) {
+      return builder_.Scalar(val.value());
     }
 
-    // LCOV_EXCL_START
-    throw ParseError{
-        "Could not parse YAML, because root node is neither a map nor a "
-        "sequence!"};
-    // LCOV_EXCL_STOP
+    // TODO test date types - YAML date examples used a more lenient format;
+    // need to check in detail
+    if (const auto val = DecodeDateTimeScalar<date_time>(value)) {
+      return builder_.Scalar(val.value());
+    }
+
+    // Any scalar can be represented as a string, thus ensure to check it last!
+    return builder_.Scalar(value);
+  }
+};
+
+/// @brief Read-only stream buffer over existing characters, i.e. allows
+///   `std::istream` access without copying them.
+class ViewStreamBuffer : public std::streambuf {
+ public:
+  explicit ViewStreamBuffer(std::string_view view) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    char *begin = const_cast<char *>(view.data());
+    setg(begin, begin, begin + view.size());
+  }
+};
+
+/// @brief Parses the first YAML document of the given stream.
+Configuration LoadYAMLStream(std::istream &stream,
+    NullValuePolicy none_policy) {
+  try {
+    YAML::Parser parser{stream};
+    YAMLBuilder builder{none_policy};
+    // Similar to `YAML::Load`, only the first document is parsed.
+    parser.HandleNextDocument(builder);
+    return builder.Release();
   } catch (const YAML::Exception &e) {
     throw ParseError(e.what());
   }
 }
+}  // namespace detail
+
+Configuration LoadYAMLString(const std::string &yaml_string,
+    NullValuePolicy none_policy) {
+  detail::ViewStreamBuffer buffer{yaml_string};
+  std::istream stream{&buffer};
+  return detail::LoadYAMLStream(stream, none_policy);
+}
 
 Configuration LoadYAMLFile(std::string_view filename,
     NullValuePolicy none_policy) {
   try {
-    return LoadYAMLString(files::CatAsciiFile(filename), none_policy);
+    // Parse directly from the mapped file content to avoid copying it.
+    const files::MappedFile file{filename};
+    detail::ViewStreamBuffer buffer{file.View()};
+    std::istream stream{&buffer};
+    return detail::LoadYAMLStream(stream, none_policy);
   } catch (const werkzeugkiste::files::IOError &e) {
     throw ParseError(e.what());
   }
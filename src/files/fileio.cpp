@@ -5,6 +5,18 @@
 #include <fstream>
 #include <sstream>
 
+#if defined(WIN32) || defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // NOMINMAX
+#include <windows.h>
+#else  // WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // WIN32
+
 namespace werkzeugkiste::files {
 
 std::vector<std::string> ReadAsciiFile(std::string_view filename) {
@@ -40,6 +52,179 @@ std::string CatAsciiFile(std::string_view filename) {
   return sstr.str();
 }
 
+namespace detail {
+[[noreturn]] void ThrowOpenError(std::string_view filename) {
+  std::string msg{"Cannot open file. Check path: \""};
+  msg += filename;
+  msg += "\".";
+  throw IOError(msg);
+}
+
+[[noreturn]] void ThrowMappingError(std::string_view filename,
+    std::string_view reason) {
+  std::string msg{"Cannot map file \""};
+  msg += filename;
+  msg += "\" into memory: ";
+  msg += reason;
+  msg += '.';
+  throw IOError(msg);
+}
+}  // namespace detail
+
+#if defined(WIN32) || defined(_WIN32)
+MappedFile::MappedFile(std::string_view filename) {
+  HANDLE file = CreateFileA(std::string(filename).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    detail::ThrowOpenError(filename);
+  }
+
+  LARGE_INTEGER file_size{};
+  if (GetFileSizeEx(file, &file_size) == 0) {
+    CloseHandle(file);
+    detail::ThrowMappingError(filename, "cannot query file size");
+  }
+
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  if (size_ == 0) {
+    // Empty files cannot be mapped.
+    CloseHandle(file);
+    return;
+  }
+
+  if (size_ <= kMaxBufferedSize) {
+    buffer_ = std::make_unique<char[]>(size_);
+    DWORD num_read{0};
+    const BOOL success = ReadFile(file, buffer_.get(),
+        static_cast<DWORD>(size_), &num_read, nullptr);
+    CloseHandle(file);
+    if (success == 0) {
+      buffer_.reset();
+      size_ = 0;
+      detail::ThrowMappingError(filename, "ReadFile failed");
+    }
+    size_ = static_cast<std::size_t>(num_read);
+    data_ = buffer_.get();
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    size_ = 0;
+    detail::ThrowMappingError(filename, "CreateFileMapping failed");
+  }
+
+  // The view keeps the mapping alive.
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (view == nullptr) {
+    size_ = 0;
+    detail::ThrowMappingError(filename, "MapViewOfFile failed");
+  }
+  data_ = static_cast<const char *>(view);
+}
+
+void MappedFile::Unmap() noexcept {
+  if ((data_ != nullptr) && !buffer_) {
+    UnmapViewOfFile(data_);
+  }
+  buffer_.reset();
+  data_ = nullptr;
+  size_ = 0;
+}
+#else   // WIN32
+MappedFile::MappedFile(std::string_view filename) {
+  const int fd = open(std::string(filename).c_str(), O_RDONLY);
+  if (fd < 0) {
+    detail::ThrowOpenError(filename);
+  }
+
+  struct stat info {};
+  if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode)) {
+    close(fd);
+    detail::ThrowMappingError(filename, "not a regular file");
+  }
+
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ == 0) {
+    // Empty files cannot be mapped.
+    close(fd);
+    return;
+  }
+
+  if (size_ <= kMaxBufferedSize) {
+    // If the file is truncated meanwhile, we simply read less.
+    buffer_ = std::make_unique<char[]>(size_);
+    std::size_t num_read{0};
+    while (num_read < size_) {
+      const ssize_t length =
+          read(fd, buffer_.get() + num_read, size_ - num_read);
+      if (length < 0) {
+        close(fd);
+        buffer_.reset();
+        size_ = 0;
+        detail::ThrowMappingError(filename, "read failed");
+      }
+      if (length == 0) {
+        break;
+      }
+      num_read += static_cast<std::size_t>(length);
+    }
+    close(fd);
+    size_ = num_read;
+    data_ = buffer_.get();
+    return;
+  }
+
+  void *view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping remains valid after closing the file descriptor.
+  close(fd);
+  if (view == MAP_FAILED) {
+    size_ = 0;
+    detail::ThrowMappingError(filename, "mmap failed");
+  }
+#ifdef POSIX_MADV_SEQUENTIAL
+  // Parsers read the content front to back.
+  posix_madvise(view, size_, POSIX_MADV_SEQUENTIAL);
+#endif  // POSIX_MADV_SEQUENTIAL
+  data_ = static_cast<const char *>(view);
+}
+
+void MappedFile::Unmap() noexcept {
+  if ((data_ != nullptr) && !buffer_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    munmap(const_cast<char *>(data_), size_);
+  }
+  buffer_.reset();
+  data_ = nullptr;
+  size_ = 0;
+}
+#endif  // WIN32
+
+MappedFile::~MappedFile() { Unmap(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_{other.data_},
+      size_{other.size_},
+      buffer_{std::move(other.buffer_)} {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = other.data_;
+    size_ = other.size_;
+    buffer_ = std::move(other.buffer_);
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
 AsciiFileIterator::AsciiFileIterator(std::string_view filename) {
   ifs_.open(std::string(filename), std::ios::in);
   if (!ifs_.is_open()) {
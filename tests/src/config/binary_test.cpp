@@ -0,0 +1,139 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/files/fileio.h>
+#include <werkzeugkiste/files/filesys.h>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+namespace wkf = werkzeugkiste::files;
+
+// NOLINTBEGIN
+
+using namespace std::string_view_literals;
+
+namespace {
+wkc::Configuration RoundTrip(const wkc::Configuration &cfg) {
+  std::ostringstream out{std::ios::out | std::ios::binary};
+  cfg.WriteBinary(out);
+  return wkc::Configuration::LoadBinaryBuffer(out.str());
+}
+}  // namespace
+
+TEST(ConfigBinaryTest, RoundTripFixtures) {
+  const auto fixtures = {"test-valid1.toml"sv, "test-valid2.toml"sv,
+      "test-libconfig.toml"sv, "test-valid.json"sv};
+  for (const auto fixture : fixtures) {
+    const auto fname = wkf::FullFile(wkf::DirName(__FILE__), fixture);
+    const auto config = wkc::LoadFile(fname);
+    EXPECT_FALSE(config.Empty()) << fixture;
+
+    const auto decoded = RoundTrip(config);
+    EXPECT_EQ(config, decoded) << fixture;
+    EXPECT_EQ(config.ToTOML(), decoded.ToTOML()) << fixture;
+  }
+}
+
+TEST(ConfigBinaryTest, RoundTripTypes) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    flag = false
+    int = -9223372036854775807
+    flt = -1.5e-300
+    inf = inf
+    str = "value"
+    empty_str = ""
+    day = 2023-02-28
+    tm = 23:59:58.123456789
+    local_dt = 2023-02-28T08:30:00
+    dt = 2023-02-28T08:30:00-05:30
+
+    bools = [true, false, true]
+    ints = [1, -2, 3]
+    flts = [0.5, -1.0]
+    strs = ["value", "another", "value"]
+    mixed = [1, 2.5, "three", [4, [5]], { six = 6 }]
+    empty_lst = []
+    empty_grp = {}
+
+    [[objs]]
+    name = "first"
+
+    [[objs]]
+    name = "second"
+    values = [0.5]
+    )toml"sv);
+
+  const auto decoded = RoundTrip(config);
+  EXPECT_EQ(config, decoded);
+  EXPECT_EQ(config.ListParameterNames(
+                /*include_array_entries=*/true, /*recursive=*/true),
+      decoded.ListParameterNames(
+          /*include_array_entries=*/true, /*recursive=*/true));
+  EXPECT_EQ(config.GetDateTime("dt"sv), decoded.GetDateTime("dt"sv));
+  EXPECT_EQ(config.GetDateTime("local_dt"sv),
+      decoded.GetDateTime("local_dt"sv));
+  EXPECT_EQ(config.GetTime("tm"sv), decoded.GetTime("tm"sv));
+  EXPECT_EQ(wkc::ConfigType::List, decoded.Type("empty_lst"sv));
+  EXPECT_EQ(wkc::ConfigType::Group, decoded.Type("empty_grp"sv));
+  EXPECT_EQ(6, decoded.GetInt32("mixed[4].six"sv));
+  EXPECT_EQ(5, decoded.GetInt32("mixed[3][1][0]"sv));
+
+  // Empty configuration
+  EXPECT_TRUE(RoundTrip(wkc::Configuration{}).Empty());
+
+  // Round trip via file
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "wzk-binary-test.bin")
+          .string();
+  config.SaveBinary(fname);
+  EXPECT_EQ(config, wkc::Configuration::LoadBinary(fname));
+  std::filesystem::remove(fname);
+
+  EXPECT_THROW(wkc::Configuration::LoadBinary("no-such-file.bin"sv),
+      wkc::ParseError);
+  EXPECT_THROW(config.SaveBinary("no-such-dir/file.bin"sv), wkf::IOError);
+}
+
+TEST(ConfigBinaryTest, InvalidSnapshots) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    str = "value"
+    lst = [1, 2, 3]
+    grp.flt = 1.5
+    )toml"sv);
+  std::ostringstream out{std::ios::out | std::ios::binary};
+  config.WriteBinary(out);
+  const std::string valid = out.str();
+  EXPECT_EQ(config, wkc::Configuration::LoadBinaryBuffer(valid));
+
+  // Not a snapshot
+  EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer(""sv), wkc::ParseError);
+  EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer("str = \"value\""sv),
+      wkc::ParseError);
+
+  // Unsupported version
+  std::string corrupt{valid};
+  corrupt[8] = '\x7F';
+  EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer(corrupt), wkc::ParseError);
+
+  // Truncated at any position
+  for (std::size_t len = 0; len < valid.length(); ++len) {
+    EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer(valid.substr(0, len)),
+        wkc::ParseError)
+        << "Truncated to " << len << " bytes";
+  }
+
+  // Trailing data
+  EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer(valid + '\0'),
+      wkc::ParseError);
+
+  // Invalid node tag (the last parameter, `str`, is encoded as its tag
+  // followed by a 4-byte string id)
+  corrupt = valid;
+  corrupt[corrupt.length() - 5] = '\x7F';
+  EXPECT_THROW(wkc::Configuration::LoadBinaryBuffer(corrupt), wkc::ParseError);
+}
+
+// NOLINTEND
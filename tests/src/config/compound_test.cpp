@@ -424,6 +424,252 @@ TEST(ConfigCompoundTest, SetGroup) {
   EXPECT_TRUE(config.Contains("my-grp.my-str"sv));
 }
 
+TEST(ConfigCompoundTest, CopyOnWrite) {
+  const auto original = wkc::LoadTOMLString(R"toml(
+    value = 1
+    [grp]
+    name = "group"
+    lst = [1, 2, 3]
+    sub.value = 2
+    )toml"sv);
+
+  // Copies (and groups) share the parameters until they are modified.
+  auto copy = original;
+  auto group = original.GetGroup("grp"sv);
+  auto subgroup = group.GetGroup("sub"sv);
+  EXPECT_EQ(original, copy);
+
+  const wkc::Configuration::KeyHandle handle{"lst[1]"sv};
+  EXPECT_EQ(2, group.Get<int32_t>(handle));
+
+  copy.SetInt32("value"sv, 10);
+  copy.SetString("grp.name"sv, "modified"sv);
+  EXPECT_EQ(1, original.GetInt32("value"sv));
+  EXPECT_EQ("group", original.GetString("grp.name"sv));
+  EXPECT_EQ("group", group.GetString("name"sv));
+  EXPECT_EQ(10, copy.GetInt32("value"sv));
+  EXPECT_NE(original, copy);
+
+  group.SetInt32List("lst"sv, {4, 5, 6});
+  EXPECT_EQ(5, group.Get<int32_t>(handle));
+  EXPECT_EQ(2, original.GetInt32("grp.lst[1]"sv));
+  EXPECT_EQ(2, copy.GetInt32("grp.lst[1]"sv));
+  EXPECT_EQ(2, subgroup.GetInt32("value"sv));
+
+  subgroup.Delete("value"sv);
+  EXPECT_TRUE(subgroup.Empty());
+  EXPECT_TRUE(original.Contains("grp.sub.value"sv));
+
+  // A copy of a detached group is independent of the group, too.
+  auto group_copy = group;
+  group.SetBool("flag"sv, true);
+  EXPECT_FALSE(group_copy.Contains("flag"sv));
+  EXPECT_EQ(5, group_copy.Get<int32_t>(handle));
+
+  // Moving a group into another configuration.
+  copy.SetGroup("moved"sv, std::move(group_copy));
+  EXPECT_EQ(6, copy.GetInt32("moved.lst[2]"sv));
+  EXPECT_EQ("group", copy.GetString("moved.name"sv));
+
+  // Moving a shared group must not affect the other configurations.
+  auto shared = original.GetGroup("grp"sv);
+  copy.SetGroup("moved_shared"sv, std::move(shared));
+  EXPECT_EQ(3, copy.GetInt32("moved_shared.lst[2]"sv));
+  EXPECT_EQ(3, original.GetInt32("grp.lst[2]"sv));
+}
+
+TEST(ConfigCompoundTest, VisitAndCompare) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    name = "cfg"
+
+    [lvl1]
+    values = [1, [2, 3], { a = 4 }]
+
+    [lvl1.lvl2]
+    flag = true
+    )toml"sv);
+
+  for (bool include_array_entries : {false, true}) {
+    for (bool recursive : {false, true}) {
+      std::vector<std::string> visited{};
+      config.VisitParameterNames(include_array_entries,
+          recursive,
+          [&visited](std::string_view fqn) { visited.emplace_back(fqn); });
+      EXPECT_EQ(
+          config.ListParameterNames(include_array_entries, recursive), visited);
+    }
+  }
+
+  std::vector<std::string> visited{};
+  config.VisitParameterNames("lvl1"sv,
+      true,
+      true,
+      [&visited](std::string_view fqn) { visited.emplace_back(fqn); });
+  EXPECT_EQ((std::vector<std::string>{"lvl2",
+                "lvl2.flag",
+                "values",
+                "values[0]",
+                "values[1]",
+                "values[1][0]",
+                "values[1][1]",
+                "values[2]",
+                "values[2].a"}),
+      visited);
+  EXPECT_THROW(config.VisitParameterNames(
+                   "name"sv, true, true, [](std::string_view) {}),
+      wkc::TypeError);
+
+  // Parallel comparison must yield the same results.
+  wkc::Configuration large{};
+  for (int group = 0; group < 50; ++group) {
+    for (int param = 0; param < 20; ++param) {
+      large.SetInt32("group" + std::to_string(group) + ".sub" +
+                         std::to_string(param % 3) + ".param" +
+                         std::to_string(param),
+          param);
+    }
+  }
+  large.SetInt32List("list"sv, {1, 2, 3});
+  wkc::Configuration copy{large};
+  EXPECT_TRUE(large.Equals(copy, true));
+  EXPECT_TRUE(large.Equals(copy, false));
+
+  copy.SetInt32("group49.sub1.param19"sv, -1);
+  EXPECT_FALSE(large.Equals(copy, true));
+  EXPECT_FALSE(copy.Equals(large, true));
+  copy.SetInt32("group49.sub1.param19"sv, 19);
+  EXPECT_TRUE(large.Equals(copy, true));
+
+  copy.SetInt32("group3.sub0.extra"sv, 0);
+  EXPECT_FALSE(large.Equals(copy, true));
+  EXPECT_FALSE(copy.Equals(large, true));
+  copy.Delete("group3.sub0.extra"sv);
+  EXPECT_TRUE(large.Equals(copy, true));
+
+  copy.SetInt32List("list"sv, {1, 2});
+  EXPECT_FALSE(large.Equals(copy, true));
+  copy.Delete("list"sv);
+  copy.SetDoubleList("list"sv, {1.0, 2.0, 3.0});
+  EXPECT_FALSE(large.Equals(copy, true));
+  copy.Delete("list"sv);
+  copy.SetInt32List("list"sv, {1, 2, 3});
+  EXPECT_TRUE(copy.Equals(large, true));
+
+  // As in toml++, NaNs compare equal.
+  wkc::Configuration nan{large};
+  nan.SetDouble("group0.sub0.nan"sv, std::nan(""));
+  copy.SetDouble("group0.sub0.nan"sv, std::nan(""));
+  EXPECT_TRUE(copy.Equals(nan, false));
+  EXPECT_TRUE(copy.Equals(nan, true));
+
+  EXPECT_TRUE(wkc::Configuration{}.Equals(wkc::Configuration{}, true));
+  EXPECT_FALSE(wkc::Configuration{}.Equals(config, true));
+}
+
+TEST(ConfigCompoundTest, Hash) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    name = "cfg"
+    values = [1, 2.5, "three", [4], { five = 5 }]
+    day = 2023-02-28
+    time = 08:30:00.123
+    local = 2023-02-28T08:30:00
+    utc = 2023-02-28T08:30:00Z
+
+    [lvl1]
+    flag = true
+    zero = 0.0
+
+    [lvl1.lvl2]
+    nan = nan
+    )toml"sv);
+  // Same parameters, different order.
+  const auto reordered = wkc::LoadTOMLString(R"toml(
+    utc = 2023-02-28T08:30:00Z
+    local = 2023-02-28T08:30:00
+    lvl1 = { lvl2 = { nan = -nan }, zero = -0.0, flag = true }
+    time = 08:30:00.123
+    day = 2023-02-28
+    values = [1, 2.5, "three", [4], { five = 5 }]
+    name = "cfg"
+    )toml"sv);
+  EXPECT_EQ(config, reordered);
+  EXPECT_EQ(config.Hash(), reordered.Hash());
+  EXPECT_EQ(config.Hash("lvl1"sv), reordered.Hash("lvl1"sv));
+  EXPECT_EQ(config.Hash("lvl1"sv), config.GetGroup("lvl1"sv).Hash());
+  EXPECT_EQ(config.Hash("values[4]"sv), reordered.Hash("values[4]"sv));
+  EXPECT_NE(config.Hash("values[0]"sv), config.Hash("values[1]"sv));
+  EXPECT_NE(config.Hash("local"sv), config.Hash("utc"sv));
+  EXPECT_EQ(config.Hash(), config.Hash(""sv));
+  EXPECT_THROW(config.Hash("no-such-key"sv), wkc::KeyError);
+  EXPECT_THROW(config.Hash("no-such-key"sv, true), wkc::KeyError);
+  EXPECT_THROW(config.Hash("values[5]"sv), wkc::KeyError);
+
+  // The hash must be stable across library versions and platforms.
+  EXPECT_EQ(0x5B78EF81241D6C40ULL, wkc::LoadTOMLString("a = 1"sv).Hash());
+  EXPECT_EQ(0xA9CDB9B15BDB27B9ULL, wkc::Configuration{}.Hash());
+
+  // Types and list order matter.
+  EXPECT_NE(wkc::LoadTOMLString("a = 1"sv).Hash(),
+      wkc::LoadTOMLString("a = 1.0"sv).Hash());
+  EXPECT_NE(wkc::LoadTOMLString("a = [1, 2]"sv).Hash(),
+      wkc::LoadTOMLString("a = [2, 1]"sv).Hash());
+  EXPECT_NE(wkc::LoadTOMLString("a = { b = 1 }"sv).Hash(),
+      wkc::LoadTOMLString("b = { a = 1 }"sv).Hash());
+
+  // Modifications invalidate the memoized hashes of the affected groups.
+  const uint64_t hash = config.Hash();
+  const uint64_t hash_lvl1 = config.Hash("lvl1"sv);
+  const uint64_t hash_values = config.Hash("values"sv);
+  wkc::Configuration copy{config};
+  copy.SetBool("lvl1.flag"sv, false);
+  EXPECT_NE(hash, copy.Hash());
+  EXPECT_NE(hash_lvl1, copy.Hash("lvl1"sv));
+  EXPECT_EQ(hash_values, copy.Hash("values"sv));
+  EXPECT_EQ(hash, config.Hash());
+
+  config.SetInt32("values[4].five"sv, 6);
+  EXPECT_NE(hash, config.Hash());
+  EXPECT_NE(hash_values, config.Hash("values"sv));
+  EXPECT_EQ(hash_lvl1, config.Hash("lvl1"sv));
+  config.SetInt32("values[4].five"sv, 5);
+  EXPECT_EQ(hash, config.Hash());
+
+  config.Delete("lvl1.lvl2"sv);
+  EXPECT_NE(hash, config.Hash());
+  config.SetGroup("lvl1.lvl2"sv, reordered.GetGroup("lvl1.lvl2"sv));
+  EXPECT_EQ(hash, config.Hash());
+
+  config.Append("values"sv, 6);
+  EXPECT_NE(hash, config.Hash());
+  EXPECT_EQ(wkc::LoadTOMLString(config.ToTOML()).Hash(), config.Hash());
+
+  config.ReplaceStringPlaceholders({{"three"sv, "four"sv}});
+  EXPECT_EQ(wkc::LoadTOMLString(config.ToTOML()).Hash(), config.Hash());
+  config.SetString("lvl1.lvl2.str"sv, "${A}"sv);
+  EXPECT_EQ(wkc::LoadTOMLString(config.ToTOML()).Hash(), config.Hash());
+  config.ReplaceStringPlaceholders("lvl1.lvl2"sv, {{"${A}"sv, "a"sv}});
+  EXPECT_EQ(wkc::LoadTOMLString(config.ToTOML()).Hash(), config.Hash());
+
+  // Concurrent hashing yields the same results, also if some hashes have
+  // already been memoized.
+  std::string tml{"value = 0\n"};
+  for (int idx = 0; idx < 20; ++idx) {
+    tml += "[grp" + std::to_string(idx) + "]\nvalue = " +
+           std::to_string(idx) +
+           "\nlst = [{ a = 1 }, [{ b = 2 }], 3]\nsub = { c = { d = 3 } }\n";
+  }
+  const auto serial = wkc::LoadTOMLString(tml);
+  auto parallel = wkc::LoadTOMLString(tml);
+  EXPECT_EQ(serial.Hash("grp3"sv), parallel.Hash("grp3"sv, true));
+  EXPECT_EQ(serial.Hash(), parallel.Hash(""sv, true));
+  EXPECT_EQ(serial.Hash("grp3.lst"sv), parallel.Hash("grp3.lst"sv, true));
+  parallel.SetInt32("grp7.sub.c.d"sv, 4);
+  EXPECT_NE(serial.Hash(), parallel.Hash(""sv, true));
+  EXPECT_EQ(wkc::LoadTOMLString(parallel.ToTOML()).Hash(), parallel.Hash());
+  EXPECT_EQ(wkc::LoadTOMLString("a = 1"sv).Hash(),
+      wkc::LoadTOMLString("a = 1"sv).Hash(""sv, true));
+}
+
 TEST(ConfigCompoundTest, GetMatrices) {
   auto config = wkc::LoadTOMLString(R"toml(
     int = 3
@@ -660,6 +906,57 @@ TEST(ConfigCompoundTest, GetMatrices) {
   EXPECT_DOUBLE_EQ(1e6, mat_dbl(2, 0));
 }
 
+TEST(ConfigCompoundTest, GetMatrixInto) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    int = 3
+    lst = [1, 2.5, 3]
+    empty = []
+    mat = [
+      [1.0, 2.0, 3.0],
+      [4, 5, 6.5]
+    ]
+    invalid = [[1.0, 2.0], [3.0, 'four']]
+    jagged = [[1.0, 2.0], [3.0]]
+    )toml"sv);
+
+  wkc::Matrix<double> mat(2, 3);
+  EXPECT_NO_THROW(config.GetMatrixInto("mat"sv, mat));
+  EXPECT_EQ(config.GetMatrixDouble("mat"sv), mat);
+
+  // A single list is loaded as a column vector, which can also be a block
+  // of a larger matrix.
+  wkc::Matrix<double> lst = wkc::Matrix<double>::Zero(4, 2);
+  EXPECT_NO_THROW(config.GetMatrixInto("lst"sv, lst.block(1, 1, 3, 1)));
+  EXPECT_DOUBLE_EQ(0.0, lst(0, 1));
+  EXPECT_DOUBLE_EQ(1.0, lst(1, 1));
+  EXPECT_DOUBLE_EQ(2.5, lst(2, 1));
+  EXPECT_DOUBLE_EQ(3.0, lst(3, 1));
+  EXPECT_DOUBLE_EQ(0.0, lst.col(0).sum());
+
+  // Load into externally managed memory.
+  std::vector<double> buffer(6);
+  EXPECT_NO_THROW(config.GetMatrixInto(
+      "mat"sv, Eigen::Map<wkc::Matrix<double>>(buffer.data(), 2, 3)));
+  EXPECT_DOUBLE_EQ(3.0, buffer[2]);
+  EXPECT_DOUBLE_EQ(6.5, buffer[5]);
+
+  wkc::Matrix<double> empty(0, 0);
+  EXPECT_NO_THROW(config.GetMatrixInto("empty"sv, empty));
+
+  // Shape mismatch
+  EXPECT_THROW(config.GetMatrixInto("empty"sv, mat), wkc::ValueError);
+  EXPECT_THROW(config.GetMatrixInto("lst"sv, mat), wkc::ValueError);
+  wkc::Matrix<double> transposed(3, 2);
+  EXPECT_THROW(config.GetMatrixInto("mat"sv, transposed), wkc::ValueError);
+
+  // Invalid parameters
+  wkc::Matrix<double> m22(2, 2);
+  EXPECT_THROW(config.GetMatrixInto("no-such-key"sv, m22), wkc::KeyError);
+  EXPECT_THROW(config.GetMatrixInto("int"sv, m22), wkc::TypeError);
+  EXPECT_THROW(config.GetMatrixInto("invalid"sv, m22), wkc::TypeError);
+  EXPECT_THROW(config.GetMatrixInto("jagged"sv, m22), wkc::TypeError);
+}
+
 TEST(ConfigCompoundTest, SetMatrices) {
   auto config = wkc::LoadTOMLString(R"toml(
     int = 3
@@ -765,6 +1062,77 @@ TEST(ConfigCompoundTest, SetMatrices) {
   EXPECT_EQ(-42, mxi(0, 0));
   EXPECT_EQ(0, mxi(1, 0));
   EXPECT_EQ(420, mxi(2, 0));
+
+  // -------------------------------------------------------------
+  // ---- Set a parameter from a row-major double matrix
+  wkc::Matrix<double> mxd = wkc::Matrix<double>::Random(20, 7);
+  EXPECT_NO_THROW(config.SetMatrix("mxd"sv, mxd));
+  EXPECT_EQ(20, config.Size("mxd"sv));
+  EXPECT_EQ(7, config.Size("mxd[19]"sv));
+  EXPECT_EQ(mxd, config.GetMatrixDouble("mxd"sv));
+
+  // An empty matrix results in an empty list.
+  EXPECT_NO_THROW(config.SetMatrix("mxd"sv, wkc::Matrix<double>(0, 0)));
+  EXPECT_EQ(0, config.Size("mxd"sv));
+
+  // Integer values must fit into 64-bit integers.
+  Eigen::Matrix<uint64_t, 1, 2> m64u;
+  m64u << 1, std::numeric_limits<uint64_t>::max();
+  EXPECT_THROW(config.SetMatrix("m64u"sv, m64u), wkc::TypeError);
+}
+
+TEST(ConfigCompoundTest, ReplaceNumberLists) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    dbl = [1.0, 2.0, 3.0]
+    int = [1, 2, 3]
+    mixed = [1, 2.0, 3]
+    mat = [[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]]
+    )toml"sv);
+
+  // Same length and type
+  config.SetDoubleList("dbl"sv, {-1.0, -2.0, -3.0});
+  EXPECT_EQ((std::vector<double>{-1.0, -2.0, -3.0}),
+      config.GetDoubleList("dbl"sv));
+  config.SetInt32List("int"sv, {4, 5, 6});
+  EXPECT_EQ((std::vector<int64_t>{4, 5, 6}), config.GetInt64List("int"sv));
+  config.SetDoubleList("int"sv, {7.0, 8.0, 9.0});
+  EXPECT_EQ(wkc::ConfigType::Integer, config.Type("int[0]"sv));
+  EXPECT_EQ((std::vector<int64_t>{7, 8, 9}), config.GetInt64List("int"sv));
+  config.SetDoubleList("mixed"sv, {0.5, 1.5, 2.5});
+  EXPECT_EQ(wkc::ConfigType::FloatingPoint, config.Type("mixed[0]"sv));
+  EXPECT_EQ((std::vector<double>{0.5, 1.5, 2.5}),
+      config.GetDoubleList("mixed"sv));
+
+  // A failed conversion must not modify the list
+  EXPECT_THROW(config.SetDoubleList("int"sv, {1.0, 1.5, 2.0}), wkc::TypeError);
+  EXPECT_EQ((std::vector<int64_t>{7, 8, 9}), config.GetInt64List("int"sv));
+
+  // Different lengths
+  config.SetDoubleList("dbl"sv, {1.0, 2.0});
+  EXPECT_EQ((std::vector<double>{1.0, 2.0}), config.GetDoubleList("dbl"sv));
+
+  // Matrices of the same shape
+  wkc::Matrix<double> mat(3, 2);
+  mat << -1.0, -2.0, -3.0, -4.0, -5.0, -6.0;
+  config.SetMatrix("mat"sv, mat);
+  EXPECT_EQ(mat, config.GetMatrixDouble("mat"sv));
+
+  Eigen::Vector2d vec{0.5, 1.5};
+  config.SetMatrix("dbl"sv, vec);
+  EXPECT_EQ((std::vector<double>{0.5, 1.5}), config.GetDoubleList("dbl"sv));
+  config.SetMatrix("dbl"sv, Eigen::RowVector2d{2.5, 3.5});
+  EXPECT_EQ((std::vector<double>{2.5, 3.5}), config.GetDoubleList("dbl"sv));
+
+  // Different shapes or types replace the list
+  config.SetMatrix("mat"sv, mat.transpose());
+  EXPECT_EQ(mat.transpose(), config.GetMatrixDouble("mat"sv));
+  Eigen::Matrix<int64_t, 2, 3> mat_int;
+  mat_int << 1, 2, 3, 4, 5, 6;
+  config.SetMatrix("mat"sv, mat_int);
+  EXPECT_EQ(wkc::ConfigType::Integer, config.Type("mat[0][0]"sv));
+  EXPECT_EQ(mat_int, config.GetMatrixInt64("mat"sv));
+  config.SetMatrix("dbl"sv, mat_int);
+  EXPECT_EQ(mat_int, config.GetMatrixInt64("dbl"sv));
 }
 
 // NOLINTEND
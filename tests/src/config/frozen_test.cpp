@@ -0,0 +1,235 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/frozen.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN
+
+TEST(ConfigFrozenTest, Getters) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    flag = true
+    int = 42
+    big = 2147483648
+    flt = 1.5
+    str = "value"
+    day = 2023-02-28
+    tm = 08:30:00
+    dt = 2023-02-28T08:30:00+01:00
+
+    lst = [1, 2.0, 3]
+    strs = ["a", "b"]
+    nested = [[1, 2], [3, 4, 5]]
+    days = [2023-02-28, 2024-02-29]
+    tms = [08:30:00, 23:59:59.5]
+    dts = [2023-02-28T08:30:00Z, 2023-02-28T08:30:00]
+
+    [grp]
+    name = "group"
+    sub.value = -1
+
+    [[objs]]
+    name = "first"
+
+    [[objs]]
+    name = "second"
+    values = [0.5]
+    )toml"sv);
+
+  const wkc::FrozenConfiguration frozen = config.Freeze();
+  // The snapshot is independent of the (mutable) configuration.
+  config.SetInt32("int"sv, 0);
+  config.SetBool("another"sv, false);
+
+  EXPECT_FALSE(frozen.Empty());
+  EXPECT_EQ(config.Size() - 1, frozen.Size());
+  EXPECT_TRUE(frozen.Contains("flag"sv));
+  EXPECT_FALSE(frozen.Contains("another"sv));
+  EXPECT_TRUE(frozen.Contains("grp.sub.value"sv));
+  EXPECT_TRUE(frozen.Contains("objs[1].values[0]"sv));
+  EXPECT_FALSE(frozen.Contains("objs[2]"sv));
+  EXPECT_FALSE(frozen.Contains("objs[x]"sv));
+  EXPECT_FALSE(frozen.Contains("grp[0]"sv));
+  EXPECT_FALSE(frozen.Contains("grp.sub.value.x"sv));
+
+  EXPECT_EQ(wkc::ConfigType::Boolean, frozen.Type("flag"sv));
+  EXPECT_EQ(wkc::ConfigType::Integer, frozen.Type("int"sv));
+  EXPECT_EQ(wkc::ConfigType::FloatingPoint, frozen.Type("flt"sv));
+  EXPECT_EQ(wkc::ConfigType::String, frozen.Type("str"sv));
+  EXPECT_EQ(wkc::ConfigType::Date, frozen.Type("day"sv));
+  EXPECT_EQ(wkc::ConfigType::Time, frozen.Type("tm"sv));
+  EXPECT_EQ(wkc::ConfigType::DateTime, frozen.Type("dt"sv));
+  EXPECT_EQ(wkc::ConfigType::List, frozen.Type("nested[1]"sv));
+  EXPECT_EQ(wkc::ConfigType::Group, frozen.Type("objs[0]"sv));
+  EXPECT_EQ(wkc::ConfigType::Group, frozen.Type(""sv));
+  EXPECT_THROW(frozen.Type("no-such-key"sv), wkc::KeyError);
+
+  EXPECT_EQ(2, frozen.Size("grp"sv));
+  EXPECT_EQ(3, frozen.Size("nested[1]"sv));
+  EXPECT_THROW(frozen.Size("int"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.Size("no-such-key"sv), wkc::KeyError);
+
+  // Scalars
+  EXPECT_TRUE(frozen.GetBool("flag"sv));
+  EXPECT_EQ(42, frozen.GetInt32("int"sv));
+  EXPECT_EQ(42, frozen.GetInt64("int"sv));
+  EXPECT_DOUBLE_EQ(42.0, frozen.GetDouble("int"sv));
+  EXPECT_THROW(frozen.GetInt32("big"sv), wkc::TypeError);
+  EXPECT_EQ(2147483648L, frozen.GetInt64("big"sv));
+  EXPECT_DOUBLE_EQ(1.5, frozen.GetDouble("flt"sv));
+  EXPECT_THROW(frozen.GetInt32("flt"sv), wkc::TypeError);
+  EXPECT_EQ("value", frozen.GetString("str"sv));
+  EXPECT_THROW(frozen.GetString("int"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.GetBool("int"sv), wkc::TypeError);
+  EXPECT_EQ(wkc::date(2023, 2, 28), frozen.GetDate("day"sv));
+  EXPECT_EQ(wkc::time(8, 30), frozen.GetTime("tm"sv));
+  EXPECT_EQ(config.GetDateTime("dt"sv), frozen.GetDateTime("dt"sv));
+  EXPECT_THROW(frozen.GetDate("tm"sv), wkc::TypeError);
+  EXPECT_EQ("group", frozen.GetString("grp.name"sv));
+  EXPECT_EQ(-1, frozen.GetInt32("grp.sub.value"sv));
+  EXPECT_EQ("second", frozen.GetString("objs[1].name"sv));
+  EXPECT_EQ(4, frozen.GetInt32("nested[1][1]"sv));
+  EXPECT_THROW(frozen.GetInt32("no-such-key"sv), wkc::KeyError);
+
+  // Default values
+  EXPECT_EQ(42, frozen.GetInt32Or("int"sv, 3));
+  EXPECT_EQ(3, frozen.GetInt32Or("no-such-key"sv, 3));
+  EXPECT_EQ("fallback", frozen.GetStringOr("no-such-key"sv, "fallback"sv));
+  EXPECT_THROW(frozen.GetStringOr("int"sv, "fallback"sv), wkc::TypeError);
+  EXPECT_FALSE(frozen.GetBoolOr("no-such-key"sv, false));
+  EXPECT_DOUBLE_EQ(-2.0, frozen.GetDoubleOr("no-such-key"sv, -2.0));
+
+  // Optional values
+  EXPECT_EQ(42, frozen.GetOptionalInt32("int"sv).value());
+  EXPECT_FALSE(frozen.GetOptionalInt32("no-such-key"sv).has_value());
+  EXPECT_EQ(2147483648L, frozen.GetOptionalInt64("big"sv).value());
+  EXPECT_TRUE(frozen.GetOptionalBool("flag"sv).value());
+  EXPECT_DOUBLE_EQ(1.5, frozen.GetOptionalDouble("flt"sv).value());
+  EXPECT_EQ("value", frozen.GetOptionalString("str"sv).value());
+  EXPECT_EQ(wkc::date(2023, 2, 28), frozen.GetOptionalDate("day"sv).value());
+  EXPECT_EQ(wkc::time(8, 30), frozen.GetOptionalTime("tm"sv).value());
+  EXPECT_EQ(config.GetDateTime("dt"sv),
+      frozen.GetOptionalDateTime("dt"sv).value());
+  EXPECT_FALSE(frozen.GetOptionalDateTime("no-such-key"sv).has_value());
+  EXPECT_THROW(frozen.GetOptionalString("int"sv), wkc::TypeError);
+
+  // Lists
+  const auto dbls = frozen.GetDoubleList("lst"sv);
+  EXPECT_EQ(3, dbls.size());
+  EXPECT_DOUBLE_EQ(2.0, dbls[1]);
+  EXPECT_EQ(config.GetInt64List("lst"sv), frozen.GetInt64List("lst"sv));
+  EXPECT_EQ(config.GetStringList("strs"sv), frozen.GetStringList("strs"sv));
+  EXPECT_EQ(0.5, frozen.GetDoubleList("objs[1].values"sv)[0]);
+  EXPECT_THROW(frozen.GetInt32List("int"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.GetStringList("lst"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.GetInt32List("nested"sv), wkc::TypeError);
+  EXPECT_EQ(config.GetDateList("days"sv), frozen.GetDateList("days"sv));
+  EXPECT_EQ(config.GetTimeList("tms"sv), frozen.GetTimeList("tms"sv));
+  EXPECT_EQ(
+      config.GetDateTimeList("dts"sv), frozen.GetDateTimeList("dts"sv));
+  EXPECT_THROW(frozen.GetTimeList("days"sv), wkc::TypeError);
+
+  const auto names = frozen.ListParameterNames();
+  EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+  EXPECT_EQ(22, names.size());
+
+  // Missing keys suggest similar parameter names.
+  try {
+    frozen.GetInt32("grp.sub.valeu"sv);
+    FAIL() << "Expected a KeyError";
+  } catch (const wkc::KeyError &e) {
+    EXPECT_NE(std::string{e.what()}.find("Did you mean: `grp.sub.value`?"),
+        std::string::npos);
+  }
+}
+
+TEST(ConfigFrozenTest, Groups) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    value = 1
+    grp.name = "group"
+    grp.sub.value = -1
+    grp.sub.lst = [1, 2, { nested = "str" }]
+    grp.empty = {}
+    grp2.value = 2
+
+    [[objs]]
+    name = "first"
+    )toml"sv);
+
+  const wkc::FrozenConfiguration frozen = config.Freeze();
+  EXPECT_EQ(frozen.ListParameterNames(),
+      frozen.GetGroup(""sv).ListParameterNames());
+
+  const wkc::FrozenConfiguration grp = frozen.GetGroup("grp"sv);
+  EXPECT_EQ(std::vector<std::string>({"empty", "name", "sub", "sub.lst",
+                "sub.lst[2].nested", "sub.value"}),
+      grp.ListParameterNames());
+  EXPECT_EQ(3, grp.Size());
+  EXPECT_EQ("group", grp.GetString("name"sv));
+  EXPECT_EQ(-1, grp.GetInt32("sub.value"sv));
+  EXPECT_EQ(2, grp.GetInt32("sub.lst[1]"sv));
+  EXPECT_EQ("str", grp.GetString("sub.lst[2].nested"sv));
+  EXPECT_EQ(0, grp.Size("empty"sv));
+  EXPECT_FALSE(grp.Contains("value"sv));
+  EXPECT_FALSE(grp.Contains("grp.name"sv));
+
+  const wkc::FrozenConfiguration sub = grp.GetGroup("sub"sv);
+  EXPECT_EQ(2, sub.Size());
+  EXPECT_EQ(-1, sub.GetInt32("value"sv));
+  EXPECT_EQ("str", sub.GetGroup("lst[2]"sv).GetString("nested"sv));
+  EXPECT_TRUE(grp.GetGroup("empty"sv).Empty());
+  EXPECT_EQ("first", frozen.GetGroup("objs[0]"sv).GetString("name"sv));
+
+  EXPECT_THROW(frozen.GetGroup("value"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.GetGroup("objs"sv), wkc::TypeError);
+  EXPECT_THROW(frozen.GetGroup("no-such-key"sv), wkc::KeyError);
+}
+
+TEST(ConfigFrozenTest, AtomicSwap) {
+  wkc::AtomicFrozenConfiguration shared{};
+  EXPECT_TRUE(shared.Load().Empty());
+
+  auto config = wkc::LoadTOMLString("value = 0\ncopy = 0"sv);
+  shared.Store(config.Freeze());
+  const wkc::FrozenConfiguration first = shared.Load();
+  EXPECT_EQ(0, first.GetInt32("value"sv));
+
+  // Readers always see a consistent snapshot while it is being replaced.
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&shared, &done]() {
+      while (!done.load()) {
+        const auto snapshot = shared.Load();
+        const int32_t value = snapshot.GetInt32("value"sv);
+        EXPECT_EQ(value, snapshot.GetInt32("copy"sv));
+      }
+    });
+  }
+  for (int32_t value = 1; value <= 100; ++value) {
+    config.SetInt32("value"sv, value);
+    config.SetInt32("copy"sv, value);
+    shared.Store(config.Freeze());
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  const auto previous = shared.Exchange(wkc::FrozenConfiguration{});
+  EXPECT_EQ(100, previous.GetInt32("value"sv));
+  EXPECT_TRUE(shared.Load().Empty());
+
+  // The initial snapshot is still valid.
+  EXPECT_EQ(0, first.GetInt32("value"sv));
+}
+
+// NOLINTEND
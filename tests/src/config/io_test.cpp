@@ -424,6 +424,46 @@ TEST(ConfigIOTest, NullValuePolicy) {
   EXPECT_EQ("null", config.GetString("arr[2]"sv));
 }
 
+TEST(ConfigIOTest, JSONKeys) {
+  // Dotted keys create nested groups, similar to `Configuration::Set`
+  auto config = wkc::LoadJSONString(R"json({
+    "a.b": 1,
+    "a": { "c": 2, "d": { "e": [3, null] } },
+    "x": 1,
+    "x": "replaced"
+    })json"sv);
+  EXPECT_EQ(2, config.Size());
+  EXPECT_EQ(3, config.Size("a"sv));
+  EXPECT_EQ(1, config.GetInt32("a.b"sv));
+  EXPECT_EQ(2, config.GetInt32("a.c"sv));
+  EXPECT_EQ(3, config.GetInt32("a.d.e[0]"sv));
+  EXPECT_EQ(1, config.Size("a.d.e"sv));
+  EXPECT_EQ("replaced", config.GetString("x"sv));
+
+  // Keys must be valid parameter names
+  EXPECT_THROW(wkc::LoadJSONString(R"json({"a b": 1})json"sv), wkc::KeyError);
+  EXPECT_THROW(wkc::LoadJSONString(R"json({"": 1})json"sv), wkc::KeyError);
+  EXPECT_THROW(wkc::LoadJSONString(R"json({"a..b": 1})json"sv), wkc::KeyError);
+  EXPECT_THROW(wkc::LoadJSONString(R"json({"a[0]": 1})json"sv), wkc::KeyError);
+  EXPECT_THROW(
+      wkc::LoadJSONString(R"json({"a": 1, "a.b": 2})json"sv), wkc::KeyError);
+
+  // Top-level scalars cannot be loaded
+  EXPECT_THROW(wkc::LoadJSONString("42"sv), wkc::ParseError);
+  EXPECT_THROW(wkc::LoadJSONString(R"json("str")json"sv), wkc::ParseError);
+
+  // Error messages include the fully qualified parameter name
+  try {
+    wkc::LoadJSONString(R"json({"a": {"b": [1, {"c": null}]}})json"sv,
+        wkc::NullValuePolicy::Fail);
+    FAIL() << "Expected a ParseError";
+  } catch (const wkc::ParseError &e) {
+    EXPECT_NE(std::string_view{e.what()}.find("`a.b[1].c`"sv),
+        std::string_view::npos)
+        << "Error message was: " << e.what();
+  }
+}
+
 TEST(ConfigIOTest, SerializeJSONStrings) {
   const auto config1 = wkc::LoadTOMLString(R"toml(
     str = "value"
@@ -440,6 +480,42 @@ TEST(ConfigIOTest, SerializeJSONStrings) {
   EXPECT_EQ(config1, config2);
 }
 
+TEST(ConfigIOTest, WriteToStreams) {
+  const auto cfg = wkc::LoadTOMLFile(
+      wkf::FullFile(wkf::DirName(__FILE__), "test-valid1.toml"sv));
+
+  std::ostringstream toml;
+  cfg.WriteTOML(toml);
+  EXPECT_EQ(cfg.ToTOML(), toml.str());
+
+  std::ostringstream json;
+  cfg.WriteJSON(json);
+  EXPECT_EQ(cfg.ToJSON(), json.str());
+
+  std::ostringstream yaml;
+  cfg.WriteYAML(yaml);
+  EXPECT_EQ(cfg.ToYAML(), yaml.str());
+
+  // The libconfig formatter must not alter the stream's format flags.
+  std::ostringstream lcfg;
+  cfg.WriteLibconfig(lcfg);
+  EXPECT_EQ(cfg.ToLibconfig(), lcfg.str());
+  EXPECT_EQ(wkc::DumpLibconfigString(cfg), lcfg.str());
+  EXPECT_FALSE(lcfg.flags() & std::ios_base::boolalpha);
+
+  // Nor must the output depend on the stream's format flags.
+  std::ostringstream lcfg_hex;
+  lcfg_hex << std::hex << std::showbase;
+  cfg.WriteLibconfig(lcfg_hex);
+  EXPECT_EQ(cfg.ToLibconfig(), lcfg_hex.str());
+
+  // Writing appends to the stream.
+  std::ostringstream out;
+  out << "# prefix\n";
+  cfg.WriteTOML(out);
+  EXPECT_EQ("# prefix\n" + cfg.ToTOML(), out.str());
+}
+
 TEST(ConfigIOTest, LoadingYAML) {
   // Load YAML files
   EXPECT_THROW(wkc::LoadYAMLFile("no such file"), wkc::ParseError);
@@ -768,6 +844,75 @@ lst:
   EXPECT_THROW(wkc::LoadYAMLString(ystr), wkc::ParseError);
 }
 
+TEST(ConfigIOTest, YAMLKeysAndReferences) {
+  auto cfg = wkc::LoadYAMLString(R"yml(
+a.b: 1
+a:
+  c: &val 2
+  d: *val
+  e: &lst [1, ~, { f: 3 }]
+copy: *lst
+x: 1
+x: replaced
+)yml");
+  EXPECT_EQ(3, cfg.Size());
+  EXPECT_EQ(4, cfg.Size("a"sv));
+  EXPECT_EQ(1, cfg.GetInt32("a.b"sv));
+  EXPECT_EQ(2, cfg.GetInt32("a.c"sv));
+  EXPECT_EQ(2, cfg.GetInt32("a.d"sv));
+  EXPECT_EQ(2, cfg.Size("a.e"sv));
+  EXPECT_EQ(2, cfg.Size("copy"sv));
+  EXPECT_EQ(3, cfg.GetInt32("copy[1].f"sv));
+  EXPECT_EQ("replaced", cfg.GetString("x"sv));
+
+  // References are copies, i.e. changing one must not affect the other.
+  cfg.SetInt32("copy[1].f"sv, 4);
+  EXPECT_EQ(3, cfg.GetInt32("a.e[1].f"sv));
+  EXPECT_EQ(4, cfg.GetInt32("copy[1].f"sv));
+
+  // Anchored keys can be referenced by aliases (as keys or values). Keys
+  // use the raw scalar text, values the decoded type.
+  cfg = wkc::LoadYAMLString(R"yml(
+&k foo: 1
+&n 42: 2
+bar: *k
+num: *n
+nested:
+  *k : 3
+  *n : 4
+)yml");
+  EXPECT_EQ(1, cfg.GetInt32("foo"sv));
+  EXPECT_EQ(2, cfg.GetInt32("42"sv));
+  EXPECT_EQ("foo", cfg.GetString("bar"sv));
+  EXPECT_EQ(42, cfg.GetInt32("num"sv));
+  EXPECT_EQ(3, cfg.GetInt32("nested.foo"sv));
+  EXPECT_EQ(4, cfg.GetInt32("nested.42"sv));
+  cfg = wkc::LoadYAMLString("a: &v 1\n*v : 2");
+  EXPECT_EQ(1, cfg.GetInt32("a"sv));
+  EXPECT_EQ(2, cfg.GetInt32("1"sv));
+  EXPECT_THROW(wkc::LoadYAMLString("a: &v [1]\n*v : 2"), wkc::ParseError);
+
+  // Keys must be valid parameter names and scalars
+  EXPECT_THROW(wkc::LoadYAMLString("a b: 1"), wkc::KeyError);
+  EXPECT_THROW(wkc::LoadYAMLString("a: 1\na.b: 2"), wkc::KeyError);
+  EXPECT_THROW(wkc::LoadYAMLString("[1, 2]: 1"), wkc::ParseError);
+  EXPECT_THROW(wkc::LoadYAMLString("{a: 1}: 1"), wkc::ParseError);
+
+  // Top-level scalars cannot be loaded
+  EXPECT_THROW(wkc::LoadYAMLString("42"), wkc::ParseError);
+  EXPECT_THROW(wkc::LoadYAMLString(""), wkc::ParseError);
+
+  // Error messages include the fully qualified parameter name
+  try {
+    wkc::LoadYAMLString("a:\n  b: [1, { c: ~ }]", wkc::NullValuePolicy::Fail);
+    FAIL() << "Expected a ParseError";
+  } catch (const wkc::ParseError &e) {
+    EXPECT_NE(std::string_view{e.what()}.find("`a.b[1].c`"sv),
+        std::string_view::npos)
+        << "Error message was: " << e.what();
+  }
+}
+
 TEST(ConfigIOTest, YAMLSerialization) {
   wkc::Configuration cfg{};
   const bool bool_val{true};
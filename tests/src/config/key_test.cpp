@@ -243,6 +243,290 @@ TEST(ConfigKeyTest, KeyMatching) {
   EXPECT_TRUE(matcher.Match("arr[123].*"sv));
   EXPECT_TRUE(matcher.Match("arr[0][1].*"sv));
   EXPECT_TRUE(matcher.Match("arr[0][1][2].*"sv));
+
+  // Multiple patterns with shared prefixes are matched at once
+  matcher = wkc::KeyMatcher{
+      {"cam*.name"sv, "cam*.intrinsics[*]"sv, "camera"sv, "c**a"sv, "x*"sv}};
+  EXPECT_TRUE(matcher.Match("camera"sv));
+  EXPECT_TRUE(matcher.Match("cam.name"sv));
+  EXPECT_TRUE(matcher.Match("camera1.name"sv));
+  EXPECT_TRUE(matcher.Match("camera.intrinsics[3]"sv));
+  EXPECT_TRUE(matcher.Match("ca"sv));
+  EXPECT_TRUE(matcher.Match("cam.a"sv));
+  EXPECT_TRUE(matcher.Match("x"sv));
+  EXPECT_FALSE(matcher.Match("camera.intrinsics[3].fx"sv));
+  EXPECT_FALSE(matcher.Match("camera.names"sv));
+  EXPECT_FALSE(matcher.Match("cameras"sv));
+  EXPECT_FALSE(matcher.Match("c"sv));
+  EXPECT_FALSE(matcher.Match(""sv));
+
+  // Besides the wildcard, there are no special characters
+  matcher = wkc::KeyMatcher{{"a+b"sv, "(c|d)?"sv}};
+  EXPECT_TRUE(matcher.Match("a+b"sv));
+  EXPECT_FALSE(matcher.Match("aab"sv));
+  EXPECT_TRUE(matcher.Match("(c|d)?"sv));
+  EXPECT_FALSE(matcher.Match("c"sv));
+
+  matcher = wkc::KeyMatcher{"*"sv};
+  EXPECT_TRUE(matcher.Match(""sv));
+  EXPECT_TRUE(matcher.Match("any.key[0]"sv));
+}
+
+TEST(ConfigKeyTest, KeyHandles) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    flag = true
+    int = 42
+    camera.name = "cam"
+    camera.intrinsics = [
+      { fx = 800.0, fy = 750.0 },
+      { fx = 400, fy = 300 },
+      { fx = 1.5, fy = 2.5 }
+    ]
+    matrix = [[1, 2], [3, 4]]
+    day = 2023-02-28
+    )toml"sv);
+
+  // Malformed list indices
+  EXPECT_THROW(wkc::Configuration::KeyHandle{"arr[x]"sv}, wkc::KeyError);
+  EXPECT_THROW(wkc::Configuration::KeyHandle{"arr[0"sv}, wkc::KeyError);
+  EXPECT_THROW(wkc::Configuration::KeyHandle{"arr[]"sv}, wkc::KeyError);
+  EXPECT_THROW(wkc::Configuration::KeyHandle{"arr[0]x"sv}, wkc::KeyError);
+
+  const wkc::Configuration::KeyHandle fx{"camera.intrinsics[2].fx"sv};
+  EXPECT_EQ("camera.intrinsics[2].fx", fx.Key());
+  EXPECT_TRUE(config.Contains(fx));
+  EXPECT_DOUBLE_EQ(1.5, config.Get<double>(fx));
+  // Repeated lookups use the cached node
+  EXPECT_DOUBLE_EQ(1.5, config.Get<double>(fx));
+  EXPECT_THROW(config.Get<int32_t>(fx), wkc::TypeError);
+  EXPECT_THROW(config.Get<std::string>(fx), wkc::TypeError);
+
+  // Same conversion rules as the string-based getters
+  const wkc::Configuration::KeyHandle fx1{"camera.intrinsics[1].fx"sv};
+  EXPECT_EQ(config.GetInt32("camera.intrinsics[1].fx"sv),
+      config.Get<int32_t>(fx1));
+  EXPECT_DOUBLE_EQ(400.0, config.Get<double>(fx1));
+
+  EXPECT_TRUE(config.Get<bool>(wkc::Configuration::KeyHandle{"flag"sv}));
+  EXPECT_EQ(42, config.Get<int64_t>(wkc::Configuration::KeyHandle{"int"sv}));
+  EXPECT_EQ("cam",
+      config.Get<std::string>(wkc::Configuration::KeyHandle{"camera.name"sv}));
+  EXPECT_EQ(wkc::date(2023, 2, 28),
+      config.Get<wkc::date>(wkc::Configuration::KeyHandle{"day"sv}));
+
+  // Lists and nested lists
+  const wkc::Configuration::KeyHandle row{"matrix[1]"sv};
+  EXPECT_EQ(
+      std::vector<int32_t>({3, 4}), config.Get<std::vector<int32_t>>(row));
+  const wkc::Configuration::KeyHandle elem1{"matrix[1][1]"sv};
+  EXPECT_EQ(4, config.Get<int32_t>(elem1));
+  const wkc::Configuration::KeyHandle elem2{"matrix[0][ 1 ]"sv};
+  EXPECT_EQ(2, config.Get<int32_t>(elem2));
+  EXPECT_THROW(config.Get<std::vector<double>>(fx), wkc::TypeError);
+  EXPECT_THROW(config.Get<std::vector<std::string>>(row), wkc::TypeError);
+
+  // Non-existing parameters
+  const wkc::Configuration::KeyHandle missing{"camera.intrinsics[3].fx"sv};
+  EXPECT_FALSE(config.Contains(missing));
+  EXPECT_THROW(config.Get<double>(missing), wkc::KeyError);
+  EXPECT_FALSE(config.Contains(wkc::Configuration::KeyHandle{"int.sub"sv}));
+  EXPECT_FALSE(config.Contains(wkc::Configuration::KeyHandle{"int[0]"sv}));
+  EXPECT_FALSE(config.Contains(wkc::Configuration::KeyHandle{"[0]"sv}));
+
+  // Values which are changed in-place are visible via the handle
+  config.SetDouble("camera.intrinsics[2].fx"sv, -3.0);
+  EXPECT_DOUBLE_EQ(-3.0, config.Get<double>(fx));
+
+  // Structural modifications invalidate the cached node
+  config.Delete("camera"sv);
+  EXPECT_FALSE(config.Contains(fx));
+  EXPECT_THROW(config.Get<double>(fx), wkc::KeyError);
+
+  wkc::Configuration camera{};
+  camera.CreateList("intrinsics"sv);
+  camera.Append("intrinsics"sv, wkc::Configuration{});
+  camera.Append("intrinsics"sv, wkc::Configuration{});
+  wkc::Configuration intrinsics{};
+  intrinsics.SetDouble("fx"sv, 17.0);
+  camera.Append("intrinsics"sv, intrinsics);
+  config.SetGroup("camera"sv, camera);
+  EXPECT_TRUE(config.Contains(fx));
+  EXPECT_DOUBLE_EQ(17.0, config.Get<double>(fx));
+
+  config.SetInt32List("matrix[1]"sv, {5, 6, 7});
+  EXPECT_EQ(
+      std::vector<int32_t>({5, 6, 7}), config.Get<std::vector<int32_t>>(row));
+  config.ClearList("matrix"sv);
+  EXPECT_FALSE(config.Contains(row));
+
+  // A handle can be used with different configurations
+  const auto copy = config;
+  EXPECT_DOUBLE_EQ(17.0, copy.Get<double>(fx));
+  const auto other = wkc::LoadTOMLString("camera.intrinsics = [1, 2]"sv);
+  EXPECT_THROW(other.Get<double>(fx), wkc::KeyError);
+  EXPECT_DOUBLE_EQ(17.0, config.Get<double>(fx));
+}
+
+TEST(ConfigKeyTest, Binder) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    flag = true
+    int = 42
+    camera.name = "cam"
+    camera.intrinsics = [
+      { fx = 800.0, fy = 750.0 },
+      { fx = 400, fy = 300 }
+    ]
+    camera.day = 2023-02-28
+    values = [1, 2, 3]
+    )toml"sv);
+
+  bool flag{false};
+  int64_t value{0};
+  std::string name{};
+  double fx0{0.0};
+  double fy0{0.0};
+  int32_t fx1{0};
+  wkc::date day{};
+  std::vector<double> values{};
+  std::string optional{"default"};
+  double optional_nested{-1.0};
+  // Bound in arbitrary order
+  config.Bind()
+      .Field("camera.intrinsics[1].fx"sv, &fx1)
+      .Field("int"sv, &value)
+      .Optional("camera.no-such-key"sv, &optional)
+      .Field("camera.intrinsics[0].fy"sv, &fy0)
+      .Field("camera.day"sv, &day)
+      .Field("flag"sv, &flag)
+      .Field("camera.name"sv, &name)
+      .Optional("camera.intrinsics[3].fx"sv, &optional_nested)
+      .Field("camera.intrinsics[0].fx"sv, &fx0)
+      .Field("values"sv, &values)
+      .Resolve();
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(42, value);
+  EXPECT_EQ("cam", name);
+  EXPECT_DOUBLE_EQ(800.0, fx0);
+  EXPECT_DOUBLE_EQ(750.0, fy0);
+  EXPECT_EQ(400, fx1);
+  EXPECT_EQ(wkc::date(2023, 2, 28), day);
+  EXPECT_EQ(std::vector<double>({1.0, 2.0, 3.0}), values);
+  EXPECT_EQ("default", optional);
+  EXPECT_DOUBLE_EQ(-1.0, optional_nested);
+
+  // Empty binder
+  EXPECT_NO_THROW(config.Bind().Resolve());
+
+  // Invalid bindings
+  EXPECT_THROW(config.Bind().Field("int"sv, static_cast<int32_t *>(nullptr)),
+      wkc::ValueError);
+  EXPECT_THROW(config.Bind().Field("arr[x]"sv, &value), wkc::KeyError);
+
+  // All errors are reported at once
+  int32_t int_val{0};
+  std::string str_val{};
+  double dbl_val{0.0};
+  try {
+    config.Bind()
+        .Field("camera.fx"sv, &dbl_val)
+        .Field("camera.name"sv, &int_val)
+        .Optional("flag"sv, &str_val)
+        .Field("int"sv, &value)
+        .Resolve();
+    FAIL() << "Resolve() should have thrown";
+  } catch (const wkc::KeyError &e) {
+    const std::string msg{e.what()};
+    EXPECT_TRUE(wks::StartsWith(msg, "Cannot resolve all bound parameters"));
+    EXPECT_NE(std::string::npos, msg.find("camera.fx"));
+    EXPECT_NE(std::string::npos, msg.find("camera.name"));
+    EXPECT_NE(std::string::npos, msg.find("flag"));
+    EXPECT_EQ(std::string::npos, msg.find("`int`"));
+  }
+  // Valid parameters are set nonetheless
+  EXPECT_EQ(42, value);
+
+  EXPECT_THROW(config.Bind()
+                   .Optional("camera.name"sv, &int_val)
+                   .Field("values"sv, &str_val)
+                   .Resolve(),
+      wkc::TypeError);
+}
+
+TEST(ConfigKeyTest, TryGet) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    flag = true
+    int = 42
+    big = 2147483648
+    flt = 1.5
+    str = "value"
+    day = 2023-02-28
+    lst = [1, 2.0, 3]
+    mixed = [1, "two"]
+    fractions = [1, 2.5]
+
+    [camera]
+    fx = 800
+    )toml"sv);
+
+  EXPECT_TRUE(config.TryGet<bool>("flag"sv).Value());
+  EXPECT_EQ(42, config.TryGet<int32_t>("int"sv).Value());
+  EXPECT_DOUBLE_EQ(42.0, config.TryGet<double>("int"sv).Value());
+  EXPECT_DOUBLE_EQ(800.0, config.TryGet<double>("camera.fx"sv).Value());
+  EXPECT_DOUBLE_EQ(1.5, config.TryGet<double>("flt"sv).Value());
+  EXPECT_EQ("value", config.TryGet<std::string>("str"sv).Value());
+  EXPECT_EQ(wkc::date(2023, 2, 28), config.TryGet<wkc::date>("day"sv).Value());
+  EXPECT_EQ(2147483648, config.TryGet<int64_t>("big"sv).Value());
+  EXPECT_EQ(std::vector<int32_t>({1, 2, 3}),
+      config.TryGet<std::vector<int32_t>>("lst"sv).Value());
+
+  // Missing parameters
+  auto missing = config.TryGet<double>("camera.fy"sv);
+  EXPECT_FALSE(missing);
+  EXPECT_FALSE(missing.HasValue());
+  EXPECT_EQ(wkc::LookupError::KeyNotFound, missing.Error());
+  EXPECT_DOUBLE_EQ(500.0, missing.ValueOr(500.0));
+  EXPECT_THROW(missing.Value(), wkc::ValueError);
+  EXPECT_EQ(wkc::LookupError::KeyNotFound,
+      config.TryGet<int32_t>("lst[3]"sv).Error());
+  EXPECT_EQ(wkc::LookupError::KeyNotFound,
+      config.TryGet<int32_t>("int.sub"sv).Error());
+
+  // Type mismatches
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<int32_t>("str"sv).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<bool>("int"sv).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<std::string>("camera"sv).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<wkc::time>("day"sv).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<std::vector<double>>("flt"sv).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<std::vector<int32_t>>("mixed"sv).Error());
+
+  // Numeric conversions
+  EXPECT_EQ(wkc::LookupError::NotRepresentable,
+      config.TryGet<int32_t>("big"sv).Error());
+  EXPECT_EQ(wkc::LookupError::NotRepresentable,
+      config.TryGet<int64_t>("flt"sv).Error());
+  EXPECT_EQ(wkc::LookupError::NotRepresentable,
+      config.TryGet<std::vector<int32_t>>("fractions"sv).Error());
+
+  // The same rules apply to key handles.
+  const wkc::Configuration::KeyHandle fx{"camera.fx"sv};
+  const wkc::Configuration::KeyHandle fy{"camera.fy"sv};
+  EXPECT_EQ(800, config.TryGet<int32_t>(fx).Value());
+  EXPECT_EQ(800, config.TryGet<int32_t>(fx).Value());
+  EXPECT_EQ(wkc::LookupError::KeyNotFound, config.TryGet<double>(fy).Error());
+  EXPECT_EQ(wkc::LookupError::TypeMismatch,
+      config.TryGet<std::string>(fx).Error());
+
+  EXPECT_EQ("key_not_found",
+      wkc::LookupErrorToString(wkc::LookupError::KeyNotFound));
+  std::ostringstream str;
+  str << wkc::LookupError::NotRepresentable;
+  EXPECT_EQ("not_representable", str.str());
 }
 
 // NOLINTEND
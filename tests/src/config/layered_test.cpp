@@ -0,0 +1,222 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/layered.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN
+
+TEST(ConfigLayeredTest, Lookup) {
+  wkc::LayeredConfiguration cfg{};
+  EXPECT_TRUE(cfg.Empty());
+  EXPECT_EQ(0, cfg.NumLayers());
+  EXPECT_FALSE(cfg.Contains("name"sv));
+  EXPECT_THROW(cfg.GetString("name"sv), wkc::KeyError);
+  EXPECT_TRUE(cfg.Flatten().Empty());
+
+  auto base = wkc::LoadTOMLString(R"toml(
+    name = "base"
+    threshold = 0.5
+    tags = ["a", "b"]
+
+    [camera]
+    name = "cam"
+    fps = 10
+    roi = [1, 2, 3, 4]
+    intrinsics = { fx = 800.0, fy = 750.0 }
+
+    [storage]
+    path = "/data"
+    )toml"sv);
+  cfg.PushLayer(base);
+  EXPECT_FALSE(cfg.Empty());
+  EXPECT_EQ(cfg.Flatten(), base);
+
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    name = "site"
+    tags = ["c"]
+
+    [camera]
+    fps = 30
+    roi = [5, 6]
+    intrinsics.fx = 900.0
+    )toml"sv));
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    storage = "disabled"
+    )toml"sv));
+  EXPECT_EQ(3, cfg.NumLayers());
+
+  // Layers share the parameters, later modifications are not visible
+  base.SetString("name"sv, "modified");
+  base.SetInt32("added"sv, 3);
+  EXPECT_FALSE(cfg.Contains("added"sv));
+
+  // Top-down resolution
+  EXPECT_EQ("site", cfg.GetString("name"sv));
+  EXPECT_DOUBLE_EQ(0.5, cfg.GetDouble("threshold"sv));
+  EXPECT_EQ("cam", cfg.GetString("camera.name"sv));
+  EXPECT_EQ(30, cfg.GetInt32("camera.fps"sv));
+  EXPECT_EQ(30, cfg.GetInt64("camera.fps"sv));
+  EXPECT_DOUBLE_EQ(30.0, cfg.GetDouble("camera.fps"sv));
+  EXPECT_DOUBLE_EQ(900.0, cfg.GetDouble("camera.intrinsics.fx"sv));
+  EXPECT_DOUBLE_EQ(750.0, cfg.GetDouble("camera.intrinsics.fy"sv));
+  EXPECT_EQ(wkc::ConfigType::Group, cfg.Type("camera"sv));
+  EXPECT_EQ(wkc::ConfigType::String, cfg.Type("storage"sv));
+
+  // Lists are replaced as a whole
+  EXPECT_EQ(std::vector<std::string>{"c"}, cfg.GetStringList("tags"sv));
+  EXPECT_EQ((std::vector<int32_t>{5, 6}), cfg.GetInt32List("camera.roi"sv));
+  EXPECT_TRUE(cfg.Contains("camera.roi[1]"sv));
+  EXPECT_FALSE(cfg.Contains("camera.roi[2]"sv));
+  EXPECT_THROW(cfg.GetInt32("camera.roi[3]"sv), wkc::KeyError);
+
+  // A scalar hides the group of a lower layer
+  EXPECT_FALSE(cfg.Contains("storage.path"sv));
+  EXPECT_THROW(cfg.GetString("storage.path"sv), wkc::KeyError);
+  EXPECT_EQ("default", cfg.GetStringOr("storage.path"sv, "default"sv));
+
+  // Defaults and optionals
+  EXPECT_EQ(17, cfg.GetInt32Or("no-such-key"sv, 17));
+  EXPECT_EQ(30, cfg.GetInt32Or("camera.fps"sv, 17));
+  EXPECT_FALSE(cfg.GetOptionalDouble("no-such-key"sv).has_value());
+  EXPECT_EQ("site", cfg.GetOptionalString("name"sv).value());
+  EXPECT_TRUE(cfg.GetBoolOr("flag"sv, true));
+
+  // Type errors are raised by the providing layer
+  EXPECT_THROW(cfg.GetInt32("name"sv), wkc::TypeError);
+  EXPECT_THROW(cfg.GetInt32Or("name"sv, 3), wkc::TypeError);
+}
+
+TEST(ConfigLayeredTest, Flatten) {
+  wkc::LayeredConfiguration cfg{};
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    name = "base"
+    scalar = 1
+
+    [camera]
+    name = "cam"
+    fps = 10
+    intrinsics = { fx = 800.0, fy = 750.0 }
+
+    [storage]
+    path = "/data"
+    )toml"sv));
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    scalar = { replaced = true }
+
+    [camera]
+    fps = 30
+    intrinsics.fx = 900.0
+
+    [extra]
+    value = 3
+    )toml"sv));
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    storage = "disabled"
+    )toml"sv));
+
+  const auto expected = wkc::LoadTOMLString(R"toml(
+    name = "base"
+    scalar = { replaced = true }
+    storage = "disabled"
+
+    [camera]
+    name = "cam"
+    fps = 30
+    intrinsics = { fx = 900.0, fy = 750.0 }
+
+    [extra]
+    value = 3
+    )toml"sv);
+  const auto flat = cfg.Flatten();
+  EXPECT_EQ(expected, flat);
+
+  // Lookups must be consistent with the merged configuration
+  for (const auto &key : flat.ListParameterNames(true, true)) {
+    EXPECT_TRUE(cfg.Contains(key)) << key;
+    EXPECT_EQ(flat.Type(key), cfg.Type(key)) << key;
+  }
+  EXPECT_TRUE(cfg.GetBool("scalar.replaced"sv));
+
+  // Merged groups
+  EXPECT_EQ(expected.GetGroup("camera"sv), cfg.GetGroup("camera"sv));
+  EXPECT_EQ(expected.GetGroup("camera.intrinsics"sv),
+      cfg.GetGroup("camera.intrinsics"sv));
+  EXPECT_EQ(expected.GetGroup("scalar"sv), cfg.GetGroup("scalar"sv));
+  EXPECT_THROW(cfg.GetGroup("storage"sv), wkc::TypeError);
+  EXPECT_THROW(cfg.GetGroup("no-such-key"sv), wkc::KeyError);
+}
+
+#ifndef _WIN32
+TEST(ConfigLayeredTest, Environment) {
+  setenv("WZKTEST__name", "env", 1);
+  setenv("WZKTEST__camera__fps", "30", 1);
+  setenv("WZKTEST__camera__frame_rate", "29.97", 1);
+  setenv("WZKTEST__camera__roi", "[1, 2]", 1);
+  setenv("WZKTEST__camera__serial", "\"4711\"", 1);
+  setenv("WZKTEST__camera__label", "front-left", 1);
+  setenv("WZKTEST__camera__flag", "true", 1);
+  setenv("WZKTEST__camera__multi", "1\nfoo = 2", 1);
+  setenv("WZKTESTS__other", "1", 1);
+  setenv("WZKTEST_single", "1", 1);
+
+  const auto env = wkc::LoadEnvironment("WZKTEST"sv);
+  EXPECT_EQ(2, env.Size());
+  EXPECT_EQ("env", env.GetString("name"sv));
+  EXPECT_EQ(wkc::ConfigType::Integer, env.Type("camera.fps"sv));
+  EXPECT_EQ(30, env.GetInt32("camera.fps"sv));
+  EXPECT_DOUBLE_EQ(29.97, env.GetDouble("camera.frame_rate"sv));
+  EXPECT_EQ((std::vector<int32_t>{1, 2}), env.GetInt32List("camera.roi"sv));
+  EXPECT_EQ("4711", env.GetString("camera.serial"sv));
+  EXPECT_EQ("front-left", env.GetString("camera.label"sv));
+  EXPECT_TRUE(env.GetBool("camera.flag"sv));
+  EXPECT_EQ("1\nfoo = 2", env.GetString("camera.multi"sv));
+
+  EXPECT_TRUE(wkc::LoadEnvironment("WZKTEST_NO_SUCH_PREFIX"sv).Empty());
+
+  // Environment layer on top of a file
+  wkc::LayeredConfiguration cfg{};
+  cfg.PushLayer(wkc::LoadTOMLString(R"toml(
+    name = "base"
+
+    [camera]
+    fps = 10
+    exposure = 0.01
+    )toml"sv));
+  cfg.PushLayer(env);
+  EXPECT_EQ("env", cfg.GetString("name"sv));
+  EXPECT_EQ(30, cfg.GetInt32("camera.fps"sv));
+  EXPECT_DOUBLE_EQ(0.01, cfg.GetDouble("camera.exposure"sv));
+
+  // Conflicting and invalid variable names
+  setenv("WZKTEST__camera", "1", 1);
+  EXPECT_THROW(wkc::LoadEnvironment("WZKTEST"sv), wkc::ParseError);
+  unsetenv("WZKTEST__camera");
+  setenv("WZKTEST__camera____fps", "1", 1);
+  EXPECT_THROW(wkc::LoadEnvironment("WZKTEST"sv), wkc::ParseError);
+  unsetenv("WZKTEST__camera____fps");
+  EXPECT_NO_THROW(wkc::LoadEnvironment("WZKTEST"sv));
+
+  for (const char *name : {"WZKTEST__name",
+           "WZKTEST__camera__fps",
+           "WZKTEST__camera__frame_rate",
+           "WZKTEST__camera__roi",
+           "WZKTEST__camera__serial",
+           "WZKTEST__camera__label",
+           "WZKTEST__camera__flag",
+           "WZKTEST__camera__multi",
+           "WZKTESTS__other",
+           "WZKTEST_single"}) {
+    unsetenv(name);
+  }
+}
+#endif  // _WIN32
+
+// NOLINTEND
@@ -394,6 +394,55 @@ TEST(ConfigListTest, NumericList) {
   EXPECT_DOUBLE_EQ(-3.0, config.GetDouble("flts[2]"sv));
 }
 
+TEST(ConfigListTest, DoubleListInto) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    flts = [0.5, 1e-3, -2.0]
+    mixed = [1, 2.5, 3]
+    ints = [9007199254740993, 1, 2]
+    strs = ['a', 'b', 'c']
+    nested = [1.0, [2.0], 3.0]
+    empty = []
+    scalar = 1.0
+    )toml");
+
+  std::vector<double> buffer(3, -1.0);
+  EXPECT_NO_THROW(
+      config.GetDoubleListInto("flts"sv, buffer.data(), buffer.size()));
+  EXPECT_DOUBLE_EQ(0.5, buffer[0]);
+  EXPECT_DOUBLE_EQ(1e-3, buffer[1]);
+  EXPECT_DOUBLE_EQ(-2.0, buffer[2]);
+
+  // Integers are converted if they can be exactly represented.
+  EXPECT_NO_THROW(
+      config.GetDoubleListInto("mixed"sv, buffer.data(), buffer.size()));
+  EXPECT_DOUBLE_EQ(1.0, buffer[0]);
+  EXPECT_DOUBLE_EQ(2.5, buffer[1]);
+  EXPECT_DOUBLE_EQ(3.0, buffer[2]);
+  EXPECT_THROW(
+      config.GetDoubleListInto("ints"sv, buffer.data(), buffer.size()),
+      wkc::TypeError);
+  EXPECT_THROW(
+      config.GetDoubleListInto("strs"sv, buffer.data(), buffer.size()),
+      wkc::TypeError);
+  EXPECT_THROW(
+      config.GetDoubleListInto("nested"sv, buffer.data(), buffer.size()),
+      wkc::TypeError);
+
+  // The buffer size must match the list size.
+  EXPECT_THROW(config.GetDoubleListInto("flts"sv, buffer.data(), 2),
+      wkc::ValueError);
+  EXPECT_THROW(config.GetDoubleListInto("empty"sv, buffer.data(), 1),
+      wkc::ValueError);
+  EXPECT_NO_THROW(config.GetDoubleListInto("empty"sv, nullptr, 0));
+
+  EXPECT_THROW(
+      config.GetDoubleListInto("no-such-key"sv, buffer.data(), buffer.size()),
+      wkc::KeyError);
+  EXPECT_THROW(
+      config.GetDoubleListInto("scalar"sv, buffer.data(), buffer.size()),
+      wkc::TypeError);
+}
+
 TEST(ConfigListTest, SetBooleanList) {
   wkc::Configuration config{};
 
@@ -601,6 +650,16 @@ TEST(ConfigListTest, MixedList) {
   EXPECT_THROW(config.GetDateList("types"sv), wkc::TypeError);
   EXPECT_THROW(config.GetInt32List("types"sv), wkc::TypeError);
 
+  // Error messages point to the invalid element.
+  try {
+    config.GetBoolList("types"sv);
+    FAIL() << "Expected a TypeError";
+  } catch (const wkc::TypeError &e) {
+    EXPECT_NE(std::string_view{e.what()}.find("`types[1]`"sv),
+        std::string_view::npos)
+        << "Error message was: " << e.what();
+  }
+
   // But each element can be looked up individually.
   EXPECT_TRUE(config.GetBool("types[0]"sv));
   EXPECT_EQ(-42, config.GetInt64("types[1]"sv));
@@ -0,0 +1,201 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/reflection.h>
+
+#include <string>
+#include <vector>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN
+
+namespace reflection_test {
+struct Intrinsics {
+  double fx{0.0};
+  double fy{0.0};
+  double cx{0.0};
+  double cy{0.0};
+
+  bool operator==(const Intrinsics &other) const {
+    return (fx == other.fx) && (fy == other.fy) && (cx == other.cx) &&
+           (cy == other.cy);
+  }
+};
+WZK_CONFIG_STRUCT(Intrinsics, fx, fy, cx, cy)
+
+struct Camera {
+  std::string name{};
+  int32_t id{0};
+  bool enabled{false};
+  Intrinsics intrinsics{};
+  std::vector<double> distortion{};
+  wkc::date calibrated{};
+
+  bool operator==(const Camera &other) const {
+    return (name == other.name) && (id == other.id) &&
+           (enabled == other.enabled) && (intrinsics == other.intrinsics) &&
+           (distortion == other.distortion) &&
+           (calibrated == other.calibrated);
+  }
+};
+WZK_CONFIG_STRUCT(Camera, name, id, enabled, intrinsics, distortion, calibrated)
+
+struct Rig {
+  std::string label{};
+  std::vector<Camera> cameras{};
+  std::vector<std::string> tags{};
+};
+WZK_CONFIG_STRUCT(Rig, label, cameras, tags)
+}  // namespace reflection_test
+
+TEST(ConfigReflectionTest, Descriptors) {
+  static_assert(
+      wkc::detail::IsConfigStruct<reflection_test::Intrinsics>::value);
+  static_assert(!wkc::detail::IsConfigStruct<double>::value);
+  static_assert(wkc::detail::IsConfigStructVector<
+      std::vector<reflection_test::Camera>>::value);
+  static_assert(!wkc::detail::IsConfigStructVector<std::vector<double>>::value);
+
+  // Field names are available at compile time.
+  constexpr auto fields =
+      wkc::detail::ConfigStructFields<reflection_test::Intrinsics>();
+  static_assert(std::tuple_size_v<decltype(fields)> == 4);
+  static_assert(std::get<2>(fields).name == "cx"sv);
+  static_assert(std::get<2>(fields).member == &reflection_test::Intrinsics::cx);
+}
+
+TEST(ConfigReflectionTest, LoadAndStore) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    label = "stereo"
+    tags = ["left", "right"]
+
+    [[cameras]]
+    name = "left"
+    id = 1
+    enabled = true
+    intrinsics = { fx = 800.0, fy = 750.0, cx = 400.0, cy = 300.0 }
+    distortion = [0.1, -0.2]
+    calibrated = 2023-02-28
+
+    [[cameras]]
+    name = "right"
+    id = 2
+    enabled = false
+    intrinsics = { fx = 810.0, fy = 760.0, cx = 410.0, cy = 310.0 }
+    distortion = []
+    calibrated = 2023-03-01
+    )toml"sv);
+
+  const auto rig = wkc::Load<reflection_test::Rig>(config, ""sv);
+  EXPECT_EQ("stereo", rig.label);
+  EXPECT_EQ(std::vector<std::string>({"left", "right"}), rig.tags);
+  ASSERT_EQ(2, rig.cameras.size());
+  EXPECT_EQ("left", rig.cameras[0].name);
+  EXPECT_EQ(1, rig.cameras[0].id);
+  EXPECT_TRUE(rig.cameras[0].enabled);
+  EXPECT_DOUBLE_EQ(750.0, rig.cameras[0].intrinsics.fy);
+  EXPECT_EQ(std::vector<double>({0.1, -0.2}), rig.cameras[0].distortion);
+  EXPECT_EQ(wkc::date(2023, 2, 28), rig.cameras[0].calibrated);
+  EXPECT_EQ("right", rig.cameras[1].name);
+  EXPECT_DOUBLE_EQ(310.0, rig.cameras[1].intrinsics.cy);
+  EXPECT_TRUE(rig.cameras[1].distortion.empty());
+
+  const auto intrinsics =
+      wkc::Load<reflection_test::Intrinsics>(config, "cameras[1].intrinsics"sv);
+  EXPECT_EQ(rig.cameras[1].intrinsics, intrinsics);
+
+  // Same conversion rules as the getters
+  const auto converted = wkc::Load<reflection_test::Intrinsics>(
+      wkc::LoadTOMLString("fx = 1\nfy = 2\ncx = 3.5\ncy = 4"sv), ""sv);
+  EXPECT_DOUBLE_EQ(1.0, converted.fx);
+  EXPECT_DOUBLE_EQ(3.5, converted.cx);
+
+  // Loading the same configuration again (the field handles memoize the
+  // resolved parameters), also after it has been modified.
+  auto updated = config;
+  EXPECT_EQ(
+      rig.cameras, wkc::Load<reflection_test::Rig>(updated, ""sv).cameras);
+  updated.SetDouble("cameras[0].intrinsics.fy"sv, -1.0);
+  updated.SetString("label"sv, "changed"sv);
+  const auto updated_rig = wkc::Load<reflection_test::Rig>(updated, ""sv);
+  EXPECT_EQ("changed", updated_rig.label);
+  EXPECT_DOUBLE_EQ(-1.0, updated_rig.cameras[0].intrinsics.fy);
+  EXPECT_EQ(rig.cameras[1], updated_rig.cameras[1]);
+
+  // Store and reload
+  wkc::Configuration stored{};
+  wkc::Store(stored, "rig"sv, rig);
+  EXPECT_EQ(
+      config.GetGroup("cameras[0]"sv), stored.GetGroup("rig.cameras[0]"sv));
+  const auto reloaded = wkc::Load<reflection_test::Rig>(stored, "rig"sv);
+  EXPECT_EQ(rig.label, reloaded.label);
+  EXPECT_EQ(rig.tags, reloaded.tags);
+  EXPECT_EQ(rig.cameras, reloaded.cameras);
+
+  // Storing replaces existing lists
+  auto modified = rig;
+  modified.cameras.pop_back();
+  modified.cameras[0].intrinsics.fx = -1.0;
+  wkc::Store(stored, "rig"sv, modified);
+  EXPECT_EQ(1, stored.Size("rig.cameras"sv));
+  EXPECT_DOUBLE_EQ(-1.0, stored.GetDouble("rig.cameras[0].intrinsics.fx"sv));
+
+  // Storing at the root
+  wkc::Configuration root{};
+  wkc::Store(root, ""sv, rig);
+  EXPECT_EQ(config, root);
+}
+
+TEST(ConfigReflectionTest, Errors) {
+  const auto config = wkc::LoadTOMLString(R"toml(
+    camera.name = "cam"
+    camera.id = "invalid"
+    camera.intrinsics = { fx = 800.0 }
+    camera.distortion = [0.1]
+    )toml"sv);
+
+  try {
+    wkc::Load<reflection_test::Camera>(config, "camera"sv);
+    FAIL() << "Load() should have thrown";
+  } catch (const wkc::KeyError &e) {
+    // All errors are reported at once.
+    const std::string msg{e.what()};
+    EXPECT_NE(std::string::npos, msg.find("`id`"));
+    EXPECT_NE(std::string::npos, msg.find("`enabled`"));
+    EXPECT_NE(std::string::npos, msg.find("In group `camera.intrinsics`"));
+    EXPECT_NE(std::string::npos, msg.find("`fy`"));
+    EXPECT_NE(std::string::npos, msg.find("`calibrated`"));
+    EXPECT_EQ(std::string::npos, msg.find("`name`"));
+    EXPECT_EQ(std::string::npos, msg.find("`distortion`"));
+  }
+
+  try {
+    wkc::Load<reflection_test::Intrinsics>(config, "camera.intrinsics"sv);
+    FAIL() << "Load() should have thrown";
+  } catch (const wkc::KeyError &e) {
+    const std::string msg{e.what()};
+    EXPECT_NE(std::string::npos, msg.find("`fy`"));
+    EXPECT_NE(std::string::npos, msg.find("`cx`"));
+  }
+  EXPECT_THROW(wkc::Load<reflection_test::Intrinsics>(
+                   wkc::LoadTOMLString("fx = 1\nfy = 2\ncx = 3\ncy = 'x'"sv),
+                   ""sv),
+      wkc::TypeError);
+  EXPECT_THROW(wkc::Load<reflection_test::Intrinsics>(config, "none"sv),
+      wkc::KeyError);
+  EXPECT_THROW(wkc::Load<reflection_test::Intrinsics>(config, "camera.id"sv),
+      wkc::TypeError);
+
+  EXPECT_THROW(wkc::Load<reflection_test::Rig>(config, "camera"sv),
+      wkc::KeyError);
+
+  wkc::Configuration stored{};
+  stored.SetString("cam.intrinsics.fx"sv, "invalid");
+  EXPECT_THROW(wkc::Store(stored, "cam"sv, reflection_test::Camera{}),
+      wkc::TypeError);
+}
+
+// NOLINTEND
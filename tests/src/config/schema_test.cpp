@@ -0,0 +1,207 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/schema.h>
+
+#include <string>
+#include <vector>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN
+
+namespace {
+wkc::Schema CreateSchema() {
+  return wkc::Schema::FromConfiguration(wkc::LoadTOMLString(R"toml(
+    [[parameters]]
+    key = "name"
+    type = "string"
+    required = true
+
+    [[parameters]]
+    key = "camera.fx"
+    type = "floating_point"
+    required = true
+    min = 0.0
+
+    [[parameters]]
+    key = "camera.fps"
+    type = "integer"
+    min = 1
+    max = 120
+
+    [[parameters]]
+    key = "camera.K"
+    shape = [3, 3]
+
+    [[parameters]]
+    key = "camera.distortion"
+    element_type = "floating_point"
+    min_length = 4
+    max_length = 8
+
+    [[parameters]]
+    key = "roi[*].width"
+    type = "integer"
+    required = true
+
+    [[parameters]]
+    key = "roi[0].label"
+    type = "string"
+    )toml"sv));
+}
+}  // namespace
+
+TEST(ConfigSchemaTest, Valid) {
+  const wkc::Schema empty{};
+  EXPECT_EQ(0, empty.NumRules());
+  EXPECT_TRUE(empty.Check(wkc::Configuration{}).empty());
+
+  const wkc::Schema schema = CreateSchema();
+  EXPECT_EQ(7, schema.NumRules());
+
+  const auto cfg = wkc::LoadTOMLString(R"toml(
+    name = "valid"
+    unchecked = true
+
+    [camera]
+    fx = 800
+    fps = 30
+    K = [[800, 0, 400], [0, 800, 300], [0, 0, 1.0]]
+    distortion = [0.1, -0.2, 0, 0, 0.3]
+
+    [[roi]]
+    width = 10
+    label = "first"
+
+    [[roi]]
+    width = 20
+    )toml"sv);
+  EXPECT_TRUE(schema.Check(cfg).empty());
+  EXPECT_NO_THROW(schema.Validate(cfg));
+
+  // Optional parameters may be omitted.
+  const auto minimal = wkc::LoadTOMLString(R"toml(
+    name = "minimal"
+    camera.fx = 1.0
+    )toml"sv);
+  EXPECT_TRUE(schema.Check(minimal).empty());
+
+  // Copies share the compiled rules.
+  const wkc::Schema copy{schema};
+  EXPECT_EQ(7, copy.NumRules());
+  EXPECT_TRUE(copy.Check(minimal).empty());
+}
+
+TEST(ConfigSchemaTest, Violations) {
+  const wkc::Schema schema = CreateSchema();
+
+  // Missing required parameters (including the nested ones).
+  auto violations = schema.Check(wkc::Configuration{});
+  ASSERT_EQ(2, violations.size());
+  EXPECT_EQ("camera.fx", violations[0].key);
+  EXPECT_EQ("name", violations[1].key);
+  EXPECT_NE(std::string::npos, violations[1].message.find("required"));
+
+  // All violations are reported at once.
+  const auto cfg = wkc::LoadTOMLString(R"toml(
+    name = 42
+
+    [camera]
+    fx = -1.0
+    fps = 240
+    K = [[1, 0, 0], [0, 1], [0, 0, 1]]
+    distortion = [0.1, "invalid"]
+
+    [[roi]]
+    label = 3
+
+    [[roi]]
+    width = "wide"
+    )toml"sv);
+  violations = schema.Check(cfg);
+  std::vector<std::string> keys{};
+  for (const auto &violation : violations) {
+    keys.push_back(violation.key);
+  }
+  const std::vector<std::string> expected{"camera.K",
+      "camera.distortion",
+      "camera.distortion",
+      "camera.fps",
+      "camera.fx",
+      "name",
+      "roi[0].label",
+      "roi[0].width",
+      "roi[1].width"};
+  EXPECT_EQ(expected, keys);
+  EXPECT_NE(std::string::npos, violations[0].message.find("3x3 matrix"));
+  EXPECT_NE(std::string::npos, violations[1].message.find("at least 4"));
+  EXPECT_NE(std::string::npos, violations[2].message.find("element [1]"));
+  EXPECT_NE(std::string::npos, violations[3].message.find("maximum 120"));
+  EXPECT_NE(std::string::npos, violations[4].message.find("minimum 0"));
+  EXPECT_NE(std::string::npos,
+      violations[5].message.find("must be `string`, but is `integer`"));
+
+  EXPECT_THROW(schema.Validate(cfg), wkc::ValueError);
+  try {
+    schema.Validate(cfg);
+  } catch (const wkc::ValueError &e) {
+    const std::string msg{e.what()};
+    EXPECT_NE(std::string::npos, msg.find("`camera.fps`"));
+    EXPECT_NE(std::string::npos, msg.find("`roi[1].width`"));
+  }
+
+  // Matrix dimensions can be left unspecified.
+  const auto any_rows = wkc::Schema::FromConfiguration(wkc::LoadTOMLString(
+      "parameters = [{ key = 'points', shape = [-1, 2] }]"sv));
+  EXPECT_TRUE(any_rows
+                  .Check(wkc::LoadTOMLString(
+                      "points = [[1, 2], [3, 4], [5, 6]]"sv))
+                  .empty());
+  EXPECT_EQ(1,
+      any_rows.Check(wkc::LoadTOMLString("points = [[1, 2], [3]]"sv)).size());
+  EXPECT_EQ(1, any_rows.Check(wkc::LoadTOMLString("points = 3"sv)).size());
+}
+
+TEST(ConfigSchemaTest, Description) {
+  // JSON descriptions
+  const auto schema = wkc::Schema::FromConfiguration(wkc::LoadJSONString(R"json(
+    { "parameters": [
+        { "key": "value", "type": "integer", "required": true }
+      ]
+    })json"sv));
+  EXPECT_EQ(1, schema.NumRules());
+  EXPECT_TRUE(schema.Check(wkc::LoadTOMLString("value = 3"sv)).empty());
+  EXPECT_EQ(1, schema.Check(wkc::LoadTOMLString("value = 3.5"sv)).size());
+
+  const auto parse = [](std::string_view toml) -> wkc::Schema {
+    return wkc::Schema::FromConfiguration(wkc::LoadTOMLString(toml));
+  };
+  EXPECT_EQ(0, parse(""sv).NumRules());
+  EXPECT_THROW(parse("parameters = 3"sv), wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [3]"sv), wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [{ type = 'integer' }]"sv),
+      wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [{ key = 'a', type = 'int' }]"sv),
+      wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [{ key = 'a', unknown = 3 }]"sv),
+      wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [{ key = 'a', min = 'low' }]"sv),
+      wkc::ParseError);
+  EXPECT_THROW(parse("parameters = [{ key = 'a', shape = [3] }]"sv),
+      wkc::ParseError);
+  for (const auto key : {"''", "'a.'", "'a..b'", "'[0]'", "'a[x]'", "'a[]'",
+           "'a[0]b'", "'a[0'"}) {
+    std::string toml{"parameters = [{ key = "};
+    toml += key;
+    toml += " }]";
+    EXPECT_THROW(parse(toml), wkc::ParseError) << "Key: " << key;
+  }
+  EXPECT_EQ(1, parse("parameters = [{ key = 'a[0][*].b' }]"sv).NumRules());
+
+  EXPECT_THROW(wkc::Schema::LoadFile("no-such-file.toml"sv), wkc::ParseError);
+}
+
+// NOLINTEND
@@ -1,6 +1,8 @@
 #include <werkzeugkiste/config/configuration.h>
 #include <werkzeugkiste/files/filesys.h>
 
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
 #include "../test_utils.h"
@@ -79,6 +81,107 @@ TEST(ConfigUtilsTest, NestedTOML) {
       config.GetString("lvl1.another_arr[1].nested.section1.rel_path"sv));
 }
 
+TEST(ConfigUtilsTest, NestedTOMLBatch) {
+  const auto fname_valid =
+      wkf::FullFile(wkf::DirName(__FILE__), "test-valid1.toml"sv);
+  const auto fname_invalid =
+      wkf::FullFile(wkf::DirName(__FILE__), "test-invalid.toml"sv);
+  std::ostringstream toml_str;
+  toml_str << "integer = 3\n"
+              "first.include = \""sv
+           << fname_valid
+           << "\"\n"
+              "second.include = \""sv
+           << fname_valid
+           << "\"\n"
+              "lvl1.lvl2.include = \""sv
+           << fname_valid
+           << "\"\n"
+              "lvl1.include = 42\n"
+              "tables = [{ name = 'test', include = \""sv
+           << fname_valid << "\" }]\n"sv
+           << "arr = [\"" << fname_valid << "\"]\n"sv
+           << "invalid.include = \""sv << fname_invalid << "\"\n"sv;
+
+  auto config = wkc::LoadTOMLString(toml_str.str());
+  const wkc::Configuration original{config};
+
+  EXPECT_FALSE(config.LoadNestedConfigurations({"no-such-key"sv}));
+  EXPECT_FALSE(config.LoadNestedConfigurations({"integer"sv}));
+
+  // Nested configurations cannot be loaded into an array.
+  EXPECT_THROW(config.LoadNestedConfigurations({"arr[*]"sv}), wkc::TypeError);
+
+  // If any file cannot be loaded, the configuration must not change.
+  EXPECT_THROW(config.LoadNestedConfigurations({"*include"sv}),
+      wkc::ParseError);
+  EXPECT_EQ(original, config);
+
+  // Same results as loading them one by one.
+  wkc::Configuration expected{config};
+  for (const auto key : {"first.include"sv, "second.include"sv,
+           "lvl1.lvl2.include"sv, "tables[0].include"sv}) {
+    expected.LoadNestedConfiguration(key);
+  }
+  EXPECT_TRUE(config.LoadNestedConfigurations(
+      {"first.include"sv, "second.include"sv, "lvl1.*.include"sv,
+          "lvl1.include"sv, "tables[*].include"sv}));
+  EXPECT_EQ(expected, config);
+  EXPECT_EQ(1, config.GetInt32("first.include.value1"sv));
+  EXPECT_DOUBLE_EQ(2.3, config.GetDouble("second.include.value2"sv));
+  EXPECT_EQ("this/is/a/relative/path",
+      config.GetString("lvl1.lvl2.include.section1.rel_path"sv));
+  EXPECT_EQ(42, config.GetInt32("lvl1.include"sv));
+  EXPECT_EQ(1, config.GetInt32("tables[0].include.value1"sv));
+
+  // Modifying one copy must not affect the others (which have been loaded
+  // from the same file).
+  config.SetInt32("first.include.value1"sv, -1);
+  EXPECT_EQ(1, config.GetInt32("second.include.value1"sv));
+
+  // Subsequent calls must load the modified file, with or without cache.
+  const std::string fname_tmp =
+      (std::filesystem::temp_directory_path() / "wzk-nested-batch.toml")
+          .string();
+  const std::string include = "param = \"" + fname_tmp + "\"";
+  {
+    std::ofstream ofs{fname_tmp, std::ios::out | std::ios::trunc};
+    ofs << "value = 1\n";
+  }
+  wkc::NestedConfigurationCache cache{};
+  EXPECT_EQ(0, cache.Size());
+  config = wkc::LoadTOMLString(include);
+  EXPECT_TRUE(config.LoadNestedConfigurations({"param"sv}));
+  EXPECT_EQ(1, config.GetInt32("param.value"sv));
+  config = wkc::LoadTOMLString(include);
+  EXPECT_TRUE(config.LoadNestedConfigurations({"param"sv}, cache));
+  EXPECT_EQ(1, config.GetInt32("param.value"sv));
+  EXPECT_EQ(1, cache.Size());
+
+  // A cached file must not be affected by modifying the loaded copy.
+  config.SetInt32("param.value"sv, -1);
+  config = wkc::LoadTOMLString(include);
+  EXPECT_TRUE(config.LoadNestedConfigurations({"param"sv}, cache));
+  EXPECT_EQ(1, config.GetInt32("param.value"sv));
+  EXPECT_EQ(1, cache.Size());
+
+  {
+    std::ofstream ofs{fname_tmp, std::ios::out | std::ios::trunc};
+    ofs << "value = 1234\n";
+  }
+  config = wkc::LoadTOMLString(include);
+  EXPECT_TRUE(config.LoadNestedConfigurations({"param"sv}));
+  EXPECT_EQ(1234, config.GetInt32("param.value"sv));
+  config = wkc::LoadTOMLString(include);
+  EXPECT_TRUE(config.LoadNestedConfigurations({"param"sv}, cache));
+  EXPECT_EQ(1234, config.GetInt32("param.value"sv));
+  EXPECT_EQ(1, cache.Size());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.Size());
+  std::filesystem::remove(fname_tmp);
+}
+
 TEST(ConfigUtilsTest, AbsolutePaths) {
   const std::string fname =
       wkf::FullFile(wkf::DirName(__FILE__), "test-valid1.toml"sv);
@@ -208,6 +311,264 @@ TEST(ConfigUtilsTest, StringReplacements) {
   EXPECT_EQ("Hello world!", copy.GetString("str3"sv));
   EXPECT_EQ("Anothfoor tfoost!", copy.GetString("table.str1"sv));
   EXPECT_EQ("Untouchfood", copy.GetString("table.str2"sv));
+
+  // Replacements are not searched again
+  copy.SetString("str1"sv, "aXa"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders({{"a"sv, "aa"sv}}));
+  EXPECT_EQ("aaXaa", copy.GetString("str1"sv));
+  copy.SetString("str1"sv, "abc"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders(
+      {{"a"sv, "b"sv}, {"b"sv, "c"sv}, {"c"sv, "a"sv}}));
+  EXPECT_EQ("bca", copy.GetString("str1"sv));
+
+  // Overlapping needles: leftmost, then longest match wins
+  copy.SetString("str1"sv, "abcdef ${A}${AB} abc"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders({{"bcd"sv, "1"sv},
+      {"abcde"sv, "2"sv},
+      {"ab"sv, "3"sv},
+      {"c"sv, "4"sv},
+      {"${A}"sv, "5"sv},
+      {"${AB}"sv, "6"sv}}));
+  EXPECT_EQ("2f 56 34", copy.GetString("str1"sv));
+  copy.SetString("str1"sv, "abcd!"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders(
+      {{"ab"sv, "1"sv}, {"abcdz"sv, "2"sv}, {"c"sv, "3"sv}}));
+  EXPECT_EQ("13d!", copy.GetString("str1"sv));
+
+  // The first replacement of duplicate needles is used
+  copy.SetString("str1"sv, "foo"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders(
+      {{"foo"sv, "bar"sv}, {"foo"sv, "baz"sv}}));
+  EXPECT_EQ("bar", copy.GetString("str1"sv));
+
+  // Non-ASCII characters
+  copy.SetString("str1"sv, "Grüße aus Österreich"sv);
+  EXPECT_TRUE(copy.ReplaceStringPlaceholders({{"ü"sv, "ue"sv},
+      {"ß"sv, "ss"sv},
+      {"Ö"sv, "Oe"sv}}));
+  EXPECT_EQ("Gruesse aus Oesterreich", copy.GetString("str1"sv));
+}
+
+TEST(ConfigUtilsTest, RewriteStrings) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    name = "${SESSION}"
+    video = "${SESSION}/video.mp4"
+    abs_path = "/${SESSION}/video.mp4"
+    url_path = "file://${SESSION}/frames"
+    value = 42
+
+    [camera]
+    calib_path = "${CAMERA}.toml"
+    label = "${CAMERA}.toml"
+    )toml"sv);
+  wkc::Configuration copy{config};
+
+  const std::string base_dir = wkf::DirName(__FILE__);
+  EXPECT_TRUE(config.RewriteStrings(
+      {{"${SESSION}"sv, "2023"sv}, {"${CAMERA}"sv, "front"sv}},
+      base_dir,
+      {"video"sv, "*path"sv}));
+  EXPECT_EQ("2023", config.GetString("name"sv));
+  EXPECT_EQ(wkf::FullFile(base_dir, "2023/video.mp4"sv),
+      config.GetString("video"sv));
+  EXPECT_EQ("/2023/video.mp4", config.GetString("abs_path"sv));
+  EXPECT_EQ("file://" + wkf::FullFile(base_dir, "2023/frames"sv),
+      config.GetString("url_path"sv));
+  EXPECT_EQ(42, config.GetInt32("value"sv));
+  EXPECT_EQ(wkf::FullFile(base_dir, "front.toml"sv),
+      config.GetString("camera.calib_path"sv));
+  EXPECT_EQ("front.toml", config.GetString("camera.label"sv));
+
+  // Same result as the separate utilities
+  wkc::Configuration separate{copy};
+  EXPECT_TRUE(separate.ReplaceStringPlaceholders(
+      {{"${SESSION}"sv, "2023"sv}, {"${CAMERA}"sv, "front"sv}}));
+  EXPECT_TRUE(separate.AdjustRelativePaths(base_dir, {"video"sv, "*path"sv}));
+  EXPECT_EQ(separate, config);
+
+  // Nothing to rewrite
+  EXPECT_FALSE(config.RewriteStrings({}, base_dir, {}));
+  EXPECT_FALSE(config.RewriteStrings(
+      {{"${SESSION}"sv, "2023"sv}}, base_dir, {"*path"sv}));
+
+  // Only below a specific group
+  EXPECT_TRUE(copy.RewriteStrings(
+      "camera"sv, {{"${CAMERA}"sv, "rear"sv}}, base_dir, {"*path"sv}));
+  EXPECT_EQ("${SESSION}/video.mp4", copy.GetString("video"sv));
+  EXPECT_EQ(wkf::FullFile(base_dir, "rear.toml"sv),
+      copy.GetString("camera.calib_path"sv));
+
+  // Edge cases
+  EXPECT_THROW(copy.RewriteStrings({{""sv, "x"sv}}, base_dir, {}),
+      wkc::ValueError);
+  EXPECT_THROW(copy.RewriteStrings("foo"sv, {}, base_dir, {}), wkc::KeyError);
+  EXPECT_THROW(
+      copy.RewriteStrings("value"sv, {}, base_dir, {}), wkc::TypeError);
+}
+
+TEST(ConfigUtilsTest, DiffAndPatch) {
+  const auto original = wkc::LoadTOMLString(R"toml(
+    name = "original"
+    unchanged = 1
+    to_remove = true
+    lst = [1, 2, 3]
+
+    [camera]
+    fx = 800.0
+    fy = 750.0
+    stream.url = "rtsp://localhost"
+
+    [old_group]
+    value = 3
+
+    [type_change]
+    value = 4
+    )toml"sv);
+
+  const auto updated = wkc::LoadTOMLString(R"toml(
+    name = "updated"
+    unchanged = 1
+    lst = [1, 2, 4]
+    added = 2023-02-28
+    type_change = "now a string"
+
+    [camera]
+    fx = 800.0
+    fy = 750.5
+    stream.url = "rtsp://localhost"
+    stream.fps = 30
+
+    [new_group]
+    value = 3
+    )toml"sv);
+
+  // Equal configurations
+  EXPECT_TRUE(original.Diff(original).Empty());
+  EXPECT_TRUE(original.Diff(wkc::Configuration{original}).Empty());
+  EXPECT_FALSE(original.Diff(wkc::Configuration{}).Empty());
+  EXPECT_TRUE(wkc::Configuration{}.Diff(wkc::Configuration{}).Empty());
+
+  // NaNs are considered equal, consistent with `Equals`.
+  const auto nan1 = wkc::LoadTOMLString("x = nan\nlst = [nan]"sv);
+  const auto nan2 = wkc::LoadTOMLString("x = nan\nlst = [nan]"sv);
+  EXPECT_TRUE(nan1.Equals(nan2));
+  EXPECT_TRUE(nan1.Diff(nan2).Empty());
+  EXPECT_FALSE(nan1.Diff(wkc::LoadTOMLString("x = 1.0\nlst = [nan]"sv))
+                   .Empty());
+
+  const auto diff = original.Diff(updated);
+  EXPECT_FALSE(diff.Empty());
+  using Keys = std::vector<std::string>;
+  EXPECT_EQ(Keys({"added", "camera.stream.fps", "new_group"}), diff.added);
+  EXPECT_EQ(Keys({"old_group", "to_remove"}), diff.removed);
+  EXPECT_EQ(Keys({"camera.fy", "lst", "name", "type_change"}), diff.changed);
+
+  // The inverse diff swaps added/removed parameters.
+  const auto inverse = updated.Diff(original);
+  EXPECT_EQ(diff.added, inverse.removed);
+  EXPECT_EQ(diff.removed, inverse.added);
+  EXPECT_EQ(diff.changed, inverse.changed);
+
+  // Subscribing to key prefixes
+  EXPECT_TRUE(diff.Affects(""sv));
+  EXPECT_TRUE(diff.Affects("camera"sv));
+  EXPECT_TRUE(diff.Affects("camera.stream"sv));
+  EXPECT_TRUE(diff.Affects("camera.stream.fps"sv));
+  EXPECT_FALSE(diff.Affects("camera.stream.url"sv));
+  EXPECT_FALSE(diff.Affects("camera.fx"sv));
+  EXPECT_FALSE(diff.Affects("cam"sv));
+  EXPECT_TRUE(diff.Affects("lst[1]"sv));
+  EXPECT_TRUE(diff.Affects("new_group.value"sv));
+  EXPECT_FALSE(diff.Affects("unchanged"sv));
+  EXPECT_FALSE(wkc::ConfigurationDiff{}.Affects(""sv));
+
+  // Patching
+  auto patched = original;
+  patched.ApplyPatch(updated, diff);
+  EXPECT_EQ(updated, patched);
+  EXPECT_TRUE(patched.Diff(updated).Empty());
+  EXPECT_EQ("original", original.GetString("name"sv));
+
+  // Patching with an empty diff is a no-op.
+  patched.ApplyPatch(original, wkc::ConfigurationDiff{});
+  EXPECT_EQ(updated, patched);
+
+  // The diff must belong to the configurations. A failing patch must not
+  // modify the configuration.
+  patched = original;
+  EXPECT_THROW(patched.ApplyPatch(original, diff), wkc::KeyError);
+  EXPECT_EQ(original, patched);
+  EXPECT_THROW(patched.ApplyPatch(updated, inverse), wkc::KeyError);
+  EXPECT_EQ(original, patched);
+
+  // Valid removals but an invalid insertion (its parent is removed).
+  wkc::ConfigurationDiff patch{};
+  patch.removed = {"camera", "to_remove"};
+  patch.added = {"added"};
+  patch.changed = {"camera.fy"};
+  EXPECT_THROW(patched.ApplyPatch(updated, patch), wkc::KeyError);
+  EXPECT_EQ(original, patched);
+
+  // Nested parameters of a removed group no longer exist.
+  patch = wkc::ConfigurationDiff{};
+  patch.removed = {"camera", "camera.fx"};
+  EXPECT_THROW(patched.ApplyPatch(updated, patch), wkc::KeyError);
+  EXPECT_EQ(original, patched);
+
+  // Inserted groups can be patched further.
+  patch = wkc::ConfigurationDiff{};
+  patch.added = {"new_group", "new_group.value"};
+  patched.ApplyPatch(updated, patch);
+  EXPECT_EQ(3, patched.GetInt32("new_group.value"sv));
+}
+
+TEST(ConfigUtilsTest, KeySuggestions) {
+  auto config = wkc::LoadTOMLString(R"toml(
+    value1 = 1
+    value2 = 2
+    other = 3
+
+    [table]
+    value = 4
+    lst = [1, 2]
+    )toml"sv);
+
+  const auto message = [](const wkc::Configuration &cfg,
+                           std::string_view key) -> std::string {
+    try {
+      cfg.GetInt32(key);
+    } catch (const wkc::KeyError &e) {
+      return e.what();
+    }
+    return "";
+  };
+
+  EXPECT_TRUE(wkc::AreKeySuggestionsEnabled());
+  EXPECT_EQ("Key `value` does not exist! Did you mean: `value1`, `value2`?",
+      message(config, "value"sv));
+  EXPECT_EQ("Key `table.lst[2]` does not exist! Did you mean: "
+            "`table.lst[0]`, `table.lst[1]`?",
+      message(config, "table.lst[2]"sv));
+  EXPECT_EQ("Key `xyz` does not exist!", message(config, "xyz"sv));
+
+  // The suggestions reflect modifications.
+  const auto copy = config;
+  config.SetInt32("value"sv, 5);
+  config.Delete("value2"sv);
+  EXPECT_EQ("Key `valuex` does not exist! Did you mean: `value`, `value1`?",
+      message(config, "valuex"sv));
+  EXPECT_EQ("Key `valuex` does not exist! Did you mean: `value1`, `value2`?",
+      message(copy, "valuex"sv));
+  EXPECT_EQ("Key `lst[2]` does not exist! Did you mean: `lst[0]`, `lst[1]`?",
+      message(config.GetGroup("table"sv), "lst[2]"sv));
+
+  wkc::EnableKeySuggestions(false);
+  EXPECT_FALSE(wkc::AreKeySuggestionsEnabled());
+  EXPECT_EQ("Key `value1x` does not exist!", message(config, "value1x"sv));
+  EXPECT_THROW(config.Size("value1x"sv), wkc::KeyError);
+  wkc::EnableKeySuggestions(true);
+  EXPECT_EQ("Key `value1x` does not exist! Did you mean: `value1`, `value`?",
+      message(config, "value1x"sv));
 }
 
 // NOLINTEND
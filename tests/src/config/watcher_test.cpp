@@ -0,0 +1,141 @@
+#include <werkzeugkiste/config/configuration.h>
+#include <werkzeugkiste/config/watcher.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../test_utils.h"
+
+namespace wkc = werkzeugkiste::config;
+
+using namespace std::string_view_literals;
+
+// NOLINTBEGIN
+
+namespace {
+void WriteFile(const std::string &filename, std::string_view content) {
+  std::ofstream ofs{filename, std::ios::out | std::ios::trunc};
+  ofs << content;
+}
+
+/// Waits until the watcher published the given version (or times out).
+bool WaitForVersion(const wkc::ConfigurationWatcher &watcher,
+    uint64_t version) {
+  const auto timeout =
+      std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  while (std::chrono::steady_clock::now() < timeout) {
+    if (watcher.Version() >= version) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+  return false;
+}
+
+void CheckWatcher(bool force_polling) {
+  const auto tmp_dir = std::filesystem::temp_directory_path();
+  const std::string suffix = force_polling ? "-polling" : "-notify";
+  const std::string fname =
+      (tmp_dir / ("wzk-watcher-test" + suffix + ".toml")).string();
+  const std::string fname_nested =
+      (tmp_dir / ("wzk-watcher-nested" + suffix + ".toml")).string();
+
+  WriteFile(fname_nested, "value = 1\n");
+  WriteFile(fname, "name = \"initial\"\nnested = \"" + fname_nested + "\"\n");
+
+  EXPECT_THROW(wkc::ConfigurationWatcher("no-such-file.toml"sv),
+      wkc::ParseError);
+
+  wkc::WatcherOptions options{};
+  options.nested_keys = {"nested"};
+  options.debounce = std::chrono::milliseconds{20};
+  options.poll_interval = std::chrono::milliseconds{5};
+  options.force_polling = force_polling;
+
+  wkc::ConfigurationWatcher watcher{fname, options};
+  if (force_polling) {
+    EXPECT_TRUE(watcher.IsPolling());
+  }
+  EXPECT_EQ(1, watcher.Version());
+  EXPECT_TRUE(watcher.LastError().empty());
+  EXPECT_EQ(2, watcher.WatchedFiles().size());
+  EXPECT_EQ(fname_nested, watcher.WatchedFiles()[1]);
+
+  const auto initial = watcher.Current();
+  EXPECT_EQ("initial", initial->GetString("name"sv));
+  EXPECT_EQ(1, initial->GetInt32("nested.value"sv));
+
+  std::atomic<int> num_callbacks{0};
+  std::atomic<bool> nested_changed{false};
+  watcher.OnReload([&](const wkc::Configuration &cfg,
+                       const wkc::ConfigurationDiff &diff) {
+    EXPECT_FALSE(diff.Empty());
+    EXPECT_TRUE(cfg.Contains("name"sv));
+    nested_changed = nested_changed || diff.Affects("nested"sv);
+    ++num_callbacks;
+  });
+
+  // Modifying the main file (the mtime granularity of some file systems is
+  // coarse, thus changing the size ensures that polling detects it).
+  WriteFile(fname,
+      "name = \"modified\"\nnested = \"" + fname_nested + "\"\n");
+  ASSERT_TRUE(WaitForVersion(watcher, 2));
+  EXPECT_EQ("modified", watcher.Current()->GetString("name"sv));
+  EXPECT_EQ(1, num_callbacks);
+  EXPECT_FALSE(nested_changed);
+  // Previously obtained snapshots are not affected.
+  EXPECT_EQ("initial", initial->GetString("name"sv));
+
+  // Modifying the nested file
+  WriteFile(fname_nested, "value = 42\n");
+  ASSERT_TRUE(WaitForVersion(watcher, 3));
+  EXPECT_EQ(42, watcher.Current()->GetInt32("nested.value"sv));
+  EXPECT_EQ(2, num_callbacks);
+  EXPECT_TRUE(nested_changed);
+
+  // An invalid file keeps the previous snapshot.
+  WriteFile(fname, "name = \"invalid\nnested = 3\n");
+  const auto timeout =
+      std::chrono::steady_clock::now() + std::chrono::seconds{5};
+  while (watcher.LastError().empty() &&
+         (std::chrono::steady_clock::now() < timeout)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+  EXPECT_FALSE(watcher.LastError().empty());
+  EXPECT_EQ(3, watcher.Version());
+  EXPECT_EQ("modified", watcher.Current()->GetString("name"sv));
+
+  // Fixing the file
+  WriteFile(fname, "name = \"fixed\"\nnested = \"" + fname_nested + "\"\n");
+  ASSERT_TRUE(WaitForVersion(watcher, 4));
+  EXPECT_TRUE(watcher.LastError().empty());
+  EXPECT_EQ("fixed", watcher.Current()->GetString("name"sv));
+  EXPECT_EQ(42, watcher.Current()->GetInt32("nested.value"sv));
+
+  // Exceptions raised by the callback are reported via the last error.
+  watcher.OnReload([](const wkc::Configuration &,
+                       const wkc::ConfigurationDiff &) {
+    throw std::runtime_error{"callback failed"};
+  });
+  WriteFile(fname, "name = \"thrown\"\nnested = \"" + fname_nested + "\"\n");
+  ASSERT_TRUE(WaitForVersion(watcher, 5));
+  EXPECT_EQ("thrown", watcher.Current()->GetString("name"sv));
+  EXPECT_EQ("callback failed", watcher.LastError());
+
+  std::filesystem::remove(fname);
+  std::filesystem::remove(fname_nested);
+}
+}  // namespace
+
+TEST(ConfigWatcherTest, Polling) { CheckWatcher(/*force_polling=*/true); }
+
+TEST(ConfigWatcherTest, Notifications) {
+  CheckWatcher(/*force_polling=*/false);
+}
+
+// NOLINTEND
@@ -1,6 +1,8 @@
 #include <werkzeugkiste/files/fileio.h>
 #include <werkzeugkiste/strings/strings.h>
 
+#include <filesystem>
+#include <fstream>
 #include <string>
 
 #include "../test_utils.h"
@@ -17,7 +19,7 @@ TEST(FileIOTest, ReadFile) {
   auto concatenated = wks::RTrim(wks::Concatenate(lines, "\n"));
   EXPECT_EQ(content.length(), concatenated.length());
   EXPECT_EQ(content, concatenated);
-  EXPECT_EQ(42, lines.size());
+  EXPECT_EQ(82, lines.size());
 }
 
 TEST(FileIOTest, Iterator) {
@@ -33,10 +35,48 @@ TEST(FileIOTest, Iterator) {
     ++iterator;
     ++line_nr;
   }
-  EXPECT_EQ(42, lines.size());
+  EXPECT_EQ(82, lines.size());
 
   std::string content = wks::RTrim(wkf::CatAsciiFile(__FILE__));
   auto concatenated = wks::RTrim(wks::Concatenate(lines, "\n"));
   EXPECT_EQ(content.length(), concatenated.length());
   EXPECT_EQ(content, concatenated);
 }
+
+TEST(FileIOTest, MappedFile) {
+  EXPECT_THROW(wkf::MappedFile("no-such-file"), wkf::IOError);
+
+  const std::string content = wkf::CatAsciiFile(__FILE__);
+  wkf::MappedFile file{__FILE__};
+  EXPECT_FALSE(file.Empty());
+  EXPECT_EQ(content.length(), file.Size());
+  EXPECT_EQ(content, file.View());
+
+  wkf::MappedFile moved{std::move(file)};
+  EXPECT_TRUE(file.Empty());
+  EXPECT_TRUE(file.View().empty());
+  EXPECT_EQ(content, moved.View());
+
+  file = std::move(moved);
+  EXPECT_TRUE(moved.Empty());
+  EXPECT_EQ(content, file.View());
+  // Small files are read into a buffer.
+  EXPECT_FALSE(file.IsMapped());
+
+  // Large files are mapped.
+  const std::string fname =
+      (std::filesystem::temp_directory_path() / "wzk-mapped-file.txt")
+          .string();
+  const std::string large(wkf::MappedFile::kMaxBufferedSize + 1, 'x');
+  {
+    std::ofstream ofs{fname, std::ios::out | std::ios::trunc};
+    ofs << large;
+  }
+  wkf::MappedFile mapped{fname};
+  EXPECT_TRUE(mapped.IsMapped());
+  EXPECT_EQ(large, mapped.View());
+  file = std::move(mapped);
+  EXPECT_TRUE(file.IsMapped());
+  EXPECT_EQ(large.length(), file.Size());
+  std::filesystem::remove(fname);
+}